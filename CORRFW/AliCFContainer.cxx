@@ -28,6 +28,10 @@
 #include "AliCFGridSparse.h"
 #include "AliCFContainer.h"
 #include "TAxis.h"
+#include "TH1D.h"
+#include "TObjArray.h"
+#include <map>
+#include <vector>
 //____________________________________________________________________
 ClassImp(AliCFContainer)
 
@@ -203,6 +207,83 @@ AliCFContainer* AliCFContainer::MakeSlice(Int_t nSteps, const Int_t* steps,
   return out;
 }
 
+//____________________________________________________________________
+TObjArray* AliCFContainer::MakeProjections(Int_t nSteps, const Int_t* steps, Int_t nVars, const Int_t* vars,
+					   const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const
+{
+  //
+  // Makes the 1-dimensional projections on the "nVars" variables defined in "vars[nVars]"
+  // for the "nSteps" steps defined in "steps[nSteps]".
+  // The grid of each step is looped over only once, see AliCFGridSparse::MakeProjections().
+  // Returns an array owning the projections, the one of vars[iVar] at steps[iStep] being at index iStep*nVars+iVar.
+  //
+
+  for (Int_t iStep=0; iStep<nSteps; iStep++) {
+    if (steps[iStep] >= fNStep || steps[iStep] < 0) {
+      AliError("Non-existent selection step, return NULL");
+      return 0x0;
+    }
+  }
+
+  TObjArray* out = new TObjArray(nSteps*nVars);
+  out->SetOwner();
+  std::vector<TH1D*> projections(nVars);
+  for (Int_t iStep=0; iStep<nSteps; iStep++) {
+    fGrid[steps[iStep]]->MakeProjections(nVars,vars,&projections[0],varMin,varMax,useBins);
+    for (Int_t iVar=0; iVar<nVars; iVar++) out->AddAt(projections[iVar],iStep*nVars+iVar);
+  }
+  return out;
+}
+
+//____________________________________________________________________
+TObjArray* AliCFContainer::MakeEfficiencies(Int_t nRatios, const Int_t* stepsNum, const Int_t* stepsDen, Int_t nVars, const Int_t* vars,
+					    const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const
+{
+  //
+  // Makes the 1-dimensional efficiencies stepsNum[iRatio]/stepsDen[iRatio] (binomial errors)
+  // as a function of the "nVars" variables defined in "vars[nVars]".
+  // Each step involved is projected only once, in a single loop over its grid.
+  // Returns an array owning the efficiencies, the one of vars[iVar] for ratio iRatio being at index iRatio*nVars+iVar.
+  //
+
+  // projections of the steps needed
+  std::map<Int_t, std::vector<TH1D*> > projections;
+  for (Int_t iRatio=0; iRatio<nRatios; iRatio++) {
+    for (Int_t iNumDen=0; iNumDen<2; iNumDen++) {
+      Int_t step = iNumDen ? stepsDen[iRatio] : stepsNum[iRatio];
+      if (step >= fNStep || step < 0) {
+	AliError("Non-existent selection step, return NULL");
+	for (std::map<Int_t, std::vector<TH1D*> >::iterator it=projections.begin(); it!=projections.end(); ++it)
+	  for (Int_t iVar=0; iVar<nVars; iVar++) delete it->second[iVar];
+	return 0x0;
+      }
+      if (projections.count(step)) continue;
+      std::vector<TH1D*>& proj = projections[step];
+      proj.resize(nVars);
+      fGrid[step]->MakeProjections(nVars,vars,&proj[0],varMin,varMax,useBins);
+    }
+  }
+
+  TObjArray* out = new TObjArray(nRatios*nVars);
+  out->SetOwner();
+  for (Int_t iRatio=0; iRatio<nRatios; iRatio++) {
+    for (Int_t iVar=0; iVar<nVars; iVar++) {
+      TH1D* hNum = projections[stepsNum[iRatio]][iVar];
+      TH1D* hDen = projections[stepsDen[iRatio]][iVar];
+      if (!hNum || !hDen) continue;
+      TH1D* eff = (TH1D*)hNum->Clone(Form("%s_eff%d-%d_%s",GetName(),stepsNum[iRatio],stepsDen[iRatio],GetVarTitle(vars[iVar])));
+      eff->SetDirectory(0);
+      eff->SetTitle(Form("Efficiency: %s / %s",GetStepTitle(stepsNum[iRatio]),GetStepTitle(stepsDen[iRatio])));
+      eff->Divide(hNum,hDen,1.,1.,"B");
+      out->AddAt(eff,iRatio*nVars+iVar);
+    }
+  }
+
+  for (std::map<Int_t, std::vector<TH1D*> >::iterator it=projections.begin(); it!=projections.end(); ++it)
+    for (Int_t iVar=0; iVar<nVars; iVar++) delete it->second[iVar];
+  return out;
+}
+
 //____________________________________________________________________
 Long64_t AliCFContainer::Merge(TCollection* list)
 {
@@ -17,6 +17,7 @@ class TH1D;
 class TH2D;
 class TH3D;
 class TCollection;
+class TObjArray;
 
 class AliCFContainer : public AliCFFrame
 {
@@ -78,6 +79,10 @@ class AliCFContainer : public AliCFFrame
   virtual AliCFContainer* MakeSlice(Int_t nStep, const Int_t* steps, 
 				    Int_t nVars, const Int_t* vars, const Double_t* varMin=0x0, const Double_t* varMax=0x0, 
 				    Bool_t useBins=0) const ;
+  virtual TObjArray* MakeProjections (Int_t nSteps, const Int_t* steps, Int_t nVars, const Int_t* vars,
+				      const Double_t* varMin=0x0, const Double_t* varMax=0x0, Bool_t useBins=0) const ;
+  virtual TObjArray* MakeEfficiencies(Int_t nRatios, const Int_t* stepsNum, const Int_t* stepsDen, Int_t nVars, const Int_t* vars,
+				      const Double_t* varMin=0x0, const Double_t* varMax=0x0, Bool_t useBins=0) const ;
   virtual void  Smooth(Int_t istep) {GetGrid(istep)->Smooth();}
 
   virtual void  SetRangeUser(Int_t ivar, Double_t varMin, Double_t varMax, Bool_t useBins=kFALSE) const ;
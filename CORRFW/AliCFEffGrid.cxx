@@ -200,6 +200,20 @@ TH1* AliCFEffGrid::Project(Int_t ivar1, Int_t ivar2, Int_t ivar3) const
   return h ;
 } 
 //___________________________________________________________________
+TObjArray* AliCFEffGrid::MakeEfficiencies(Int_t nVars, const Int_t* vars) const
+{
+  //
+  // Makes the 1-dimensional efficiencies as a function of each of the nVars variables vars[nVars],
+  // looping only once over the numerator and denominator grids (see AliCFContainer::MakeEfficiencies)
+  //
+
+  if (fSelNum<0 || fSelDen<0) {
+    AliError("You must call CalculateEfficiency() first !");
+    return 0x0;
+  }
+  return fContainer->MakeEfficiencies(1,&fSelNum,&fSelDen,nVars,vars);
+}
+//___________________________________________________________________
 AliCFEffGrid* AliCFEffGrid::MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const {
   //
   // returns a slice of the efficiency grid (slice is actually done on the container, and efficiency recomputed)
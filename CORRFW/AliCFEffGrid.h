@@ -31,6 +31,7 @@ class AliCFEffGrid : public AliCFGridSparse
   virtual Int_t GetSelDenStep() const {return fSelDen;};
   virtual TH1*  Project(Int_t ivar1, Int_t ivar2=-1,Int_t ivar3=-1) const;
   virtual AliCFGridSparse*  Project(Int_t, const Int_t*, const Double_t*, const Double_t*, Bool_t) const {AliWarning("should not be used"); return 0x0;}
+  virtual TObjArray* MakeEfficiencies(Int_t nVars, const Int_t* vars) const;
   virtual AliCFEffGrid* MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins=0) const;
 
   //Efficiency calculation
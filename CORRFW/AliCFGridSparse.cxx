@@ -34,10 +34,41 @@
 #include "TH3D.h"
 #include "TAxis.h"
 #include "AliCFUnfolding.h"
+#include <vector>
 
 //____________________________________________________________________
 ClassImp(AliCFGridSparse)
 
+namespace {
+  // Saves the ranges of the axes of a THnSparse and restores them when going out of scope,
+  // so that ranges can be set on the grid for the time of a projection instead of cloning it
+  class AxisRangeGuard {
+  public:
+    AxisRangeGuard(THnSparse* h) : fHist(h), fFirst(h->GetNdimensions()), fLast(h->GetNdimensions()), fIsSet(h->GetNdimensions()) {
+      for (Int_t iAxis=0; iAxis<h->GetNdimensions(); iAxis++) {
+	TAxis* axis = h->GetAxis(iAxis);
+	fFirst[iAxis] = axis->GetFirst();
+	fLast [iAxis] = axis->GetLast();
+	fIsSet[iAxis] = axis->TestBit(TAxis::kAxisRange);
+      }
+    }
+    ~AxisRangeGuard() {
+      for (Int_t iAxis=0; iAxis<fHist->GetNdimensions(); iAxis++) {
+	TAxis* axis = fHist->GetAxis(iAxis);
+	axis->SetRange(fFirst[iAxis],fLast[iAxis]);
+	axis->SetBit(TAxis::kAxisRange,fIsSet[iAxis]);
+      }
+    }
+  private:
+    AxisRangeGuard(const AxisRangeGuard&);
+    AxisRangeGuard& operator=(const AxisRangeGuard&);
+    THnSparse*          fHist;
+    std::vector<Int_t>  fFirst;
+    std::vector<Int_t>  fLast;
+    std::vector<Bool_t> fIsSet;
+  };
+}
+
 //____________________________________________________________________
 AliCFGridSparse::AliCFGridSparse() : 
   AliCFFrame(),
@@ -149,18 +180,17 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   // create new grid sparse
   AliCFGridSparse* out = new AliCFGridSparse(fName,fTitle,nVars,bins);
 
-  //set the range in the THnSparse to project
-  THnSparse* clone = ((THnSparse*)fData->Clone());
+  //set the range in the THnSparse to project, for the time of the projection
+  AxisRangeGuard guard(fData);
   if (varMin && varMax) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
-      SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+      SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
     }
   }
   else AliInfo("Keeping same axis ranges");
 
-  out->SetGrid(clone->Projection(nVars,vars));
+  out->SetGrid(fData->Projection(nVars,vars));
   delete [] bins;
-  delete clone;
   return out;
 }
 
@@ -261,10 +291,7 @@ void AliCFGridSparse::SetElement(Long_t index, Float_t val)
   //
   // Sets grid element value
   //
-  Int_t* bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin); //affects the bin coordinates
-  SetElement(bin,val);
-  delete [] bin ;
+  fData->SetBinContent(index,val);
 }
 
 //____________________________________________________________________
@@ -294,10 +321,7 @@ void AliCFGridSparse::SetElementError(Long_t index, Float_t val)
   //
   // Sets grid element iel error to val (linear indexing) in AliCFFrame
   //
-  Int_t *bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin);
-  SetElementError(bin,val);
-  delete [] bin;
+  fData->SetBinError(index,val);
 }
 
 //____________________________________________________________________
@@ -401,11 +425,9 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   if(!fSumW2  && (aGrid1->GetSumW2() || aGrid2->GetSumW2())) SumW2();
 
   fData->Reset();
-  THnSparse *h1 = aGrid1->GetGrid();
-  THnSparse *h2 = aGrid2->GetGrid();
-  h2->Multiply(h1);
-  h2->Scale(c1*c2);
-  fData->Add(h2);
+  fData->Add(aGrid2->GetGrid());
+  fData->Multiply(aGrid1->GetGrid());
+  fData->Scale(c1*c2);
 }
 
 //____________________________________________________________________
@@ -422,9 +444,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   
   if (!fSumW2  && aGrid->GetSumW2()) SumW2();
 
-  THnSparse *h1 = aGrid->GetGrid();
-  THnSparse *h2 = (THnSparse*)fData->Clone();
-  fData->Divide(h2,h1);
+  fData->Divide(aGrid->GetGrid());
   fData->Scale(c);
 }
 
@@ -519,6 +539,7 @@ void AliCFGridSparse::Scale(const Double_t* fact)
 {
   //
   //scale contents of the whole grid by fact
+  //the filled bins are scaled in place
   //
 
   for (Long_t iel=0; iel<GetNFilledBins(); iel++) {
@@ -539,11 +560,13 @@ Int_t AliCFGridSparse::CheckStats(Double_t thr) const
 {
   //
   // Count the cells below a certain threshold
+  // (the empty cells count as 0)
   //
   Int_t ncellsLow=0;
-  for (Int_t i=0; i<GetNBinsTotal(); i++) {
-    if (GetElement(i)<thr) ncellsLow++;
+  for (Long_t iel=0; iel<GetNFilledBins(); iel++) {
+    if (GetElement(iel)<thr) ncellsLow++;
   }
+  if (thr>0) ncellsLow += GetEmptyBins();
   return ncellsLow;
 }
 
@@ -621,9 +644,10 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
 
-  THnSparse* clone = (THnSparse*)fData->Clone();
+  // the ranges are set on the grid for the time of the projection
+  AxisRangeGuard guard(fData);
   if (varMin != 0x0 && varMax != 0x0) {
-    for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+    for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
   }
 
   TH1* projection = 0x0 ;
@@ -637,7 +661,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
 	AliError("Non-existent variable, return NULL");
 	return 0x0;
       }
-      projection = (TH1D*)clone->Projection(iVar1); 
+      projection = (TH1D*)fData->Projection(iVar1); 
       projection->SetTitle(Form("%s_proj-%s",GetTitle(),GetVarTitle(iVar1)));
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
         Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
@@ -651,7 +675,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
 	AliError("Non-existent variable, return NULL");
 	return 0x0;
       }
-      projection = (TH2D*)clone->Projection(iVar2,iVar1); 
+      projection = (TH2D*)fData->Projection(iVar2,iVar1); 
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
         Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
 	TString binLabel = GetAxis(iVar1)->GetBinLabel(origBin) ;
@@ -671,7 +695,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
       AliError("Non-existent variable, return NULL");
       return 0x0;
     }
-    projection = (TH3D*)clone->Projection(iVar1,iVar2,iVar3); 
+    projection = (TH3D*)fData->Projection(iVar1,iVar2,iVar3); 
     for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
       Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
       TString binLabel = GetAxis(iVar1)->GetBinLabel(origBin) ;
@@ -692,10 +716,99 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   projection->SetName (name .Data());
   projection->SetTitle(title.Data());
 
-  delete clone;
   return projection ;
 }
 
+//____________________________________________________________________
+void AliCFGridSparse::MakeProjections(Int_t nVars, const Int_t* vars, TH1D** projections,
+				      const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const
+{
+  //
+  // Makes the 1-dimensional projections on each of the nVars variables vars[nVars]
+  // in a single loop over the filled bins, and stores them in projections[nVars] (owned by the caller).
+  // The ranges are applied as in Slice(), but the projections keep the full binning of their variable.
+  //
+
+  for (Int_t iVar=0; iVar<nVars; iVar++) projections[iVar] = 0x0;
+  for (Int_t iVar=0; iVar<nVars; iVar++) {
+    if (vars[iVar] >= GetNVar() || vars[iVar] < 0) {
+      AliError("Non-existent variable, no projection made");
+      return;
+    }
+  }
+
+  const Int_t nDim = GetNVar();
+  std::vector<Int_t> first(nDim), last(nDim);
+  GetBinRanges(varMin,varMax,useBins,&first[0],&last[0]);
+
+  // content and squared error of each projection, including under/overflows
+  std::vector<std::vector<Double_t> > content(nVars), error2(nVars);
+  for (Int_t iVar=0; iVar<nVars; iVar++) {
+    content[iVar].assign(GetNBins(vars[iVar])+2,0.);
+    error2 [iVar].assign(GetNBins(vars[iVar])+2,0.);
+  }
+
+  std::vector<Int_t> bin(nDim);
+  for (Long64_t iel=0; iel<fData->GetNbins(); iel++) {
+    Double_t value = fData->GetBinContent(iel,&bin[0]);
+    Bool_t inRange = kTRUE;
+    for (Int_t iDim=0; iDim<nDim && inRange; iDim++) inRange = (bin[iDim]>=first[iDim] && bin[iDim]<=last[iDim]);
+    if (!inRange) continue;
+    Double_t err2 = fData->GetBinError2(iel);
+    for (Int_t iVar=0; iVar<nVars; iVar++) {
+      content[iVar][bin[vars[iVar]]] += value;
+      error2 [iVar][bin[vars[iVar]]] += err2;
+    }
+  }
+
+  for (Int_t iVar=0; iVar<nVars; iVar++) {
+    TAxis* axis = GetAxis(vars[iVar]);
+    TString name,title;
+    GetProjectionName (name ,vars[iVar]);
+    GetProjectionTitle(title,vars[iVar]);
+    TH1D* h = 0x0;
+    if (axis->GetXbins()->GetSize()) h = new TH1D(name.Data(),title.Data(),axis->GetNbins(),axis->GetXbins()->GetArray());
+    else                             h = new TH1D(name.Data(),title.Data(),axis->GetNbins(),axis->GetXmin(),axis->GetXmax());
+    h->SetDirectory(0);
+    h->Sumw2();
+    h->GetXaxis()->SetTitle(axis->GetTitle());
+    for (Int_t iBin=0; iBin<=axis->GetNbins()+1; iBin++) {
+      h->SetBinContent(iBin,content[iVar][iBin]);
+      h->SetBinError  (iBin,TMath::Sqrt(error2[iVar][iBin]));
+      if (iBin>0 && iBin<=axis->GetNbins()) {
+	TString binLabel = axis->GetBinLabel(iBin) ;
+	if (binLabel.CompareTo("") != 0) h->GetXaxis()->SetBinLabel(iBin,binLabel);
+      }
+    }
+    h->SetEntries(fData->GetEntries());
+    projections[iVar] = h;
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::GetBinRanges(const Double_t* varMin, const Double_t* varMax, Bool_t useBins, Int_t* first, Int_t* last) const
+{
+  //
+  // Fills first[GetNVar()] and last[GetNVar()] with the bin range of each variable, as used by Slice() :
+  // ranges from varMin,varMax if given, otherwise the current ranges of the axes.
+  // Axes without range include the under/overflows.
+  //
+
+  AxisRangeGuard guard(fData);
+  for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
+    TAxis* axis = fData->GetAxis(iAxis);
+    if (varMin && varMax) SetAxisRange(axis,varMin[iAxis],varMax[iAxis],useBins);
+    if (axis->TestBit(TAxis::kAxisRange)) {
+      first[iAxis] = axis->GetFirst();
+      last [iAxis] = axis->GetLast();
+    }
+    else {
+      first[iAxis] = 0;
+      last [iAxis] = axis->GetNbins()+1;
+    }
+  }
+}
+
 //____________________________________________________________________
 void AliCFGridSparse::SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const {
   //
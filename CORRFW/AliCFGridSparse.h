@@ -75,6 +75,8 @@ class AliCFGridSparse : public AliCFFrame
 				 const Double_t *varMin=0x0, const Double_t *varMax=0x0, Bool_t useBins=0) const ; 
   virtual AliCFGridSparse* MakeSlice(Int_t nVars, const Int_t* vars,
 				   const Double_t* varMin, const Double_t* varMax, Bool_t useBins=0) const ;
+  virtual void             MakeProjections(Int_t nVars, const Int_t* vars, TH1D** projections,
+					   const Double_t* varMin=0x0, const Double_t* varMax=0x0, Bool_t useBins=0) const ;
 
   virtual void             SetRangeUser(Int_t iVar, Double_t varMin, Double_t varMax, Bool_t useBins=kFALSE) const ;
   virtual void             SetRangeUser(const Double_t* varMin, const Double_t* varMax, Bool_t useBins=kFALSE) const ;
@@ -116,6 +118,7 @@ class AliCFGridSparse : public AliCFFrame
   //protected functions
   void     GetScaledValues(const Double_t *fact, const Double_t *in, Double_t *out) const;
   void     SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const;
+  void     GetBinRanges(const Double_t* varMin, const Double_t* varMax, Bool_t useBins, Int_t* first, Int_t* last) const;
   void     GetProjectionName (TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
   void     GetProjectionTitle(TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
 
@@ -65,6 +65,12 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// The conditional matrix is turned once into a flat list of entries   //
+// and the iterations run on plain arrays, the THnSparse being updated //
+// at the end only. The randomized unfoldings of the error calculation //
+// can be run in several threads (::SetNThreads), unless smoothing is  //
+// used.                                                               //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -92,10 +98,119 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <algorithm>
+#include <thread>
 
 
 ClassImp(AliCFUnfolding)
 
+//______________________________________________________________
+// Working copy of the spectra used by the bayes iterations.
+// The N-dimensional spectra are indexed by cell (see AliCFUnfolding::CreateResponseEntries),
+// the inverse response by response entry. For each spectrum filled from the iterations,
+// the cells present in the equivalent THnSparse are kept in their THnSparse bin order.
+// Each randomized unfolding of the error calculation runs on its own copy.
+
+class AliCFUnfoldingState {
+ public :
+  AliCFUnfoldingState() :
+    fPrior(), fPriorFilled(), fPriorCells(), fPriorTimesEff(), fEfficiency(), fMeasured(),
+    fEstMeasured(), fEstMeasuredFilled(), fEstMeasuredCells(), fInverse(), fInverseSet(),
+    fUnfolded(), fUnfoldedFilled(), fUnfoldedCells(),
+    fNIterations(0), fConvergence(0.), fConverged(kFALSE), fSmoothingFailed(kFALSE),
+    fPriorUpdated(kFALSE), fNNonPositivePrior(0) {}
+
+  std::vector<Double_t> fPrior;             // prior spectrum (T)
+  std::vector<Char_t>   fPriorFilled;       // cells present in the prior
+  std::vector<Int_t>    fPriorCells;        // cells present in the prior, in bin order
+  std::vector<Double_t> fPriorTimesEff;     // prior times efficiency
+  std::vector<Double_t> fEfficiency;        // efficiency (E)
+  std::vector<Double_t> fMeasured;          // measured spectrum
+  std::vector<Double_t> fEstMeasured;       // estimate of the measured spectrum (M)
+  std::vector<Char_t>   fEstMeasuredFilled; // cells present in the measured estimate
+  std::vector<Int_t>    fEstMeasuredCells;  // cells present in the measured estimate, in bin order
+  std::vector<Double_t> fInverse;           // inverse response, per response entry
+  std::vector<Char_t>   fInverseSet;        // entries of the inverse response set by the iterations
+  std::vector<Double_t> fUnfolded;          // unfolded spectrum
+  std::vector<Char_t>   fUnfoldedFilled;    // cells present in the unfolded spectrum
+  std::vector<Int_t>    fUnfoldedCells;     // cells present in the unfolded spectrum, in bin order
+  Int_t    fNIterations;       // number of iterations performed
+  Double_t fConvergence;       // convergence criterion of the last iteration
+  Bool_t   fConverged;         // iterations stopped by the convergence criterion
+  Bool_t   fSmoothingFailed;   // iterations stopped by a smoothing failure
+  Bool_t   fPriorUpdated;      // prior replaced by an unfolded spectrum
+  Int_t    fNNonPositivePrior; // number of prior values <= 0 met by GetConvergence
+};
+
+namespace {
+  Int_t GetCell(const Int_t* coord, const std::vector<Int_t>& nCells) {
+    // Cell of the bin with coordinates coord, -1 if outside
+    Int_t cell = 0;
+    for (Int_t iVar=nCells.size()-1; iVar>=0; iVar--) {
+      if (coord[iVar]<0 || coord[iVar]>=nCells[iVar]) return -1;
+      cell = cell*nCells[iVar] + coord[iVar];
+    }
+    return cell;
+  }
+
+  void GetCellCoordinates(Int_t cell, const std::vector<Int_t>& nCells, Int_t* coord) {
+    // Coordinates of the bin of cell
+    for (UInt_t iVar=0; iVar<nCells.size(); iVar++) {
+      coord[iVar] = cell % nCells[iVar];
+      cell /= nCells[iVar];
+    }
+  }
+
+  Double_t Stored(Double_t value, Bool_t singlePrecision) {
+    // value as it would be stored in a THnSparseF (singlePrecision) or THnSparseD
+    return singlePrecision ? (Double_t)(Float_t)value : value;
+  }
+
+  Bool_t ReadSpectrum(const THnSparse* hist, const std::vector<Int_t>& nCells, std::vector<Double_t>& values,
+		      std::vector<Char_t>* filled = 0, std::vector<Int_t>* cells = 0) {
+    // Copies the bin contents of hist to values (and the filled cells, if requested)
+    // Returns kFALSE if hist has bins outside the cells
+    Int_t nTotal = 1;
+    for (UInt_t iVar=0; iVar<nCells.size(); iVar++) nTotal *= nCells[iVar];
+    values.assign(nTotal,0.);
+    if (filled) filled->assign(nTotal,0);
+    if (cells)  cells->clear();
+    std::vector<Int_t> coord(hist->GetNdimensions());
+    Bool_t ok = kTRUE;
+    for (Long_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+      Double_t content = hist->GetBinContent(iBin,&coord[0]);
+      Int_t cell = GetCell(&coord[0],nCells);
+      if (cell<0) { ok = kFALSE; continue; }
+      values[cell] = content;
+      if (filled) (*filled)[cell] = 1;
+      if (cells)  cells->push_back(cell);
+    }
+    return ok;
+  }
+
+  void GetCells(const THnSparse* hist, const std::vector<Int_t>& nCells, std::vector<Int_t>& cells) {
+    // Cells of the bins of hist, in bin order
+    std::vector<Int_t> coord(hist->GetNdimensions());
+    cells.resize(hist->GetNbins());
+    for (Long_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+      hist->GetBinContent(iBin,&coord[0]);
+      cells[iBin] = GetCell(&coord[0],nCells);
+    }
+  }
+
+  void WriteSpectrum(THnSparse* hist, const std::vector<Int_t>& nCells, const std::vector<Double_t>& values,
+		     const std::vector<Int_t>& cells) {
+    // Replaces the content of hist by the values of cells, with errors set to zero
+    hist->Reset();
+    std::vector<Int_t> coord(hist->GetNdimensions());
+    for (UInt_t i=0; i<cells.size(); i++) {
+      GetCellCoordinates(cells[i],nCells,&coord[0]);
+      hist->SetBinContent(&coord[0],values[cells[i]]);
+      hist->SetBinError  (&coord[0],0.);
+    }
+  }
+}
+
 //______________________________________________________________
 
 AliCFUnfolding::AliCFUnfolding() :
@@ -130,7 +245,18 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fNThreads(1),
+  fNCellsT(0),
+  fNCellsM(0),
+  fCellsT(),
+  fCellsM(),
+  fEntryCellM(),
+  fEntryCellT(),
+  fEntryConditional(),
+  fSinglePrecisionT(kFALSE),
+  fSinglePrecisionM(kFALSE),
+  fSinglePrecision2N(kFALSE)
 {
   //
   // default constructor
@@ -174,7 +300,18 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fNThreads(1),
+  fNCellsT(0),
+  fNCellsM(0),
+  fCellsT(),
+  fCellsM(),
+  fEntryCellM(),
+  fEntryCellT(),
+  fEntryConditional(),
+  fSinglePrecisionT(kFALSE),
+  fSinglePrecisionM(kFALSE),
+  fSinglePrecision2N(kFALSE)
 {
   //
   // named constructor
@@ -257,6 +394,7 @@ void AliCFUnfolding::Init() {
 
   // create the matrix of conditional probabilities P(M|T)
   CreateConditional(); //done only once at initialization
+  CreateResponseEntries(); // as well as its representation used in the iterations
   
   // create the frame of the inverse response matrix
   fInverseResponse  = (THnSparse*) fResponse->Clone();
@@ -280,42 +418,144 @@ void AliCFUnfolding::Init() {
 
 //______________________________________________________________
 
-void AliCFUnfolding::CreateEstMeasured() {
+void AliCFUnfolding::CreateResponseEntries() {
+  //
+  // Sets up the representation used by the iterations :
+  //  - the N-dimensional spectra are stored as plain arrays of cells,
+  //    one cell per bin of the true (T) or measured (M) space, under/overflow included
+  //  - the conditional matrix is stored as a flat list of entries (cell in M, cell in T, value),
+  //    in the bin order of the THnSparse so that the sums of the iterations are made in the same order
+  // This is done only once, the iterations do not access the THnSparse anymore.
+  //
+
+  Long64_t nCellsT = 1, nCellsM = 1;
+  fCellsT.resize(fNVariables);
+  fCellsM.resize(fNVariables);
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    fCellsT[iVar] = fPrior   ->GetAxis(iVar)->GetNbins() + 2 ;
+    fCellsM[iVar] = fMeasured->GetAxis(iVar)->GetNbins() + 2 ;
+    nCellsT *= fCellsT[iVar];
+    nCellsM *= fCellsM[iVar];
+  }
+  if (nCellsT > kMaxInt || nCellsM > kMaxInt)
+    AliFatal(Form("Too many bins to unfold : %lld true and %lld measured cells",nCellsT,nCellsM));
+  fNCellsT = nCellsT;
+  fNCellsM = nCellsM;
+
+  // the iterations round the values as the THnSparse holding them would do
+  fSinglePrecisionT  = fPrior     ->InheritsFrom(THnSparseF::Class());
+  fSinglePrecisionM  = fMeasured  ->InheritsFrom(THnSparseF::Class());
+  fSinglePrecision2N = fConditional->InheritsFrom(THnSparseF::Class());
+
+  Long_t nEntries = fConditional->GetNbins();
+  fEntryCellM.resize(nEntries);
+  fEntryCellT.resize(nEntries);
+  fEntryConditional.resize(nEntries);
+  for (Long_t iBin=0; iBin<nEntries; iBin++) {
+    fEntryConditional[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    fEntryCellM[iBin] = GetCell(fCoordinatesN_M,fCellsM);
+    fEntryCellT[iBin] = GetCell(fCoordinatesN_T,fCellsT);
+    if (fEntryCellM[iBin]<0 || fEntryCellT[iBin]<0)
+      AliFatal("The binning of the response matrix does not match the binning of the measured and prior spectra");
+  }
+  AliInfo(Form("response matrix has %ld entries, %d true and %d measured cells",nEntries,fNCellsT,fNCellsM));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::LoadState(AliCFUnfoldingState& state) const {
+  //
+  // Copies the current prior, efficiency, measured spectrum and inverse response into state
+  //
+
+  state.fPriorTimesEff.assign(fNCellsT,0.);
+  state.fEstMeasured.assign(fNCellsM,0.);
+  state.fEstMeasuredFilled.assign(fNCellsM,0);
+  state.fEstMeasuredCells.clear();
+  state.fUnfolded.assign(fNCellsT,0.);
+  state.fUnfoldedFilled.assign(fNCellsT,0);
+  state.fUnfoldedCells.clear();
+
+  Bool_t ok = ReadSpectrum(fPrior,fCellsT,state.fPrior,&state.fPriorFilled,&state.fPriorCells);
+  ok &= ReadSpectrum(fEfficiency,fCellsT,state.fEfficiency);
+  ok &= ReadSpectrum(fMeasured  ,fCellsM,state.fMeasured);
+  if (!ok) AliFatal("The prior, efficiency and measured spectra must have the same binning as the response matrix");
+
+  Long_t nEntries = fEntryConditional.size();
+  state.fInverse.resize(nEntries);
+  state.fInverseSet.assign(nEntries,0);
+  for (Long_t iBin=0; iBin<nEntries; iBin++) state.fInverse[iBin] = fInverseResponse->GetBinContent(iBin);
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::StoreState(const AliCFUnfoldingState& state) {
+  //
+  // Copies the result of the iterations back to the THnSparse returned by the getters
+  //
+
+  if (state.fNIterations == 0 && !state.fSmoothingFailed) return; // nothing was calculated
+
+  WriteSpectrum(fMeasuredEstimate,fCellsM,state.fEstMeasured,state.fEstMeasuredCells);
+  WriteSpectrum(fUnfolded        ,fCellsT,state.fUnfolded   ,state.fUnfoldedCells);
+  if (state.fPriorUpdated) {
+    WriteSpectrum(fPrior,fCellsT,state.fPrior,state.fPriorCells);
+    fPrior->SetTitle("Prior");
+  }
+  for (Long_t iBin=0; iBin<(Long_t)state.fInverse.size(); iBin++) {
+    if (!state.fInverseSet[iBin]) continue;
+    fInverseResponse->SetBinContent(iBin,state.fInverse[iBin]);
+    fInverseResponse->SetBinError  (iBin,0.);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CreateEstMeasured(AliCFUnfoldingState& state) const {
   //
-  // This function creates a estimate (M) of the reconstructed spectrum 
+  // This function creates a estimate (M) of the reconstructed spectrum
   // given the a priori distribution (T), the efficiency (E) and the conditional matrix (COND)
   //
   // --> P(M) = SUM   { P(M|T)    * P(T) }
   // --> M(i) = SUM_k { COND(i,k) * T(k) * E (k)}
   //
   // This is needed to calculate the inverse response matrix
+  // The product T*E is kept in state for CreateInvResponse
   //
 
+  std::vector<Double_t>& priorTimesEff = state.fPriorTimesEff;
+  std::fill(priorTimesEff.begin(),priorTimesEff.end(),0.);
+  for (UInt_t i=0; i<state.fPriorCells.size(); i++) {
+    Int_t cell = state.fPriorCells[i];
+    priorTimesEff[cell] = Stored(state.fPrior[cell] * state.fEfficiency[cell],fSinglePrecisionT);
+  }
 
   // clean the measured estimate spectrum
-  fMeasuredEstimate->Reset();
-
-  THnSparse* priorTimesEff = (THnSparse*) fPrior->Clone();
-  priorTimesEff->Multiply(fEfficiency);
+  for (UInt_t i=0; i<state.fEstMeasuredCells.size(); i++) {
+    Int_t cell = state.fEstMeasuredCells[i];
+    state.fEstMeasured[cell] = 0.;
+    state.fEstMeasuredFilled[cell] = 0;
+  }
+  state.fEstMeasuredCells.clear();
 
   // fill it
-  for (Long_t iBin=0; iBin<fConditional->GetNbins(); iBin++) {
-    Double_t conditionalValue = fConditional->GetBinContent(iBin,fCoordinates2N);
-    GetCoordinates();
-    Double_t priorTimesEffValue = priorTimesEff->GetBinContent(fCoordinatesN_T);
-    Double_t fill = conditionalValue * priorTimesEffValue ;
-    
+  for (UInt_t iEntry=0; iEntry<fEntryConditional.size(); iEntry++) {
+    Double_t fill = fEntryConditional[iEntry] * priorTimesEff[fEntryCellT[iEntry]] ;
     if (fill>0.) {
-      fMeasuredEstimate->AddBinContent(fCoordinatesN_M,fill);
-      fMeasuredEstimate->SetBinError(fCoordinatesN_M,0.);
+      Int_t cell = fEntryCellM[iEntry];
+      if (!state.fEstMeasuredFilled[cell]) {
+	state.fEstMeasuredFilled[cell] = 1;
+	state.fEstMeasuredCells.push_back(cell);
+      }
+      state.fEstMeasured[cell] = Stored(state.fEstMeasured[cell] + fill,fSinglePrecisionM);
     }
   }
-  delete priorTimesEff ;
 }
 
 //______________________________________________________________
 
-void AliCFUnfolding::CreateInvResponse() {
+void AliCFUnfolding::CreateInvResponse(AliCFUnfoldingState& state) const {
   //
   // Creates the inverse response matrix (INV) with Bayesian method
   //  : uses the conditional matrix (COND), the prior probabilities (T) and the efficiency map (E)
@@ -324,69 +564,49 @@ void AliCFUnfolding::CreateInvResponse() {
   // --> INV(i,j) = COND(i,j) * T(j) * E(j)   / SUM_k { COND(i,k) * T(k) }
   //
 
-  THnSparse* priorTimesEff = (THnSparse*) fPrior->Clone();
-  priorTimesEff->Multiply(fEfficiency);
-
-  for (Long_t iBin=0; iBin<fConditional->GetNbins(); iBin++) {
-    Double_t conditionalValue = fConditional->GetBinContent(iBin,fCoordinates2N);
-    GetCoordinates();
-    Double_t estMeasuredValue   = fMeasuredEstimate->GetBinContent(fCoordinatesN_M);
-    Double_t priorTimesEffValue = priorTimesEff    ->GetBinContent(fCoordinatesN_T);
-    Double_t fill = (estMeasuredValue>0. ? conditionalValue * priorTimesEffValue / estMeasuredValue : 0. ) ;
-    if (fill>0. || fInverseResponse->GetBinContent(fCoordinates2N)>0.) {
-      fInverseResponse->SetBinContent(fCoordinates2N,fill);
-      fInverseResponse->SetBinError  (fCoordinates2N,0.);
+  for (UInt_t iEntry=0; iEntry<fEntryConditional.size(); iEntry++) {
+    Double_t estMeasuredValue   = state.fEstMeasured  [fEntryCellM[iEntry]];
+    Double_t priorTimesEffValue = state.fPriorTimesEff[fEntryCellT[iEntry]];
+    Double_t fill = (estMeasuredValue>0. ? fEntryConditional[iEntry] * priorTimesEffValue / estMeasuredValue : 0. ) ;
+    if (fill>0. || state.fInverse[iEntry]>0.) {
+      state.fInverse[iEntry] = Stored(fill,fSinglePrecision2N);
+      state.fInverseSet[iEntry] = 1;
     }
-  } 
-  delete priorTimesEff ;
+  }
 }
 
 //______________________________________________________________
 
 void AliCFUnfolding::Unfold() {
   //
-  // Main routine called by the user : 
+  // Main routine called by the user :
   // it calculates the unfolded spectrum from the response matrix, measured spectrum and efficiency
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
-  Int_t iIterBayes     = 0 ;
-  Double_t convergence = 0.;
+  AliCFUnfoldingState state;
+  LoadState(state);
+  Iterate(state,fNCalcCorrErrors == 0,kTRUE);
+  StoreState(state);
 
-  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+  Int_t    iIterBayes  = state.fNIterations ;
+  Double_t convergence = state.fConvergence ;
 
-    CreateEstMeasured(); // create measured estimate from prior
-    CreateInvResponse(); // create inverse response  from prior
-    CreateUnfolded();    // create unfoled spectrum  from measured and inverse response
+  if (state.fNNonPositivePrior>0)
+    AliWarning(Form("priorValue <= 0 in %d cases. Added 0 to convergence criterion.",state.fNNonPositivePrior));
 
-    convergence = GetConvergence();
-    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+  if (state.fConverged) fNRandomIterations = iIterBayes;
 
-    if (fMaxConvergence>0. && convergence<fMaxConvergence && fNCalcCorrErrors == 0) {
-      fNRandomIterations = iIterBayes;
-      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
-      break;
+  if (state.fSmoothingFailed) {
+    AliError("Couldn't smooth the unfolded spectrum!!");
+    if (fNCalcCorrErrors>0) {
+      AliInfo(Form("=======================\nUnfold of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
     }
-
-    if (fUseSmoothing) {
-      if (Smooth()) {
-	AliError("Couldn't smooth the unfolded spectrum!!");
-	if (fNCalcCorrErrors>0) {
-	  AliInfo(Form("=======================\nUnfold of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
-	}
-	else {
-	  AliInfo(Form("\n\n=======================\nFinish at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
-	}
-	return;
-      }
+    else {
+      AliInfo(Form("\n\n=======================\nFinish at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
     }
-
-    // update the prior distribution
-    if (fPrior) delete fPrior ;
-    fPrior = (THnSparse*)fUnfolded->Clone() ;
-    fPrior->SetTitle("Prior");
-
-  } // end bayes iteration
+    return;
+  }
 
   if (fNCalcCorrErrors==0) fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
 
@@ -410,33 +630,92 @@ void AliCFUnfolding::Unfold() {
 
 //______________________________________________________________
 
-void AliCFUnfolding::CreateUnfolded() {
+void AliCFUnfolding::Iterate(AliCFUnfoldingState& state, Bool_t stopAtConvergence, Bool_t verbose) {
+  //
+  // Performs the bayes iterations on state, starting from its prior
+  // If stopAtConvergence, stops as soon as the convergence criterion is met
+  // verbose must be kFALSE when running outside the main thread
+  //
+
+  state.fConvergence       = 0.;
+  state.fConverged         = kFALSE;
+  state.fSmoothingFailed   = kFALSE;
+  state.fPriorUpdated      = kFALSE;
+  state.fNNonPositivePrior = 0;
+
+  Int_t iIterBayes = 0 ;
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    CreateEstMeasured(state); // create measured estimate from prior
+    CreateInvResponse(state); // create inverse response  from prior
+    CreateUnfolded(state);    // create unfoled spectrum  from measured and inverse response
+
+    state.fConvergence = GetConvergence(state);
+    if (verbose) AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,state.fConvergence));
+
+    if (stopAtConvergence && fMaxConvergence>0. && state.fConvergence<fMaxConvergence) {
+      state.fConverged = kTRUE;
+      if (verbose) AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    if (fUseSmoothing) {
+      // smoothing works on the THnSparse
+      WriteSpectrum(fUnfolded,fCellsT,state.fUnfolded,state.fUnfoldedCells);
+      if (Smooth()) {
+	state.fSmoothingFailed = kTRUE;
+	break;
+      }
+      ReadSpectrum(fUnfolded,fCellsT,state.fUnfolded,&state.fUnfoldedFilled,&state.fUnfoldedCells);
+    }
+
+    // update the prior distribution
+    state.fPrior      .swap(state.fUnfolded);
+    state.fPriorFilled.swap(state.fUnfoldedFilled);
+    state.fPriorCells .swap(state.fUnfoldedCells);
+    state.fPriorUpdated = kTRUE;
+
+  } // end bayes iteration
+
+  state.fNIterations = iIterBayes;
+  if (state.fPriorUpdated && !state.fConverged && !state.fSmoothingFailed) {
+    // the unfolded spectrum of the last iteration is now the prior
+    state.fUnfolded      = state.fPrior;
+    state.fUnfoldedFilled = state.fPriorFilled;
+    state.fUnfoldedCells = state.fPriorCells;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CreateUnfolded(AliCFUnfoldingState& state) const {
   //
   // Creates the unfolded (T) spectrum from the measured spectrum (M) and the inverse response matrix (INV)
-  // We have P(T) = SUM   { P(T|M)   * P(M) } 
+  // We have P(T) = SUM   { P(T|M)   * P(M) }
   //   -->   T(i) = SUM_k { INV(i,k) * M(k) }
   //
 
 
   // clear the unfolded spectrum
-  // if in the process of error calculation, the random unfolded spectrum is created
-  // otherwise the normal unfolded spectrum is created
+  for (UInt_t i=0; i<state.fUnfoldedCells.size(); i++) {
+    Int_t cell = state.fUnfoldedCells[i];
+    state.fUnfolded[cell] = 0.;
+    state.fUnfoldedFilled[cell] = 0;
+  }
+  state.fUnfoldedCells.clear();
 
-  fUnfolded->Reset();
-  
-  for (Long_t iBin=0; iBin<fInverseResponse->GetNbins(); iBin++) {
-    Double_t invResponseValue = fInverseResponse->GetBinContent(iBin,fCoordinates2N);
-    GetCoordinates();
-    Double_t effValue      = fEfficiency->GetBinContent(fCoordinatesN_T);
-    Double_t measuredValue = fMeasured  ->GetBinContent(fCoordinatesN_M);
-    Double_t fill = (effValue>0. ? invResponseValue * measuredValue / effValue : 0.) ;
+  for (UInt_t iEntry=0; iEntry<fEntryConditional.size(); iEntry++) {
+    Int_t cell = fEntryCellT[iEntry];
+    Double_t effValue      = state.fEfficiency[cell];
+    Double_t measuredValue = state.fMeasured[fEntryCellM[iEntry]];
+    Double_t fill = (effValue>0. ? state.fInverse[iEntry] * measuredValue / effValue : 0.) ;
 
     if (fill>0.) {
-      // set errors to zero
-      // true errors will be filled afterwards
-      Double_t err = 0.;
-      fUnfolded->SetBinError  (fCoordinatesN_T,err);
-      fUnfolded->AddBinContent(fCoordinatesN_T,fill);
+      if (!state.fUnfoldedFilled[cell]) {
+	state.fUnfoldedFilled[cell] = 1;
+	state.fUnfoldedCells.push_back(cell);
+      }
+      state.fUnfolded[cell] = Stored(state.fUnfolded[cell] + fill,fSinglePrecisionT);
     }
   }
 }
@@ -445,27 +724,41 @@ void AliCFUnfolding::CreateUnfolded() {
 
 void AliCFUnfolding::CalculateCorrelatedErrors() {
 
-  // Step 1: Create randomized distribution (fRandomXXXX) of each bin of 
-  //         the measured spectrum to calculate correlated errors. 
+  // Step 1: Create randomized distribution (fRandomXXXX) of each bin of
+  //         the measured spectrum to calculate correlated errors.
   //         Poisson statistics: mean = measured value of bin
   // Step 2: Unfold randomized distribution
-  // Step 3: Store difference of unfolded spectrum from measured distribution and 
-  //         unfolded distribution from randomized distribution 
+  // Step 3: Store difference of unfolded spectrum from measured distribution and
+  //         unfolded distribution from randomized distribution
   //         -> fDeltaUnfoldedP (TProfile with option "S")
   // Step 4: Repeat Step 1-3 several times (fNRandomIterations)
   // Step 5: The spread of fDeltaUnfoldedP for each bin is the error on the unfolded spectrum of that specific bin
-
-
-  //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
-    
-    // reset prior to original one
-    if (fPrior) delete fPrior ;
-    fPrior = (THnSparse*) fPriorOrig->Clone();
-
-    // create randomized distribution and stick measured spectrum to it
+  //
+  // All the randomized distributions are created first, in the order of the random sequence,
+  // then they are unfolded in fNThreads threads (only one if smoothing is used).
+  // In the multi-threaded case each thread starts from the inverse response of the
+  // main unfolding rather than from the one of the previous randomized unfolding;
+  // this only makes a difference if the response matrix has negative entries.
+
+  Int_t nToys = TMath::Max(0,fNRandomIterations);
+
+  // cells of the bins of the original efficiency and measured spectra (same bin order as the randomized ones)
+  std::vector<Int_t> effCells, measuredCells;
+  GetCells(fEfficiencyOrig,fCellsT,effCells);
+  GetCells(fMeasuredOrig  ,fCellsM,measuredCells);
+
+  // Step 1 for all the randomized unfoldings
+  std::vector<std::vector<Double_t> > toyEfficiency(nToys), toyMeasured(nToys);
+  for (Int_t i=0; i<nToys; i++) {
     CreateRandomizedDist();
+    toyEfficiency[i].resize(effCells.size());
+    for (UInt_t j=0; j<effCells.size(); j++) toyEfficiency[i][j] = fRandomEfficiency->GetBinContent(j);
+    toyMeasured[i].resize(measuredCells.size());
+    for (UInt_t j=0; j<measuredCells.size(); j++) toyMeasured[i][j] = fRandomMeasured->GetBinContent(j);
+  }
 
+  // the randomized distributions of the last unfolding are left as working copies, as the prior
+  if (nToys>0) {
     if (fResponse) delete fResponse ;
     fResponse = (THnSparse*) fRandomResponse->Clone();
     fResponse->SetTitle("Response");
@@ -478,11 +771,78 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     fMeasured = (THnSparse*) fRandomMeasured->Clone();
     fMeasured->SetTitle("Measured");
 
-    //unfold with randomized distributions
-    Unfold();
-    FillDeltaUnfoldedProfile();
+    if (fPrior) delete fPrior ;
+    fPrior = (THnSparse*) fPriorOrig->Clone();
   }
 
+  // original prior, to which each randomized unfolding is reset
+  std::vector<Double_t> priorOrig;
+  std::vector<Char_t>   priorOrigFilled;
+  std::vector<Int_t>    priorOrigCells;
+  ReadSpectrum(fPriorOrig,fCellsT,priorOrig,&priorOrigFilled,&priorOrigCells);
+
+  // bins of the final unfolded spectrum, for the delta profile
+  std::vector<Int_t> finalCells;
+  GetCells(fUnfoldedFinal,fCellsT,finalCells);
+
+  std::vector<std::vector<Double_t> > toyUnfolded(nToys);
+  std::vector<Int_t>    toyIterations(nToys,0), toyNNonPositivePrior(nToys,0);
+  std::vector<Double_t> toyConvergence(nToys,0.);
+  std::vector<Char_t>   toySmoothingFailed(nToys,0);
+
+  Int_t nThreads = fUseSmoothing ? 1 : TMath::Max(1,TMath::Min(fNThreads,nToys));
+  AliCFUnfoldingState reference;
+  LoadState(reference);
+  std::vector<AliCFUnfoldingState> states(nThreads,reference);
+
+  // Step 2 and 3 for the randomized unfoldings [first,last[
+  auto unfoldToys = [&](Int_t iThread, Int_t first, Int_t last) {
+    AliCFUnfoldingState& state = states[iThread];
+    for (Int_t i=first; i<last; i++) {
+      state.fPrior       = priorOrig;
+      state.fPriorFilled = priorOrigFilled;
+      state.fPriorCells  = priorOrigCells;
+      state.fEfficiency.assign(fNCellsT,0.);
+      for (UInt_t j=0; j<effCells.size(); j++) state.fEfficiency[effCells[j]] = toyEfficiency[i][j];
+      state.fMeasured.assign(fNCellsM,0.);
+      for (UInt_t j=0; j<measuredCells.size(); j++) state.fMeasured[measuredCells[j]] = toyMeasured[i][j];
+
+      Iterate(state,kFALSE,nThreads==1);
+
+      toyUnfolded[i].resize(finalCells.size());
+      for (UInt_t j=0; j<finalCells.size(); j++) toyUnfolded[i][j] = state.fUnfolded[finalCells[j]];
+      toyIterations[i]        = state.fNIterations;
+      toyConvergence[i]       = state.fConvergence;
+      toySmoothingFailed[i]   = state.fSmoothingFailed;
+      toyNNonPositivePrior[i] = state.fNNonPositivePrior;
+    }
+  };
+
+  if (nThreads == 1) unfoldToys(0,0,nToys);
+  else {
+    AliInfo(Form("Unfolding %d randomized distributions in %d threads",nToys,nThreads));
+    std::vector<std::thread> threads;
+    for (Int_t t=0; t<nThreads; t++) threads.push_back(std::thread(unfoldToys,t,nToys*t/nThreads,nToys*(t+1)/nThreads));
+    for (Int_t t=0; t<nThreads; t++) threads[t].join();
+  }
+
+  // Step 3, in the order of the randomized unfoldings
+  for (Int_t i=0; i<nToys; i++) {
+    if (toyNNonPositivePrior[i]>0)
+      AliWarning(Form("priorValue <= 0 in %d cases. Added 0 to convergence criterion.",toyNNonPositivePrior[i]));
+    if (toySmoothingFailed[i]) {
+      AliError("Couldn't smooth the unfolded spectrum!!");
+      AliInfo(Form("=======================\nUnfold of randomized distribution finished at iteration %d with convergence %e \n",toyIterations[i],toyConvergence[i]));
+    }
+    else {
+      AliInfo(Form("=======================\nUnfolding of randomized distribution finished at iteration %d with convergence %e \n",toyIterations[i],toyConvergence[i]));
+    }
+    FillDeltaUnfoldedProfile(toyUnfolded[i]);
+  }
+
+  // the working copies are left in the state of the last randomized unfolding
+  if (nToys>0) StoreState(states.back());
+
   // Get statistical errors for final unfolded spectrum
   // ie. spread of each pt bin in fDeltaUnfoldedP
   Double_t meanx2 = 0.;
@@ -512,8 +872,8 @@ void AliCFUnfolding::CreateRandomizedDist() {
   //
 
   for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
-    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fResponseOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinates2N); //used as mean
+    Double_t err = fResponseOrig->GetBinError(fCoordinates2N);        //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomResponse->SetBinContent(iBin,ran);
@@ -535,24 +895,22 @@ void AliCFUnfolding::CreateRandomizedDist() {
 }
 
 //______________________________________________________________
-void AliCFUnfolding::FillDeltaUnfoldedProfile() {
+void AliCFUnfolding::FillDeltaUnfoldedProfile(const std::vector<Double_t>& unfolded) {
   //
   // Store difference of unfolded spectrum from measured distribution and unfolded spectrum from randomized distribution
+  // unfolded holds the latter, for each bin of fUnfoldedFinal
   // The delta profile has been set to a THnSparse to handle N dimension
-  // The THnSparse contains in each bin the mean value and spread of the difference 
+  // The THnSparse contains in each bin the mean value and spread of the difference
   // This function updates the profile wrt to its previous mean and error
   // The relation between iterations (n+1) and n is as follows :
   //  mean_{n+1} = (n*mean_n + value_{n+1}) / (n+1)
   // sigma_{n+1} = sqrt { 1/(n+1) * [ n*sigma_n^2 + (n^2+n)*(mean_{n+1}-mean_n)^2 ] }    (can this be optimized?)
 
   for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
-    Double_t deltaInBin   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M) - fUnfolded->GetBinContent(fCoordinatesN_M);
+    Double_t deltaInBin   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M) - unfolded[iBin];
     Double_t entriesInBin = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_M);
-    //AliDebug(2,Form("%e %e ==> delta = %e\n",fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M),fUnfolded->GetBinContent(iBin),deltaInBin));
+    //AliDebug(2,Form("%e %e ==> delta = %e\n",fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M),unfolded[iBin],deltaInBin));
 
-    //printf("deltaInBin %f\n",deltaInBin);
-    //printf("pt %f\n",ptaxis->GetBinCenter(iBin+1));
-    
     Double_t mean_n = fDeltaUnfoldedP->GetBinContent(fCoordinatesN_M) ;
     Double_t mean_nplus1 = mean_n ;
     mean_nplus1 *= entriesInBin ;
@@ -655,22 +1013,24 @@ Double_t AliCFUnfolding::GetChi2() {
 
 //______________________________________________________________
 
-Double_t AliCFUnfolding::GetConvergence() {
+Double_t AliCFUnfolding::GetConvergence(AliCFUnfoldingState& state) const {
   //
   // Returns convergence criterion = \sum_t ((U_t^{n-1}-U_t^n)/U_t^{n-1})^2
   // U is unfolded spectrum, t is the bin, n = current, n-1 = previous
+  // The bins with a prior value <= 0 are counted in state
   //
   Double_t convergence = 0.;
   Double_t priorValue  = 0.;
   Double_t currentValue = 0.;
-  for (Long_t iBin=0; iBin < fPrior->GetNbins(); iBin++) {
-    priorValue = fPrior->GetBinContent(iBin,fCoordinatesN_T);
-    currentValue = fUnfolded->GetBinContent(fCoordinatesN_T);
+  for (UInt_t i=0; i<state.fPriorCells.size(); i++) {
+    Int_t cell = state.fPriorCells[i];
+    priorValue = state.fPrior[cell];
+    currentValue = state.fUnfolded[cell];
 
     if (priorValue > 0.)
       convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
-    else 
-      AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue)); 
+    else
+      state.fNNonPositivePrior++;
   }
   return convergence;
 }
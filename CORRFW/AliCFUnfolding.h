@@ -13,9 +13,11 @@
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
+#include <vector>
 
 class TF1;
 class TRandom3;
+class AliCFUnfoldingState;
 
 class AliCFUnfolding : public TNamed {
 
@@ -36,6 +38,7 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetNThreads(Int_t n) {fNThreads = n;} // number of threads unfolding the randomized distributions (not used with smoothing)
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -111,28 +114,45 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Int_t          fNThreads;          // Number of threads for the randomized unfoldings
+
+  /* representation used by the iterations */
+  Int_t                 fNCellsT;            //! Number of cells (bins including under/overflow) in true space
+  Int_t                 fNCellsM;            //! Number of cells in measured space
+  std::vector<Int_t>    fCellsT;             //! Number of cells per true axis
+  std::vector<Int_t>    fCellsM;             //! Number of cells per measured axis
+  std::vector<Int_t>    fEntryCellM;         //! Measured cell of each bin of the conditional matrix
+  std::vector<Int_t>    fEntryCellT;         //! True cell of each bin of the conditional matrix
+  std::vector<Double_t> fEntryConditional;   //! Content of each bin of the conditional matrix
+  Bool_t                fSinglePrecisionT;   //! Spectra in true space are THnSparseF
+  Bool_t                fSinglePrecisionM;   //! Spectra in measured space are THnSparseF
+  Bool_t                fSinglePrecision2N;  //! Response matrix is a THnSparseF
 
 
   // functions
   void     Init();                  // initialisation of the internal settings
   void     GetCoordinates();        // gets a cell coordinates in Measured and True space
   void     CreateConditional();     // creates the conditional matrix from the response matrix
-  void     CreateEstMeasured();     // creates the measured spectrum estimation from the conditional matrix and the prior distribution
-  void     CreateInvResponse();     // creates the inverse response function (Bayes Theorem) from the conditional matrix and the prior distribution
-  void     CreateUnfolded();        // creates the unfolded spectrum from the inverse response matrix and the measured distribution
+  void     CreateResponseEntries(); // creates the representation of the conditional matrix used by the iterations
+  void     LoadState(AliCFUnfoldingState& state) const; // copies the spectra to the working copy of the iterations
+  void     StoreState(const AliCFUnfoldingState& state); // copies the result of the iterations back to the spectra
+  void     Iterate(AliCFUnfoldingState& state, Bool_t stopAtConvergence, Bool_t verbose); // performs the bayes iterations
+  void     CreateEstMeasured(AliCFUnfoldingState& state) const; // creates the measured spectrum estimation from the conditional matrix and the prior distribution
+  void     CreateInvResponse(AliCFUnfoldingState& state) const; // creates the inverse response function (Bayes Theorem) from the conditional matrix and the prior distribution
+  void     CreateUnfolded(AliCFUnfoldingState& state) const;    // creates the unfolded spectrum from the inverse response matrix and the measured distribution
   void     CreateFlatPrior();       // creates a flat a priori distribution in case the one given in the constructor is null
   Double_t GetChi2();               // returns the chi2 between unfolded and prior spectra
   Short_t  Smooth();                // function calling smoothing methods
   Short_t  SmoothUsingFunction();   // smoothes the unfolded spectrum using a fit function
 
   /* correlated error calculation */
-  Double_t GetConvergence();            // Returns convergence criterion
+  Double_t GetConvergence(AliCFUnfoldingState& state) const; // Returns convergence criterion
   void     CalculateCorrelatedErrors(); // Calculates correlated errors for the final unfolded spectrum
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
-  void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
+  void     FillDeltaUnfoldedProfile(const std::vector<Double_t>& unfolded); // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
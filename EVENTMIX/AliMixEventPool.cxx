@@ -23,7 +23,8 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fBinStrides()
 {
    //
    // Default constructor.
@@ -37,7 +38,8 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fBinStrides(obj.fBinStrides)
 {
    //
    // Copy constructor
@@ -59,6 +61,7 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      fBinStrides = obj.fBinStrides;
    }
    return *this;
 }
@@ -111,10 +114,29 @@ Int_t AliMixEventPool::Init()
    fBinNumber++;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
    AddEntryList();
+   InitBinStrides();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventPool::InitBinStrides()
+{
+   //
+   // Caches stride of every cut in flat bin index (first cut runs fastest,
+   // same ordering as in CreateEntryListsRecursivly)
+   //
+   Int_t num = fListOfEventCuts.GetEntriesFast();
+   fBinStrides.Set(num + 1);
+   Int_t stride = 1;
+   for (Int_t i = 0; i < num; i++) {
+      fBinStrides[i] = stride;
+      stride *= ((AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i))->GetNumberOfBins();
+   }
+   // last element holds total number of bins
+   fBinStrides[num] = stride;
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 {
@@ -192,49 +214,34 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    // Find entrlist in list of entrlist
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
-   }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
-   AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
+   Int_t binIndex = FindBinIndex(ev);
+   AliDebug(AliLog::kDebug, Form("idEntryList %d", binIndex));
+   if (binIndex < 0) return 0;
+   // index which start with 1
+   idEntryList = binIndex + 1;
    AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return (TEntryList *) fListOfEntryList.UncheckedAt(binIndex);
 }
 
 //_________________________________________________________________________________________________
-void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index)
+Int_t AliMixEventPool::FindBinIndex(AliVEvent *ev)
 {
    //
-   // Search for index of entrylist
+   // Returns bin index (starting from 0) of event or -1 when event is
+   // out of range of any cut. Uses flat strides, so no allocation is done.
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
-   if (num > 0) {
-      index += (i[num] - 1) * d[num - 1];
-      SearchIndexRecursive(num - 1, i, d, index);
-   } else {
-      index += i[num];
+   Int_t num = fListOfEventCuts.GetEntriesFast();
+   if (num < 1) return -1;
+   if (fBinStrides.GetSize() != num + 1) InitBinStrides();
+   Int_t binIndex = 0, index;
+   for (Int_t i = 0; i < num; i++) {
+      index = ((AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i))->GetIndex(ev);
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, index));
+      if (index < 1 || (index - 1) * fBinStrides[i] >= fBinStrides[i + 1]) return -1;
+      binIndex += (index - 1) * fBinStrides[i];
    }
-   AliDebug(AliLog::kDebug + 5, "->");
+   if (binIndex >= fListOfEntryList.GetEntriesFast()) return -1;
+   return binIndex;
 }
 
 //_________________________________________________________________________________________________
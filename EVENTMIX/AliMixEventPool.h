@@ -12,6 +12,7 @@
 #define ALIMIXEVENTPOOL_H
 
 #include <TObjArray.h>
+#include <TArrayI.h>
 #include <TNamed.h>
 
 class TEntryList;
@@ -31,11 +32,11 @@ public:
    Int_t       Init();
 
    void        CreateEntryListsRecursivly(Int_t index);
-   void        SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index);
    TEntryList *AddEntryList();
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
+   Int_t       FindBinIndex(AliVEvent *ev);
 
    void        AddCut(AliMixEventCutObj *cut);
 
@@ -48,9 +49,12 @@ public:
    void        SetMixNumber(Int_t numMix) { fMixNumber = numMix; }
    Int_t       GetBufferSize() const { return fBufferSize; }
    Int_t       GetMixNumber() const { return fMixNumber; }
+   Int_t       GetNumberOfBins() const { return fListOfEntryList.GetEntriesFast(); }
 
 private:
 
+   void        InitBinStrides();
+
    TObjArray   fListOfEntryList;       // list of entry lists
    TObjArray   fListOfEventCuts;       // list of entry lists
 
@@ -58,6 +62,8 @@ private:
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
 
+   TArrayI     fBinStrides;            //! flat stride of every cut in bin index
+
    ClassDef(AliMixEventPool, 1)
 };
 
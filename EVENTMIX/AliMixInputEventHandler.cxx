@@ -13,6 +13,10 @@
 #include <TSystem.h>
 
 #include "AliLog.h"
+#include "AliAODEvent.h"
+#include "AliAODHeader.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
@@ -43,7 +47,13 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fMemoryDepth(0),
+   fMemorySnapshots(),
+   fMemoryEntries(),
+   fMemoryNext(),
+   fMemoryFilled(),
+   fCurrentMixEvent(0)
 {
    //
    // Default constructor.
@@ -59,6 +69,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   fMemorySnapshots.Delete();
 }
 
 //_____________________________________________________________________________
@@ -97,6 +108,12 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       AliWarning("fDoMixIfNotEnoughEvents=kFALSE -> setting fDoMixExtra=kFALSE");
    }
 
+   if (fMemoryDepth > 0 && fMemoryDepth < fMixNumber) {
+      AliWarning(Form("Events kept in memory per bin (%d) < fMixNumber (%d) -> setting it to %d", fMemoryDepth, fMixNumber, fMixNumber));
+      fMemoryDepth = fMixNumber;
+   }
+   if (fMemoryDepth > 0) AliInfo("Mixing in memory: mixed event is available only via GetMixedEvent(), InputEventHandler(0) is not loaded");
+
    // clears array of input handlers
    fMixTrees.Delete();
    // create AliMixInputHandlerInfo
@@ -201,7 +218,8 @@ Bool_t AliMixInputEventHandler::GetEntry()
    }
    // if mix number is higher then 0 and buffer size is 1
    else if (fMixNumber > 0) {
-      MixEventsMoreTimesWithOneEvent();
+      if (fMemoryDepth > 0) MixInMemory();
+      else MixEventsMoreTimesWithOneEvent();
    } else {
       AliWarning("Not supported Mixing !!!");
    }
@@ -485,6 +503,157 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixInMemory()
+{
+   //
+   // Mix in history with events kept in memory. Every bin holds ring buffer
+   // of last fMemoryDepth event snapshots, so mixed events are not read
+   // again from tree. Mixed event is available via GetMixedEvent()
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   fCurrentMixEntry.Reset();
+   fCurrentMixEvent = 0;
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   // fill entry
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   AliVEvent *ev = inEvHMain->GetEvent();
+   // start of
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   // reset mix number
+   fNumberMixed = 0;
+   Int_t binIndex = fEventPool->FindBinIndex(ev);
+   if (binIndex < 0) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (out of bins) +++++++++++++++++++", fEntryCounter));
+      UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+      return kTRUE;
+   }
+   Int_t idEntryList = binIndex + 1;
+   // keeps entry lists filled (as AddEntry would do)
+   if (currentMainEntry >= 0) ((TEntryList *) fEventPool->GetListOfEntryLists()->UncheckedAt(binIndex))->Enter(currentMainEntry);
+
+   Int_t numBins = fEventPool->GetNumberOfBins();
+   if (fMemoryNext.GetSize() != numBins) {
+      AliDebug(AliLog::kDebug, Form("Creating ring buffers for %d bins with %d events", numBins, fMemoryDepth));
+      fMemorySnapshots.Delete();
+      fMemorySnapshots.Expand(numBins * fMemoryDepth);
+      fMemorySnapshots.SetOwner(kTRUE);
+      fMemoryEntries.Set(numBins * fMemoryDepth);
+      fMemoryNext.Set(numBins);
+      fMemoryNext.Reset();
+      fMemoryFilled.Set(numBins);
+      fMemoryFilled.Reset();
+   }
+
+   Int_t numStored = fMemoryFilled[binIndex];
+   if (!numStored || (!fDoMixIfNotEnoughEvents && numStored < fMixNumber)) {
+      // dont include it in main event counter (idEntryList = -1) when there is nothing to mix
+      if (!numStored && !fDoMixIfNotEnoughEvents) idEntryList = -1;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+      AddEventToMemory(binIndex, currentMainEntry, ev);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS TO MIX => NEED=%d +++++++++++++++++++", fEntryCounter, numStored, fMixNumber));
+      return kTRUE;
+   }
+
+   // pre mix evetns
+   Int_t mixNum = fMixNumber;
+   if (fDoMixExtra && numStored <= 2 * fMixNumber) mixNum = numStored;
+   if (mixNum > numStored) mixNum = numStored;
+   Int_t offset = binIndex * fMemoryDepth;
+   Int_t slot = 0;
+   Long64_t entryMix = 0;
+   for (Int_t counter = 0; counter < mixNum; counter++) {
+      // newest events first
+      slot = offset + (fMemoryNext[binIndex] - 1 - counter + fMemoryDepth) % fMemoryDepth;
+      fCurrentMixEvent = (AliVEvent *) fMemorySnapshots.UncheckedAt(slot);
+      entryMix = fMemoryEntries[slot];
+      AliDebug(AliLog::kDebug + 3, Form("entryMix=%lld (slot %d)", entryMix, slot));
+      fCurrentMixEntry.Reset();
+      fCurrentMixEntry.Enter(entryMix);
+      // runs UserExecMix for all tasks
+      fNumberMixed++;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMix, fNumberMixed);
+   }
+   fCurrentMixEvent = 0;
+
+   AddEventToMemory(binIndex, currentMainEntry, ev);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddEventToMemory(Int_t binIndex, Long64_t entry, AliVEvent *ev)
+{
+   //
+   // Stores snapshot of event in ring buffer of bin (oldest one is dropped)
+   //
+   if (entry < 0 || !ev) return;
+   AliVEvent *snapshot = MakeEventSnapshot(ev);
+   if (!snapshot) return;
+   Int_t slot = binIndex * fMemoryDepth + fMemoryNext[binIndex];
+   delete fMemorySnapshots.RemoveAt(slot);
+   fMemorySnapshots.AddAt(snapshot, slot);
+   fMemoryEntries[slot] = entry;
+   fMemoryNext[binIndex] = (fMemoryNext[binIndex] + 1) % fMemoryDepth;
+   if (fMemoryFilled[binIndex] < fMemoryDepth) fMemoryFilled[binIndex]++;
+}
+
+//_____________________________________________________________________________
+AliVEvent *AliMixInputEventHandler::MakeEventSnapshot(AliVEvent *ev) const
+{
+   //
+   // Returns reduced copy of event kept in memory for mixing. For AOD input
+   // only header (run, multiplicity, centrality), primary vertex and tracks
+   // are kept. Other event types have to override this function.
+   //
+   AliAODEvent *aod = dynamic_cast<AliAODEvent *>(ev);
+   if (!aod) {
+      AliFatal(Form("Mixing in memory needs reduced snapshot of %s, override MakeEventSnapshot()", ev->ClassName()));
+      return 0;
+   }
+   AliAODEvent *snapshot = new AliAODEvent();
+   snapshot->CreateStdContent();
+
+   AliAODHeader *header = dynamic_cast<AliAODHeader *>(aod->GetHeader());
+   AliAODHeader *snapshotHeader = dynamic_cast<AliAODHeader *>(snapshot->GetHeader());
+   if (header && snapshotHeader) *snapshotHeader = *header;
+
+   AliAODVertex *vtx = aod->GetPrimaryVertex();
+   if (vtx) {
+      AliAODVertex *tmp = vtx->CloneWithoutRefs();
+      // keeps number of contributors, which is otherwise computed from track refs
+      tmp->SetNContributors(vtx->GetNContributors());
+      snapshot->AddVertex(tmp);
+      delete tmp;
+   }
+
+   AliAODTrack *track;
+   for (Int_t i = 0; i < aod->GetNumberOfTracks(); i++) {
+      track = dynamic_cast<AliAODTrack *>(aod->GetTrack(i));
+      if (!track) continue;
+      snapshot->AddTrack(track);
+      ((AliAODTrack *) snapshot->GetTrack(snapshot->GetNumberOfTracks() - 1))->SetAODEvent(snapshot);
+   }
+   return snapshot;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
 {
@@ -605,6 +774,12 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
+   // input handlers are not loaded when mixing in memory
+   if (fMemoryDepth > 0) {
+      AliError("GetEntryMixedEvent() is not available when mixing in memory, use GetMixedEvent()");
+      return kFALSE;
+   }
+
    AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
 
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
@@ -625,3 +800,15 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+AliVEvent *AliMixInputEventHandler::GetMixedEvent(Int_t id) {
+   //
+   // Returns mixed event with id (Should be used in UserExecMix() only)
+   // In case of mixing in memory snapshot from ring buffer is returned
+   //
+
+   if (fMemoryDepth > 0) return (id == 0) ? fCurrentMixEvent : 0;
+   AliInputEventHandler *ih = (AliInputEventHandler *)InputEventHandler(id);
+   return ih ? ih->GetEvent() : 0;
+}
@@ -13,6 +13,7 @@
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
+#include <TArrayL64.h>
 
 #include <AliVEvent.h>
 
@@ -52,6 +53,11 @@ public:
    void                    DoMixExtra(Bool_t b = kTRUE) { fDoMixExtra = b; }
    void                    DoMixIfNotEnoughEvents(Bool_t b = kTRUE) { fDoMixIfNotEnoughEvents = b; }
    void                    SetMixNumber(const Int_t mixNum);
+   // keeps last 'depth' events of every bin in memory (reduced snapshots, see MakeEventSnapshot())
+   // and mixes with them instead of reading from tree. Mixed event is then valid only via
+   // GetMixedEvent(), GetEntryMixedEvent() fails and InputEventHandler(0)->GetEvent() is not updated
+   void                    SetMixInMemory(Int_t depth) { fMemoryDepth = depth; }
+   Int_t                   MemoryDepth() const { return fMemoryDepth; }
 
    void                    SetCurrentBinIndex(Int_t const index) { fCurrentBinIndex = index; }
    void                    SetCurrentEntry(Long64_t const entry) { fCurrentEntry = entry ; }
@@ -73,8 +79,11 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+   AliVEvent              *GetMixedEvent(Int_t idHandler=0);
 protected:
 
+   virtual AliVEvent      *MakeEventSnapshot(AliVEvent *ev) const;
+
    TObjArray               fMixTrees;              // buffer of input handlers
    TArrayI                 fTreeMap;               // tree map
    AliMixInputHandlerInfo *fMixIntupHandlerInfoTmp;//! mix input handler info full chain
@@ -100,17 +109,28 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   // in memory mixing
+   Int_t      fMemoryDepth;        // number of events kept in memory per bin (0 = mixed events are read from tree)
+   TObjArray  fMemorySnapshots;    //! ring buffers of event snapshots (fMemoryDepth slots per bin)
+   TArrayL64  fMemoryEntries;      //! chain entries of event snapshots
+   TArrayI    fMemoryNext;         //! next slot to be written in every bin
+   TArrayI    fMemoryFilled;       //! number of filled slots in every bin
+   AliVEvent *fCurrentMixEvent;    //! current mixed event from memory
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixInMemory();
+
+   void                    AddEventToMemory(Int_t binIndex, Long64_t entry, AliVEvent *ev);
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include <TMath.h>
 #include "AliVMultiplicity.h"
 #include "AliPPVsMultUtils.h"
+#include "AliEventQuantityCache.h"
 
 #include "AliAnalysisUtils.h"
 
@@ -201,8 +202,11 @@ Bool_t AliAnalysisUtils::IsPileUpSPD(AliVEvent *event)
     return kFALSE;
   }
   //
-  if (aod) return (fUseSPDCutInMultBins)?aod->IsPileupFromSPDInMultBins():aod->IsPileupFromSPD(fMinPlpContribSPD,fMinPlpZdistSPD,fnSigmaPlpZdistSPD,fnSigmaPlpDiamXYSPD,fnSigmaPlpDiamZSPD);
-  else return (fUseSPDCutInMultBins)?esd->IsPileupFromSPDInMultBins():esd->IsPileupFromSPD(fMinPlpContribSPD,fMinPlpZdistSPD,fnSigmaPlpZdistSPD,fnSigmaPlpDiamXYSPD,fnSigmaPlpDiamZSPD);
+  // evaluated once per event for all the tasks using the same settings
+  AliEventQuantityCache *cache = AliEventQuantityCache::Get(event);
+  const Int_t handle = (fUseSPDCutInMultBins) ? Int_t(AliEventQuantityCache::kIsPileupSPDInMultBins) :
+    cache->AddPileupFromSPD(fMinPlpContribSPD,fMinPlpZdistSPD,fnSigmaPlpZdistSPD,fnSigmaPlpDiamXYSPD,fnSigmaPlpDiamZSPD);
+  return cache->GetValue(handle) > 0.5;
 }
 
 //______________________________________________________________________
@@ -52,6 +52,7 @@
 #include "AliCentrality.h"
 #include "AliOADBCentrality.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliMultiplicity.h"
 #include "AliAODHandler.h"
 #include "AliAODHeader.h"
@@ -2008,11 +2009,12 @@ Int_t AliCentralitySelectionTask::SetupRun(const AliVEvent* const esd)
   TString fileName =(Form("%s/COMMON/CENTRALITY/data/centrality.root", AliAnalysisManager::GetOADBPath()));
   AliInfo(Form("Setup Centrality Selection for run %d with file %s\n",fCurrentRun,fileName.Data()));
 
-  AliOADBContainer *con = new AliOADBContainer("OADB");
-  con->InitFromFile(fileName,"Centrality");
+  // The container is read once per job and shared (read-only) with the other tasks
+  AliOADBContainer *con = AliOADBCache::Instance()->GetContainer(fileName,"Centrality");
+  if (!con) AliFatal(Form("Cannot fetch OADB container Centrality from %s", fileName.Data()));
 
   AliOADBCentrality*  centOADB = 0;
-  centOADB = (AliOADBCentrality*)(con->GetObject(fCurrentRun));
+  centOADB = (AliOADBCentrality*)(AliOADBCache::Instance()->GetObject(fileName,"Centrality",fCurrentRun));
   if (!centOADB) {
     AliWarning(Form("Centrality OADB does not exist for run %d, using Default \n",fCurrentRun ));
     centOADB  = (AliOADBCentrality*)(con->GetDefaultObject("oadbDefault"));
@@ -55,6 +55,7 @@
 #include "AliBackgroundSelection.h"
 #include "AliESDUtils.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliAODMCHeader.h"
 #include "AliAODTrack.h"
 #include "AliVTrack.h"
@@ -180,33 +181,29 @@ AliEPSelectionTask::~AliEPSelectionTask()
       delete fESDtrackCuts;
       fESDtrackCuts = 0;
   }
-  if (fUserphidist) {
-    if (fPhiDist[0]) {
-      delete fPhiDist[0];
-      fPhiDist[0] = 0;
+  // fPhiDist are task-owned copies (user file, OADB clone or projection)
+  for(Int_t i = 0; i < 4; i++) {
+    if(fPhiDist[i]){
+      delete fPhiDist[i];
+      fPhiDist[i] = 0;
     }
   }
-  if (fEPContainer){
-      delete fEPContainer;
-      fEPContainer = 0;
-  }
+  // fEPContainer is owned by the OADB cache
+  fEPContainer = 0;
   if (fPeriod.CompareTo("LHC11h")==0){
-      for(Int_t i = 0; i < 4; i++) {
-        if(fPhiDist[i]){
-          delete fPhiDist[i];
-          fPhiDist[i] = 0;
-        }
-      }
       if(fHruns) delete fHruns;
   }
-  if(fQDist[0] && fQDist[1]) {
-    for(Int_t i = 0; i < 2; i++) {
-      if(fQDist[i]){
-	delete fQDist[i];
-	fQDist[i] = 0;
-      }
+  // fQDist are task-owned clones of the recentering objects of the OADB cache
+  for(Int_t i = 0; i < 2; i++) {
+    if(fQDist[i]){
+      delete fQDist[i];
+      fQDist[i] = 0;
     }
   }
+  if (fSparseDist) {
+    delete fSparseDist;
+    fSparseDist = 0;
+  }
 }
 
 //________________________________________________________________________
@@ -745,7 +742,14 @@ void AliEPSelectionTask::SetPhiDist()
 
     if (fPeriod.CompareTo("LHC10h")==0)
        {
-        fPhiDist[0] = (TH1F*) fEPContainer->GetObject(fRunNumber, "Default");}
+        // Own copy, the shared OADB object must not be rebinned
+        if (fPhiDist[0]) delete fPhiDist[0];
+        fPhiDist[0] = (TH1F*) fEPContainer->GetObject(fRunNumber, "Default");
+        if (fPhiDist[0]) {
+          fPhiDist[0] = (TH1F*) fPhiDist[0]->Clone();
+          fPhiDist[0]->SetDirectory(0);
+        }
+       }
         else if(fPeriod.CompareTo("LHC11h")==0){
             Int_t runbin=fHruns->FindBin(fRunNumber);
             if (fHruns->GetBinContent(runbin) > 1){
@@ -821,13 +825,25 @@ void AliEPSelectionTask::SetQvectorDist()
 {
   if(!fUseRecentering) return;
   AliInfo(Form("Setting q vector distributions"));
-  fQDist[0] = (TProfile*) fQxContainer->GetObject(fRunNumber, "Default");
-  fQDist[1] = (TProfile*) fQyContainer->GetObject(fRunNumber, "Default");
+  // Own copies, the shared OADB objects must not be rebinned
+  for(Int_t i = 0; i < 2; i++) {
+    if(fQDist[i]){
+      delete fQDist[i];
+      fQDist[i] = 0;
+    }
+  }
+  TProfile* qDist[2];
+  qDist[0] = (TProfile*) fQxContainer->GetObject(fRunNumber, "Default");
+  qDist[1] = (TProfile*) fQyContainer->GetObject(fRunNumber, "Default");
 
-  if (!fQDist[0] || !fQDist[1]) {
+  if (!qDist[0] || !qDist[1]) {
     AliError(Form("Cannot find OADB q-vector distributions for run %d. Using default values (mean=0,rms=1).", fRunNumber));
     return;
   }
+  for(Int_t i = 0; i < 2; i++) {
+    fQDist[i] = (TProfile*) qDist[i]->Clone();
+    fQDist[i]->SetDirectory(0);
+  }
 
   Bool_t emptybins;
 
@@ -918,13 +934,10 @@ void AliEPSelectionTask::SetOADBandPeriod()
            oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist.root", AliAnalysisManager::GetOADBPath()));
            }
 
-       TFile foadb(oadbfilename);
-       if(!foadb.IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
-
+       // Shared with the other tasks through the OADB cache, not owned
        AliInfo("Using Standard OADB");
-       fEPContainer = (AliOADBContainer*) foadb.Get("epphidist");
+       fEPContainer = AliOADBCache::Instance()->GetContainer(oadbfilename, "epphidist");
        if (!fEPContainer) AliFatal("Cannot fetch OADB container for EP selection");
-       foadb.Close();
        }
      }
 
@@ -934,13 +947,11 @@ void AliEPSelectionTask::SetOADBandPeriod()
       // if it's already set and custom class is required, we use the one provided by the user
 
       oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist2011.root", AliAnalysisManager::GetOADBPath()));
-      TFile *foadb = TFile::Open(oadbfilename);
-      if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
-
       AliInfo("Using Standard OADB");
-      fSparseDist = (THnSparse*) foadb->Get("Default");
-      if (!fSparseDist) AliFatal("Cannot fetch OADB container for EP selection");
-      foadb->Close();
+      // Own copy, the axis ranges are changed in SetPhiDist
+      TObject* sparseDist = AliOADBCache::Instance()->GetFileObject(oadbfilename, "Default");
+      if (!sparseDist) AliFatal("Cannot fetch OADB container for EP selection");
+      if (!fSparseDist) fSparseDist = (THnSparse*) sparseDist->Clone();
       if(!fHruns){
            fHruns = (TH1F*)fSparseDist->Projection(0); //projection on run axis;
            fHruns->SetName("runsHisto");
@@ -949,14 +960,10 @@ void AliEPSelectionTask::SetOADBandPeriod()
 
       if(fUseRecentering) {
 	oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/eprecentering.root", AliAnalysisManager::GetOADBPath()));
-	TFile *foadb = TFile::Open(oadbfilename);
-	if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
-
 	AliInfo("Using Standard OADB");
-	fQxContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qx");
-	fQyContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qy");
+	fQxContainer = AliOADBCache::Instance()->GetContainer(oadbfilename, "eprecentering.Qx");
+	fQyContainer = AliOADBCache::Instance()->GetContainer(oadbfilename, "eprecentering.Qy");
 	if (!fQxContainer || !fQyContainer) AliFatal("Cannot fetch OADB container for EP recentering");
-	foadb->Close();
       }
 
      }
@@ -17,6 +17,7 @@ using std::vector;
 #include <AliAODMCParticle.h>
 #include <AliCentrality.h>
 #include <AliESDtrackCuts.h>
+#include <AliEventQuantityCache.h>
 #include <AliInputEventHandler.h>
 #include <AliMCEventHandler.h>
 #include <AliMultSelection.h>
@@ -102,9 +103,7 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fTPCvsAll{nullptr},
   fMultvsV0M{nullptr},
   fTPCvsTrkl{nullptr},
-  fVZEROvsTPCout{nullptr},
-  fFB32trackCuts{nullptr},
-  fTPConlyCuts{nullptr}
+  fVZEROvsTPCout{nullptr}
 {
   SetName("AliEventCuts");
   SetOwner(true);
@@ -112,8 +111,6 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
 
 AliEventCuts::~AliEventCuts() { 
   delete fMultiplicityV0McorrCut; 
-  delete fFB32trackCuts;
-  delete fFB32trackCuts;
 }
 
 bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
@@ -188,7 +185,9 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     else if (ntrkl < 50) fSPDpileupMinContributors = 4;
     else fSPDpileupMinContributors = 5;
   }
-  if (!ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ) &&
+  AliEventQuantityCache* cache = AliEventQuantityCache::Get(ev);
+  const int pileupSPD = cache->AddPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ);
+  if (cache->GetValue(pileupSPD) < 0.5 &&
       (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
       (!fPileUpCutMV || !fUtils.IsPileUpMV(ev)))
     fFlag |= BIT(kPileUp);
@@ -449,89 +448,20 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 
 
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
-  AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
-  if (tmp_cont) {
-    unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
-    fNewEvent = (tmp_cont->fEventId != evid);
-    tmp_cont->fEventId = evid;
-
-    if (!fNewEvent) {
-      fContainer = *tmp_cont;
-      return;
-    }
-  } else {
-    tmp_cont = new AliEventCutsContainer;
-    ev->AddObject(tmp_cont);
-  }
-
-  bool isAOD = false;
-  if (dynamic_cast<AliAODEvent*>(ev))
-    isAOD = true;
-  else if (!dynamic_cast<AliESDEvent*>(ev))
-    AliFatal("I don't find the AOD event nor the ESD one, aborting.");
-
-  if (!fFB32trackCuts) fFB32trackCuts = AliESDtrackCuts::GetStandardITSTPCTrackCuts2011();
-  if (!fTPConlyCuts) fTPConlyCuts = AliESDtrackCuts::GetStandardTPCOnlyTrackCuts();
-
-  const int nTracks = ev->GetNumberOfTracks();
-  tmp_cont->fMultESD = (isAOD) ? ((AliAODHeader*)ev->GetHeader())->GetNumberOfESDTracks() : dynamic_cast<AliESDEvent*>(ev)->GetNumberOfTracks();
-  tmp_cont->fMultTrkFB32 = 0;
-  tmp_cont->fMultTrkFB32Acc = 0;
-  tmp_cont->fMultTrkFB32TOF = 0;
-  tmp_cont->fMultTrkTPC = 0;
-  tmp_cont->fMultTrkTPCout = 0;
-  for (int it = 0; it < nTracks; it++) {
-    if (isAOD) {
-      AliAODTrack* trk = (AliAODTrack*)ev->GetTrack(it);
-      if (!trk) continue;
-      if ((trk->GetStatus() & AliESDtrack::kTPCout) &&
-          trk->GetID() > 0) tmp_cont->fMultTrkTPCout++;
-      if (trk->TestFilterBit(32)) {
-        tmp_cont->fMultTrkFB32++;
-        if ( TMath::Abs(trk->GetTOFsignalDz()) <= 10. && trk->GetTOFsignal() >= 12000. && trk->GetTOFsignal() <= 25000.)
-          tmp_cont->fMultTrkFB32TOF++;
-        if ((fabs(trk->Eta()) < 0.8) && (trk->GetTPCNcls() >= 70) && (trk->Pt() >= 0.2) && (trk->Pt() < 50))
-          tmp_cont->fMultTrkFB32Acc++;
-      }
-      if (trk->TestFilterBit(128))
-        tmp_cont->fMultTrkTPC++;
-    } else {
-      AliESDtrack* esdTrack = (AliESDtrack*)ev->GetTrack(it);
-      if (!esdTrack) continue;
-
-      if (esdTrack->GetStatus() & AliESDtrack::kTPCout) tmp_cont->fMultTrkTPCout++;
-
-      if (fFB32trackCuts->AcceptTrack(esdTrack)) {
-        tmp_cont->fMultTrkFB32++;
-        if (TMath::Abs(esdTrack->GetTOFsignalDz()) <= 10 && esdTrack->GetTOFsignal() >= 12000 && esdTrack->GetTOFsignal() <= 25000)
-          tmp_cont->fMultTrkFB32TOF++;
-
-        if ((TMath::Abs(esdTrack->Eta()) < 0.8) && (esdTrack->GetTPCNcls() > 70) && (esdTrack->Pt() > 0.2) && (esdTrack->Pt() < 50))
-          tmp_cont->fMultTrkFB32Acc++;
-      }
-
-      /// TPC only tracks, with the same cuts of the filter bit 128
-      AliESDtrack tpcParam;
-      if (!esdTrack->FillTPCOnlyTrack(tpcParam)) continue;
-      if (!fTPConlyCuts->AcceptTrack(&tpcParam)) continue;
-      if (tpcParam.Pt() > 0.) {
-        // only constrain tracks above threshold
-        AliExternalTrackParam exParam;
-        // take the B-field from the ESD, no 3D fieldMap available at this point
-        bool relate = false;
-        relate = tpcParam.RelateToVertexTPC((AliESDVertex*)ev->GetPrimaryVertexSPD(),ev->GetMagneticField(),kVeryBig, &exParam);
-        if(!relate) continue;
-      }
-      tmp_cont->fMultTrkTPC++;
-    }
-  }
-  AliVVZERO *vzero = (AliVVZERO*)ev->GetVZEROData();
-  if(vzero) {
-    tmp_cont->fMultVZERO = 0.;
-    for(int ich=0; ich < 64; ich++)
-      tmp_cont->fMultVZERO += vzero->GetMultiplicity(ich);
-  }
-  fContainer = *tmp_cont;
+  /// The multiplicities are shared with all the other users of the event quantity cache
+  unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  fNewEvent = (fContainer.fEventId != evid);
+  fContainer.fEventId = evid;
+
+  AliEventQuantityCache* cache = AliEventQuantityCache::Get(ev);
+  fContainer.fMultESD = cache->GetValue(AliEventQuantityCache::kMultESD);
+  fContainer.fMultTrkFB32 = cache->GetValue(AliEventQuantityCache::kMultTrkFB32);
+  fContainer.fMultTrkFB32Acc = cache->GetValue(AliEventQuantityCache::kMultTrkFB32Acc);
+  fContainer.fMultTrkFB32TOF = cache->GetValue(AliEventQuantityCache::kMultTrkFB32TOF);
+  fContainer.fMultTrkTPC = cache->GetValue(AliEventQuantityCache::kMultTrkTPC);
+  fContainer.fMultTrkTPCout = cache->GetValue(AliEventQuantityCache::kMultTrkTPCout);
+  const double multVZERO = cache->GetValue(AliEventQuantityCache::kMultVZERO);
+  if (multVZERO >= 0.) fContainer.fMultVZERO = multVZERO;
 }
 
 void AliEventCuts::SetupRun2pp() {
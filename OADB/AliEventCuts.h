@@ -149,7 +149,7 @@ class AliEventCuts : public TList {
     bool          fRequireExactTriggerMask;       ///< If true the event selection mask is required to be equal to fTriggerMask
     unsigned long fTriggerMask;                   ///< Trigger mask
 
-    AliEventCutsContainer fContainer;       //!<! Local copy of the event cuts container (safe against user changes)
+    AliEventCutsContainer fContainer;       //!<! Local copy of the multiplicities from AliEventQuantityCache (safe against user changes)
     const string  fkLabels[2];                    ///< Histograms labels (raw/selected)
 
   private:
@@ -192,9 +192,6 @@ class AliEventCuts : public TList {
     TH2F* fTPCvsTrkl[2];           //!<!
     TH2F* fVZEROvsTPCout[2];       //!<!
 
-    AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
-    AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
-
     ClassDef(AliEventCuts,6)
 };
 
@@ -0,0 +1,339 @@
+#include "AliEventQuantityCache.h"
+
+#include <TMath.h>
+
+#include <algorithm>
+
+#include <AliAnalysisManager.h>
+#include <AliAODEvent.h>
+#include <AliAODHeader.h>
+#include <AliAODTrack.h>
+#include <AliESDEvent.h>
+#include <AliESDtrack.h>
+#include <AliESDtrackCuts.h>
+#include <AliVEvent.h>
+#include <AliVVZERO.h>
+
+ClassImp(AliEventQuantityCache);
+
+namespace {
+  /// Counting engine for the ESD track multiplicities. The fields used by the cheap
+  /// requirements of the two cut sets (status bits, kinks, TPC clusters and crossed rows,
+  /// TPC inner parameters) are extracted once per event into flat arrays and evaluated
+  /// there for all the tracks. The full AliESDtrackCuts::AcceptTrack, and for the TPC only
+  /// tracks FillTPCOnlyTrack and the constrained propagation to the SPD vertex, only run
+  /// for the tracks passing these prefilters. The prefilters are necessary conditions read
+  /// from the cut objects, so the counts are the same as with AcceptTrack alone.
+  class ESDTrackMultCounter {
+    public:
+      ESDTrackMultCounter() : fFB32trackCuts{nullptr}, fTPConlyCuts{nullptr}, fStatus{}, fKink{},
+        fNclsTPC{}, fCrossedRows{}, fHasTPCinner{}, fPassFB32{}, fPassTPC{} {}
+      ~ESDTrackMultCounter() { delete fFB32trackCuts; delete fTPConlyCuts; }
+      void Count(AliESDEvent *ev, int &multTrkFB32, int &multTrkFB32Acc, int &multTrkFB32TOF,
+          int &multTrkTPC, int &multTrkTPCout);
+    private:
+      ESDTrackMultCounter(const ESDTrackMultCounter&);
+      ESDTrackMultCounter& operator=(const ESDTrackMultCounter&);
+      AliESDtrackCuts* fFB32trackCuts; ///< Cuts corresponding to FB32 in the ESD
+      AliESDtrackCuts* fTPConlyCuts;   ///< Cuts corresponding to the standalone TPC cuts in the ESDs
+      std::vector<ULong64_t>     fStatus;      ///< Track status bits
+      std::vector<int>           fKink;        ///< Kink index 0
+      std::vector<int>           fNclsTPC;     ///< Number of TPC clusters
+      std::vector<float>         fCrossedRows; ///< Number of TPC crossed rows
+      std::vector<unsigned char> fHasTPCinner; ///< TPC inner parameters available
+      std::vector<unsigned char> fPassFB32;    ///< Track passes the FB32 prefilter
+      std::vector<unsigned char> fPassTPC;     ///< Track passes the TPC only prefilter
+  };
+
+  void ESDTrackMultCounter::Count(AliESDEvent *ev, int &multTrkFB32, int &multTrkFB32Acc,
+      int &multTrkFB32TOF, int &multTrkTPC, int &multTrkTPCout) {
+    if (!fFB32trackCuts) fFB32trackCuts = AliESDtrackCuts::GetStandardITSTPCTrackCuts2011();
+    if (!fTPConlyCuts) fTPConlyCuts = AliESDtrackCuts::GetStandardTPCOnlyTrackCuts();
+
+    const int nTracks = ev->GetNumberOfTracks();
+    fStatus.resize(nTracks);
+    fKink.resize(nTracks);
+    fNclsTPC.resize(nTracks);
+    fCrossedRows.resize(nTracks);
+    fHasTPCinner.resize(nTracks);
+    fPassFB32.resize(nTracks);
+    fPassTPC.resize(nTracks);
+
+    /// Extraction of the fields, the only pass touching the tracks before the prefilters
+    for (int it = 0; it < nTracks; it++) {
+      AliESDtrack* esdTrack = ev->GetTrack(it);
+      if (!esdTrack) {
+        fStatus[it] = 0ull;
+        fKink[it] = 1;
+        fNclsTPC[it] = -1;
+        fCrossedRows[it] = -1.f;
+        fHasTPCinner[it] = 0;
+        continue;
+      }
+      fStatus[it] = esdTrack->GetStatus();
+      fKink[it] = esdTrack->GetKinkIndex(0);
+      fNclsTPC[it] = esdTrack->GetTPCNcls();
+      fCrossedRows[it] = esdTrack->GetTPCCrossedRows();
+      fHasTPCinner[it] = esdTrack->GetTPCInnerParam() != nullptr;
+    }
+
+    /// Prefilters: branch-free predicates over the flat arrays
+    const ULong64_t fb32Status = (fFB32trackCuts->GetRequireTPCRefit() ? AliESDtrack::kTPCrefit : 0ull) |
+      (fFB32trackCuts->GetRequireITSRefit() ? AliESDtrack::kITSrefit : 0ull);
+    const int fb32MaxKink = fFB32trackCuts->GetAcceptKinkDaughters() ? kMaxInt : 0;
+    const int fb32MinNcls = fFB32trackCuts->GetRequireTPCStandAlone() ? 0 : fFB32trackCuts->GetMinNClusterTPC();
+    const float fb32MinRows = fFB32trackCuts->GetMinNCrossedRowsTPC();
+    for (int it = 0; it < nTracks; it++)
+      fPassFB32[it] = ((fStatus[it] & fb32Status) == fb32Status) & (fKink[it] <= fb32MaxKink) &
+        (fNclsTPC[it] >= fb32MinNcls) & (fCrossedRows[it] >= fb32MinRows);
+
+    /// The TPC only cuts are applied to the TPC only track, which has the same TPC clusters
+    const int tpcMinNcls = fTPConlyCuts->GetRequireTPCStandAlone() ? 0 : fTPConlyCuts->GetMinNClusterTPC();
+    for (int it = 0; it < nTracks; it++)
+      fPassTPC[it] = fHasTPCinner[it] & (fNclsTPC[it] >= tpcMinNcls);
+
+    int nTPCout = 0;
+    for (int it = 0; it < nTracks; it++)
+      nTPCout += (fStatus[it] & AliESDtrack::kTPCout) ? 1 : 0;
+    multTrkTPCout = nTPCout;
+
+    /// Full cuts on the survivors
+    AliESDVertex* vtxSPD = (AliESDVertex*)ev->GetPrimaryVertexSPD();
+    const double bField = ev->GetMagneticField();
+    for (int it = 0; it < nTracks; it++) {
+      if (!fPassFB32[it] && !fPassTPC[it]) continue;
+      AliESDtrack* esdTrack = ev->GetTrack(it);
+      if (!esdTrack) continue;
+
+      if (fPassFB32[it] && fFB32trackCuts->AcceptTrack(esdTrack)) {
+        multTrkFB32++;
+        if (TMath::Abs(esdTrack->GetTOFsignalDz()) <= 10 && esdTrack->GetTOFsignal() >= 12000 && esdTrack->GetTOFsignal() <= 25000)
+          multTrkFB32TOF++;
+
+        if ((TMath::Abs(esdTrack->Eta()) < 0.8) && (esdTrack->GetTPCNcls() > 70) && (esdTrack->Pt() > 0.2) && (esdTrack->Pt() < 50))
+          multTrkFB32Acc++;
+      }
+
+      if (!fPassTPC[it]) continue;
+      /// TPC only tracks, with the same cuts of the filter bit 128
+      AliESDtrack tpcParam;
+      if (!esdTrack->FillTPCOnlyTrack(tpcParam)) continue;
+      if (!fTPConlyCuts->AcceptTrack(&tpcParam)) continue;
+      if (tpcParam.Pt() > 0.) {
+        // only constrain tracks above threshold
+        AliExternalTrackParam exParam;
+        // take the B-field from the ESD, no 3D fieldMap available at this point
+        bool relate = false;
+        relate = tpcParam.RelateToVertexTPC(vtxSPD,bField,kVeryBig, &exParam);
+        if(!relate) continue;
+      }
+      multTrkTPC++;
+    }
+  }
+
+  /// Track multiplicities used by the correlation cuts of AliEventCuts: a single loop fills
+  /// kMultESD ... kMultTrkTPCout
+  class TrackMultProvider : public AliEventQuantityProvider {
+    public:
+      TrackMultProvider() : fESDCounter{} {}
+      virtual void Compute(AliVEvent *ev, AliEventQuantityCache *cache);
+    private:
+      TrackMultProvider(const TrackMultProvider&);
+      TrackMultProvider& operator=(const TrackMultProvider&);
+      ESDTrackMultCounter fESDCounter; ///< Counting engine for the ESD tracks
+  };
+
+  void TrackMultProvider::Compute(AliVEvent *ev, AliEventQuantityCache *cache) {
+    AliESDEvent* esd = nullptr;
+    const bool isAOD = dynamic_cast<AliAODEvent*>(ev) != nullptr;
+    if (!isAOD && !(esd = dynamic_cast<AliESDEvent*>(ev)))
+      ::Fatal("AliEventQuantityCache::Compute","I don't find the AOD event nor the ESD one, aborting.");
+
+    const int nTracks = ev->GetNumberOfTracks();
+    int multESD = (isAOD) ? ((AliAODHeader*)ev->GetHeader())->GetNumberOfESDTracks() : nTracks;
+    int multTrkFB32 = 0, multTrkFB32Acc = 0, multTrkFB32TOF = 0, multTrkTPC = 0, multTrkTPCout = 0;
+    if (isAOD) {
+      for (int it = 0; it < nTracks; it++) {
+        AliAODTrack* trk = (AliAODTrack*)ev->GetTrack(it);
+        if (!trk) continue;
+        if ((trk->GetStatus() & AliESDtrack::kTPCout) &&
+            trk->GetID() > 0) multTrkTPCout++;
+        if (trk->TestFilterBit(32)) {
+          multTrkFB32++;
+          if ( TMath::Abs(trk->GetTOFsignalDz()) <= 10. && trk->GetTOFsignal() >= 12000. && trk->GetTOFsignal() <= 25000.)
+            multTrkFB32TOF++;
+          if ((fabs(trk->Eta()) < 0.8) && (trk->GetTPCNcls() >= 70) && (trk->Pt() >= 0.2) && (trk->Pt() < 50))
+            multTrkFB32Acc++;
+        }
+        if (trk->TestFilterBit(128))
+          multTrkTPC++;
+      }
+    } else
+      fESDCounter.Count(esd, multTrkFB32, multTrkFB32Acc, multTrkFB32TOF, multTrkTPC, multTrkTPCout);
+
+    cache->SetValue(AliEventQuantityCache::kMultESD, multESD);
+    cache->SetValue(AliEventQuantityCache::kMultTrkFB32, multTrkFB32);
+    cache->SetValue(AliEventQuantityCache::kMultTrkFB32Acc, multTrkFB32Acc);
+    cache->SetValue(AliEventQuantityCache::kMultTrkFB32TOF, multTrkFB32TOF);
+    cache->SetValue(AliEventQuantityCache::kMultTrkTPC, multTrkTPC);
+    cache->SetValue(AliEventQuantityCache::kMultTrkTPCout, multTrkTPCout);
+  }
+
+  class VZEROProvider : public AliEventQuantityProvider {
+    public:
+      virtual void Compute(AliVEvent *ev, AliEventQuantityCache *cache) {
+        AliVVZERO *vzero = (AliVVZERO*)ev->GetVZEROData();
+        double mult = -1.;
+        if (vzero) {
+          mult = 0.;
+          for (int ich = 0; ich < 64; ich++)
+            mult += vzero->GetMultiplicity(ich);
+        }
+        cache->SetValue(AliEventQuantityCache::kMultVZERO, mult);
+      }
+  };
+
+  /// SPD pile-up flag, either in multiplicity bins or with explicit parameters
+  class PileupSPDProvider : public AliEventQuantityProvider {
+    public:
+      PileupSPDProvider(int handle) : fHandle{handle}, fInMultBins{true}, fMinContrib{0}, fPars{0.} {}
+      PileupSPDProvider(int handle, int minContrib, double minZdist, double nSigmaZdist, double nSigmaDiamXY, double nSigmaDiamZ) :
+        fHandle{handle}, fInMultBins{false}, fMinContrib{minContrib}, fPars{minZdist, nSigmaZdist, nSigmaDiamXY, nSigmaDiamZ} {}
+      void SetHandle(int handle) { fHandle = handle; }
+      virtual void Compute(AliVEvent *ev, AliEventQuantityCache *cache) {
+        const bool pileup = fInMultBins ? ev->IsPileupFromSPDInMultBins() :
+          ev->IsPileupFromSPD(fMinContrib, fPars[0], fPars[1], fPars[2], fPars[3]);
+        cache->SetValue(fHandle, pileup ? 1. : 0.);
+      }
+    private:
+      int    fHandle;
+      bool   fInMultBins;
+      int    fMinContrib;
+      double fPars[4];
+  };
+}
+
+AliEventQuantityCache::AliEventQuantityCache() : TNamed("AliEventQuantityCache","AliEventQuantityCache"),
+  fEvent{nullptr},
+  fEventId{0ul},
+  fEntry{-1},
+  fEpoch{0ul},
+  fNames{},
+  fValues{},
+  fComputed{},
+  fProviderOf{},
+  fProviders{},
+  fPileupSPDPars{},
+  fPileupSPDHandles{} {
+    /// The order of the registrations follows EQuantity
+    const int tracks = AddProvider(new TrackMultProvider);
+    AddQuantity("MultESD", tracks);
+    AddQuantity("MultTrkFB32", tracks);
+    AddQuantity("MultTrkFB32Acc", tracks);
+    AddQuantity("MultTrkFB32TOF", tracks);
+    AddQuantity("MultTrkTPC", tracks);
+    AddQuantity("MultTrkTPCout", tracks);
+    AddQuantity("MultVZERO", AddProvider(new VZEROProvider));
+    AddQuantity("IsPileupSPDInMultBins", AddProvider(new PileupSPDProvider(kIsPileupSPDInMultBins)));
+  }
+
+AliEventQuantityCache::~AliEventQuantityCache() {
+  for (auto provider : fProviders)
+    delete provider;
+}
+
+/// Cache attached to the event (created on the first call), synchronised with the event
+///
+/// \param ev Input event
+/// \return Pointer to the cache
+AliEventQuantityCache* AliEventQuantityCache::Get(AliVEvent *ev) {
+  AliEventQuantityCache* cache = static_cast<AliEventQuantityCache*>(ev->FindListObject("AliEventQuantityCache"));
+  if (!cache) {
+    cache = new AliEventQuantityCache;
+    ev->AddObject(cache);
+  }
+  cache->SetEvent(ev);
+  return cache;
+}
+
+/// Invalidates all the cached values if ev is not the event they refer to
+///
+/// \param ev Input event
+/// \return true if the event changed
+bool AliEventQuantityCache::SetEvent(AliVEvent *ev) {
+  const unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  /// In MC bunch crossing and time stamp are not unique: use the entry number as well
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  const long long entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (ev == fEvent && evid == fEventId && entry == fEntry) return false;
+  fEvent = ev;
+  fEventId = evid;
+  fEntry = entry;
+  fEpoch++;
+  return true;
+}
+
+/// Registers a provider, the cache takes its ownership
+///
+/// \param provider Provider
+/// \return Index of the provider, to be used in AddQuantity
+int AliEventQuantityCache::AddProvider(AliEventQuantityProvider *provider) {
+  fProviders.push_back(provider);
+  return fProviders.size() - 1;
+}
+
+/// Registers a quantity computed by a provider. Registering the same name twice returns the
+/// handle of the existing quantity.
+///
+/// \param name Name of the quantity
+/// \param provider Index returned by AddProvider
+/// \return Handle of the quantity
+int AliEventQuantityCache::AddQuantity(const char *name, int provider) {
+  const int existing = FindQuantity(name);
+  if (existing >= 0) return existing;
+  if (provider < 0 || provider >= int(fProviders.size()))
+    ::Fatal("AliEventQuantityCache::AddQuantity","Quantity %s registered with unknown provider %i.", name, provider);
+  fNames.push_back(name);
+  fValues.push_back(0.);
+  fComputed.push_back(0ul);
+  fProviderOf.push_back(provider);
+  return fValues.size() - 1;
+}
+
+int AliEventQuantityCache::FindQuantity(const char *name) const {
+  for (size_t i = 0; i < fNames.size(); ++i)
+    if (fNames[i] == name) return i;
+  return -1;
+}
+
+/// Handle of the AliVEvent::IsPileupFromSPD flag for the given parameters (1 if pile-up);
+/// tasks using the same parameters share the same quantity.
+int AliEventQuantityCache::AddPileupFromSPD(int minContrib, double minZdist, double nSigmaZdist, double nSigmaDiamXY, double nSigmaDiamZ) {
+  const double pars[5] = {double(minContrib), minZdist, nSigmaZdist, nSigmaDiamXY, nSigmaDiamZ};
+  for (size_t i = 0; i < fPileupSPDHandles.size(); ++i)
+    if (std::equal(pars, pars + 5, fPileupSPDPars.begin() + 5 * i)) return fPileupSPDHandles[i];
+
+  const std::string name = Form("IsPileupFromSPD_%i_%g_%g_%g_%g",minContrib,minZdist,nSigmaZdist,nSigmaDiamXY,nSigmaDiamZ);
+  int handle = FindQuantity(name.data());
+  if (handle < 0) {
+    /// The provider needs the handle AddQuantity assigns to its quantity
+    PileupSPDProvider *provider = new PileupSPDProvider(-1, minContrib, minZdist, nSigmaZdist, nSigmaDiamXY, nSigmaDiamZ);
+    handle = AddQuantity(name.data(), AddProvider(provider));
+    provider->SetHandle(handle);
+  }
+  fPileupSPDPars.insert(fPileupSPDPars.end(), pars, pars + 5);
+  fPileupSPDHandles.push_back(handle);
+  return handle;
+}
+
+void AliEventQuantityCache::Compute(int handle) {
+  const int provider = fProviderOf[handle];
+  if (!fEvent) {
+    SetValue(handle, 0.);
+    return;
+  }
+  fProviders[provider]->Compute(fEvent, this);
+  /// A provider not filling some of its quantities must not be called again for this event
+  for (size_t i = 0; i < fProviderOf.size(); ++i)
+    if (fProviderOf[i] == provider) fComputed[i] = fEpoch;
+}
@@ -0,0 +1,84 @@
+#ifndef _AliEventQuantityCache_h_
+#define _AliEventQuantityCache_h_
+
+#include <TNamed.h>
+#include <string>
+#include <vector>
+
+class AliVEvent;
+class AliEventQuantityCache;
+
+/// \class AliEventQuantityProvider
+/// Computes one or more quantities of AliEventQuantityCache for the current event.
+/// Implementations fill their quantities with AliEventQuantityCache::SetValue.
+class AliEventQuantityProvider {
+  public:
+    virtual ~AliEventQuantityProvider() {}
+    virtual void Compute(AliVEvent *ev, AliEventQuantityCache *cache) = 0;
+};
+
+/// \class AliEventQuantityCache
+/// Per-event memoizing cache of event-derived quantities shared by all the tasks of a train.
+///
+/// A single instance is attached to the user list of the input event (as AliEventCutsContainer
+/// used to be), see Get(). Quantities are registered once and addressed by an integer handle;
+/// each one is evaluated lazily and at most once per event. The standard quantities listed in
+/// EQuantity are always registered, so their handles are compile-time constants.
+class AliEventQuantityCache : public TNamed {
+  public:
+    enum EQuantity {
+      kMultESD = 0,          ///< Number of ESD tracks (from the AOD header for AODs)
+      kMultTrkFB32,          ///< FB32 tracks (standard ITS-TPC 2011 cuts on ESDs)
+      kMultTrkFB32Acc,       ///< FB32 tracks in |eta| < 0.8, pt in [0.2,50), >= 70 TPC clusters
+      kMultTrkFB32TOF,       ///< FB32 tracks matched in time with TOF
+      kMultTrkTPC,           ///< FB128 (TPC only) tracks
+      kMultTrkTPCout,        ///< Tracks with kTPCout
+      kMultVZERO,            ///< Sum of the VZERO channel multiplicities (-1 if not available)
+      kIsPileupSPDInMultBins,///< AliVEvent::IsPileupFromSPDInMultBins
+      kNQuantities
+    };
+
+    AliEventQuantityCache();
+    virtual ~AliEventQuantityCache();
+
+    static AliEventQuantityCache* Get(AliVEvent *ev);
+
+    bool   SetEvent(AliVEvent *ev);
+    int    AddProvider(AliEventQuantityProvider *provider);
+    int    AddQuantity(const char *name, int provider);
+    int    FindQuantity(const char *name) const;
+    int    GetNQuantities() const { return fValues.size(); }
+    const char* GetQuantityName(int handle) const { return fNames[handle].data(); }
+
+    int    AddPileupFromSPD(int minContrib, double minZdist, double nSigmaZdist, double nSigmaDiamXY, double nSigmaDiamZ);
+
+    /// Value of the quantity for the current event, computed on the first request
+    double GetValue(int handle) {
+      if (fComputed[handle] != fEpoch) Compute(handle);
+      return fValues[handle];
+    }
+    void   SetValue(int handle, double val) { fValues[handle] = val; fComputed[handle] = fEpoch; }
+
+  private:
+    AliEventQuantityCache(const AliEventQuantityCache &copy);
+    AliEventQuantityCache& operator=(const AliEventQuantityCache &copy);
+    void Compute(int handle);
+
+    AliVEvent*           fEvent;          //!<! Event the cached values refer to
+    unsigned long        fEventId;        //!<! Bunch crossing and time stamp of fEvent
+    long long            fEntry;          //!<! Entry of fEvent in the analysis manager
+    unsigned long        fEpoch;          //!<! Incremented for each new event, invalidates all the values
+
+    std::vector<std::string>   fNames;    //!<! Quantity names
+    std::vector<double>        fValues;   //!<! Quantity values
+    std::vector<unsigned long> fComputed; //!<! Epoch at which each value was computed
+    std::vector<int>           fProviderOf; //!<! Provider computing each quantity
+    std::vector<AliEventQuantityProvider*> fProviders; //!<! Owned providers
+
+    std::vector<double>  fPileupSPDPars;  //!<! Parameters of the quantities registered with AddPileupFromSPD (5 per quantity)
+    std::vector<int>     fPileupSPDHandles; //!<! Handles of the quantities registered with AddPileupFromSPD
+
+    ClassDef(AliEventQuantityCache,1)
+};
+
+#endif
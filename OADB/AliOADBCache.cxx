@@ -0,0 +1,174 @@
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB objects.
+//     See AliOADBCache.h for the description.
+//-------------------------------------------------------------------------
+
+#include "AliOADBCache.h"
+#include "AliOADBContainer.h"
+#include "AliLog.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH1.h"
+#include <mutex>
+
+ClassImp(AliOADBCache)
+
+namespace {
+  // Serialises all accesses to the cache (and to the file reading underneath)
+  std::mutex gOADBCacheMutex;
+}
+
+//-------------------------------------------------------------------------
+class AliOADBCacheEntry {
+ public :
+  AliOADBCacheEntry(TObject* obj) : fObject(obj), fRunIndex() {}
+  ~AliOADBCacheEntry() { delete fObject; }
+
+  Int_t FindIndex(Int_t run, const char* passName);
+
+  TObject* fObject;  // The object read from file
+  std::map<std::string, std::map<Int_t, Int_t> > fRunIndex; // Container index of the runs already looked up, per pass name
+
+ private :
+  AliOADBCacheEntry(const AliOADBCacheEntry&);
+  AliOADBCacheEntry& operator=(const AliOADBCacheEntry&);
+};
+
+Int_t AliOADBCacheEntry::FindIndex(Int_t run, const char* passName)
+{
+  // Index of the entry of the container valid for run and passName,
+  // looked up in the container only the first time the run is seen.
+  // Only exact runs are cached: the ranges of a container may overlap,
+  // in which case GetIndexForRun picks the last matching entry.
+  std::map<Int_t, Int_t>& runIndex = fRunIndex[passName];
+  std::map<Int_t, Int_t>::const_iterator it = runIndex.find(run);
+  if (it != runIndex.end()) return it->second;
+
+  Int_t idx = static_cast<AliOADBContainer*>(fObject)->GetIndexForRun(run, passName);
+  runIndex[run] = idx;
+  return idx;
+}
+
+//-------------------------------------------------------------------------
+AliOADBCache::AliOADBCache() :
+  TObject(),
+  fEntries(),
+  fNRequests(0),
+  fNLoads(0)
+{
+  // ctor, use Instance()
+}
+
+AliOADBCache::~AliOADBCache()
+{
+  // dtor
+  Reset();
+}
+
+AliOADBCache* AliOADBCache::Instance()
+{
+  // The cache instance of the process. It is never deleted, so that the
+  // objects stay valid until the very end of the job.
+  static AliOADBCache* instance = new AliOADBCache();
+  return instance;
+}
+
+AliOADBCacheEntry* AliOADBCache::FindEntry(const char* fileName, const char* key)
+{
+  // Find the entry for key in fileName, reading it from file if not
+  // there yet. Must be called with the mutex held.
+  fNRequests++;
+  std::string name = std::string(fileName) + "#" + key;
+  std::map<std::string, AliOADBCacheEntry*>::iterator it = fEntries.find(name);
+  if (it != fEntries.end()) return it->second;
+
+  TDirectory* savedDir = gDirectory;
+  Bool_t oldStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  TObject* obj = 0;
+  TFile* file = TFile::Open(fileName);
+  if (!file || !file->IsOpen()) {
+    AliError(Form("Cannot open OADB file %s", fileName));
+  } else {
+    obj = file->Get(key);
+    if (!obj) AliError(Form("OADB file %s does not contain %s", fileName, key));
+    else if (obj->InheritsFrom(TH1::Class())) static_cast<TH1*>(obj)->SetDirectory(0);
+  }
+  delete file;
+
+  TH1::AddDirectory(oldStatus);
+  if (savedDir) savedDir->cd();
+
+  // Failures are not cached, the next request tries again
+  if (!obj) return 0;
+  fNLoads++;
+  AliOADBCacheEntry* entry = new AliOADBCacheEntry(obj);
+  fEntries[name] = entry;
+  AliInfo(Form("Loaded %s from %s", key, fileName));
+  return entry;
+}
+
+TObject* AliOADBCache::GetFileObject(const char* fileName, const char* key)
+{
+  // Object named key in fileName, shared and read-only. 0 if not found.
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  AliOADBCacheEntry* entry = FindEntry(fileName, key);
+  return entry ? entry->fObject : 0;
+}
+
+AliOADBContainer* AliOADBCache::GetContainer(const char* fileName, const char* name)
+{
+  // AliOADBContainer named name in fileName, shared and read-only.
+  // 0 if not found or if the object is not a container.
+  TObject* obj = GetFileObject(fileName, name);
+  if (obj && !obj->InheritsFrom(AliOADBContainer::Class())) {
+    AliError(Form("%s in %s is a %s, not an AliOADBContainer", name, fileName, obj->ClassName()));
+    return 0;
+  }
+  return static_cast<AliOADBContainer*>(obj);
+}
+
+TObject* AliOADBCache::GetObject(const char* fileName, const char* name, Int_t run,
+                                 const char* defaultName, const char* passName)
+{
+  // Object valid for run (and passName) in the container name of fileName,
+  // as AliOADBContainer::GetObject: the default object defaultName is
+  // returned if there is no entry for run. Shared and read-only.
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  AliOADBCacheEntry* entry = FindEntry(fileName, name);
+  if (!entry) return 0;
+  AliOADBContainer* cont = dynamic_cast<AliOADBContainer*>(entry->fObject);
+  if (!cont) {
+    AliError(Form("%s in %s is a %s, not an AliOADBContainer", name, fileName, entry->fObject->ClassName()));
+    return 0;
+  }
+  Int_t idx = entry->FindIndex(run, passName);
+  if (idx >= 0) return cont->GetObjectByIndex(idx);
+  if (defaultName && defaultName[0]) return cont->GetDefaultObject(defaultName);
+  return 0;
+}
+
+void AliOADBCache::Reset()
+{
+  // Delete all the objects. Only safe when no task holds any of them anymore.
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  for (std::map<std::string, AliOADBCacheEntry*>::iterator it = fEntries.begin(); it != fEntries.end(); ++it)
+    delete it->second;
+  fEntries.clear();
+}
+
+void AliOADBCache::Print(Option_t* /*option*/) const
+{
+  // Print the cached objects and the usage statistics
+  std::lock_guard<std::mutex> lock(gOADBCacheMutex);
+  Printf("AliOADBCache: %d objects, %llu requests, %llu read from file",
+         Int_t(fEntries.size()), fNRequests, fNLoads);
+  for (std::map<std::string, AliOADBCacheEntry*>::const_iterator it = fEntries.begin(); it != fEntries.end(); ++it) {
+    Int_t nRuns = 0;
+    for (std::map<std::string, std::map<Int_t, Int_t> >::const_iterator p = it->second->fRunIndex.begin();
+         p != it->second->fRunIndex.end(); ++p)
+      nRuns += p->second.size();
+    Printf("  %-60s %-24s %d runs indexed", it->first.c_str(), it->second->fObject->ClassName(), nRuns);
+  }
+}
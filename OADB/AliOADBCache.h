@@ -0,0 +1,55 @@
+#ifndef AliOADBCache_H
+#define AliOADBCache_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB objects.
+//
+//     Each (file, key) pair is read once and kept in memory for the
+//     lifetime of the process; the objects are shared by all the
+//     tasks requesting them and must be treated as read-only (clone
+//     them if they have to be modified or owned). For AliOADBContainer
+//     objects the index of each run already looked up is kept, so that
+//     returning to a known run does not go through the container again.
+//-------------------------------------------------------------------------
+
+#include <TObject.h>
+#include <map>
+#include <string>
+
+class AliOADBContainer;
+class AliOADBCacheEntry;
+
+class AliOADBCache : public TObject {
+
+ public :
+  static AliOADBCache* Instance();
+
+  TObject*          GetFileObject(const char* fileName, const char* key);
+  AliOADBContainer* GetContainer(const char* fileName, const char* name);
+  TObject*          GetObject(const char* fileName, const char* name, Int_t run,
+                              const char* defaultName = "", const char* passName = "");
+
+  void              Reset();
+  Int_t             GetNObjects()  const { return fEntries.size(); }
+  ULong64_t         GetNRequests() const { return fNRequests; }
+  ULong64_t         GetNLoads()    const { return fNLoads; }
+  virtual void      Print(Option_t* option = "") const;
+
+ private :
+  AliOADBCache();
+  virtual ~AliOADBCache();
+  AliOADBCache(const AliOADBCache& cont);            // not implemented
+  AliOADBCache& operator=(const AliOADBCache& cont); // not implemented
+
+  AliOADBCacheEntry* FindEntry(const char* fileName, const char* key);
+
+  std::map<std::string, AliOADBCacheEntry*> fEntries; //! Loaded objects, keyed by "file#key"
+  ULong64_t fNRequests;                                //! Number of GetFileObject/GetObject calls
+  ULong64_t fNLoads;                                   //! Number of objects read from file
+
+  ClassDef(AliOADBCache, 0);
+};
+
+#endif
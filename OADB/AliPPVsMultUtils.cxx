@@ -22,6 +22,7 @@
 #include "AliESDUtils.h"
 #include "AliESDtrackCuts.h"
 #include "AliPPVsMultUtils.h"
+#include "AliEventQuantityCache.h"
 #include <TFile.h>
 #include "AliAODHeader.h"
 #include "AliInputEventHandler.h"
@@ -709,16 +710,10 @@ Bool_t AliPPVsMultUtils::IsNotPileupSPDInMultBins(AliVEvent *event)
 // Checks if not pileup from SPD (via IsPileupFromSPDInMultBins)
 {
     Bool_t lReturnValue = kTRUE;
-    //Getting around to the SPD vertex -> typecast to ESD/AOD
-    if (event->InheritsFrom("AliESDEvent")) {
-        AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
-        if ( esdevent->IsPileupFromSPDInMultBins() == kTRUE ) lReturnValue = kFALSE;
-    }
-    else if (event->InheritsFrom("AliAODEvent")) {
-        AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
-        if ( aodevent->IsPileupFromSPDInMultBins() == kTRUE ) lReturnValue = kFALSE;
+    //Only ESD/AOD events, flag shared with the other tasks via the event quantity cache
+    if (event->InheritsFrom("AliESDEvent") || event->InheritsFrom("AliAODEvent")) {
+        AliEventQuantityCache *cache = AliEventQuantityCache::Get(event);
+        if ( cache->GetValue(AliEventQuantityCache::kIsPileupSPDInMultBins) > 0.5 ) lReturnValue = kFALSE;
     }
     return lReturnValue;
 }
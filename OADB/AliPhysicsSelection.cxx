@@ -66,6 +66,10 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 #include <vector>
+#include <map>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 
 #include <Riostream.h>
 #include <TH1F.h>
@@ -96,6 +100,7 @@
 #include "TPRegexp.h"
 #include "TFile.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBPhysicsSelection.h"
 #include "AliOADBFillingScheme.h"
 #include "AliOADBTriggerAnalysis.h"
@@ -111,6 +116,178 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+// Trigger logic (e.g. "SPDGFO >= 1 || V0A || V0C") compiled into an expression tree.
+// Trigger bits are only evaluated when needed and && / || are short-circuited.
+// Expressions that cannot be parsed here keep using the TFormula of FindForumla.
+class AliPSCompiledLogic {
+public:
+  enum ENodeType { kConst, kBit, kNot, kAnd, kOr, kGreater, kGreaterEqual, kLess, kLessEqual, kEqual, kNotEqual };
+  struct Node {
+    Int_t    fType;  // one of ENodeType
+    Int_t    fLeft;  // index of the left operand in fNodes
+    Int_t    fRight; // index of the right operand in fNodes
+    Int_t    fSlot;  // for kBit: index in fBits
+    Double_t fValue; // for kConst
+  };
+
+  AliPSCompiledLogic() : fValid(kFALSE), fRoot(-1), fNodes(), fBits(), fValues(), fEvaluated(),
+    fPos(0), fEvent(0), fTriggerAnalysis(0), fOfflineFlag(0) {}
+
+  Bool_t Compile(const char* logic) {
+    fNodes.clear();
+    fBits.clear();
+    fPos = logic;
+    fValid = kTRUE;
+    fRoot = ParseOr();
+    SkipSpaces();
+    if (*fPos) fValid = kFALSE; // trailing characters
+    fValues.resize(fBits.size());
+    fEvaluated.resize(fBits.size());
+    return fValid;
+  }
+
+  Bool_t IsValid() const { return fValid; }
+
+  Bool_t Evaluate(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Bool_t offline) {
+    std::fill(fEvaluated.begin(), fEvaluated.end(), kFALSE);
+    fEvent = event;
+    fTriggerAnalysis = triggerAnalysis;
+    fOfflineFlag = offline ? AliTriggerAnalysis::kOfflineFlag : 0;
+    return Eval(fRoot) != 0;
+  }
+
+private:
+  Double_t Eval(Int_t i) {
+    const Node& n = fNodes[i];
+    switch (n.fType) {
+      case kConst: return n.fValue;
+      case kBit:
+        if (!fEvaluated[n.fSlot]) {
+          fValues[n.fSlot] = fTriggerAnalysis->EvaluateTrigger(fEvent, static_cast<AliTriggerAnalysis::Trigger>(fBits[n.fSlot] | fOfflineFlag));
+          fEvaluated[n.fSlot] = kTRUE;
+        }
+        return fValues[n.fSlot];
+      case kNot:          return Eval(n.fLeft) == 0;
+      case kAnd:          return Eval(n.fLeft) != 0 && Eval(n.fRight) != 0;
+      case kOr:           return Eval(n.fLeft) != 0 || Eval(n.fRight) != 0;
+      case kGreater:      return Eval(n.fLeft) >  Eval(n.fRight);
+      case kGreaterEqual: return Eval(n.fLeft) >= Eval(n.fRight);
+      case kLess:         return Eval(n.fLeft) <  Eval(n.fRight);
+      case kLessEqual:    return Eval(n.fLeft) <= Eval(n.fRight);
+      case kEqual:        return Eval(n.fLeft) == Eval(n.fRight);
+      case kNotEqual:     return Eval(n.fLeft) != Eval(n.fRight);
+    }
+    return 0;
+  }
+
+  Int_t AddNode(Int_t type, Int_t left = -1, Int_t right = -1, Int_t slot = -1, Double_t value = 0) {
+    Node n = { type, left, right, slot, value };
+    fNodes.push_back(n);
+    return fNodes.size() - 1;
+  }
+
+  void SkipSpaces() { while (*fPos == ' ' || *fPos == '\t') fPos++; }
+
+  Bool_t Accept(const char* op) {
+    SkipSpaces();
+    size_t len = strlen(op);
+    if (strncmp(fPos, op, len) != 0) return kFALSE;
+    fPos += len;
+    return kTRUE;
+  }
+
+  // or := and ('||' and)*
+  Int_t ParseOr() {
+    Int_t left = ParseAnd();
+    while (fValid && Accept("||")) left = AddNode(kOr, left, ParseAnd());
+    return left;
+  }
+
+  // and := comparison ('&&' comparison)*
+  Int_t ParseAnd() {
+    Int_t left = ParseComparison();
+    while (fValid && Accept("&&")) left = AddNode(kAnd, left, ParseComparison());
+    return left;
+  }
+
+  // comparison := unary [('>=' | '<=' | '==' | '!=' | '>' | '<') unary]
+  Int_t ParseComparison() {
+    Int_t left = ParseUnary();
+    if (!fValid) return left;
+    static const struct { const char* fOp; Int_t fType; } ops[] = {
+      { ">=", kGreaterEqual }, { "<=", kLessEqual }, { "==", kEqual }, { "!=", kNotEqual }, { ">", kGreater }, { "<", kLess }
+    };
+    for (const auto& op : ops) {
+      if (Accept(op.fOp)) return AddNode(op.fType, left, ParseUnary());
+    }
+    return left;
+  }
+
+  // unary := '!' unary | '(' or ')' | number | trigger
+  Int_t ParseUnary() {
+    SkipSpaces();
+    if (*fPos == '!' && fPos[1] != '=') {
+      fPos++;
+      return AddNode(kNot, ParseUnary());
+    }
+    if (*fPos == '(') {
+      fPos++;
+      Int_t inner = ParseOr();
+      if (!Accept(")")) fValid = kFALSE;
+      return inner;
+    }
+    if (isdigit(*fPos)) {
+      char* end = 0;
+      Double_t value = strtod(fPos, &end);
+      fPos = end;
+      return AddNode(kConst, -1, -1, -1, value);
+    }
+    if (isalpha(*fPos)) {
+      const char* begin = fPos;
+      while (isalnum(*fPos)) fPos++;
+      std::string name(begin, fPos);
+      TInterpreter::EErrorCode error;
+      Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", name.c_str()), &error);
+      if (error > 0) {
+        fValid = kFALSE;
+        return -1;
+      }
+      Int_t slot = std::find(fBits.begin(), fBits.end(), bit) - fBits.begin();
+      if (slot == (Int_t)fBits.size()) fBits.push_back(static_cast<AliTriggerAnalysis::Trigger>(bit));
+      return AddNode(kBit, -1, -1, slot);
+    }
+    fValid = kFALSE;
+    return -1;
+  }
+
+  Bool_t fValid;                                   // false if the logic could not be parsed
+  Int_t fRoot;                                     // index of the root node
+  std::vector<Node> fNodes;                        // expression tree
+  std::vector<AliTriggerAnalysis::Trigger> fBits;  // trigger bits referenced in the logic
+  std::vector<Int_t> fValues;                      // trigger bit values of the current evaluation
+  std::vector<Bool_t> fEvaluated;                  // whether the trigger bit was already evaluated
+  const char* fPos;                                // parser position
+  const AliVEvent* fEvent;                         // event of the current evaluation
+  AliTriggerAnalysis* fTriggerAnalysis;            // trigger analysis of the current evaluation
+  Int_t fOfflineFlag;                              // offline flag of the current evaluation
+};
+
+class StringToLogic : public std::map<std::string, AliPSCompiledLogic> {};
+
+// Trigger class "+A,B -C #BC &RET *LOGIC" in compiled form
+struct AliPSCompiledClass {
+  std::vector<std::pair<TPRegexp*, Int_t> > fRequirements; // regexp and flag (1 = required, 0 = rejected)
+  std::vector<Int_t> fBunchCrossings;                     // accepted bunch crossing numbers, empty = all
+  UInt_t fReturnCode;                                     // offline trigger mask of the class
+  AliPSCompiledLogic* fOnlineLogic;                       // compiled hardware trigger logic
+  AliPSCompiledLogic* fOfflineLogic;                      // compiled offline trigger logic
+  const char* fOnlineLogicString;                         // hardware trigger logic, used if not compiled
+  const char* fOfflineLogicString;                        // offline trigger logic, used if not compiled
+};
+
+class AliPSCompiledClasses : public std::vector<AliPSCompiledClass> {};
+class FiredClassesToMatches : public std::map<std::string, std::vector<Bool_t> > {};
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -132,7 +309,10 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fTriggerToLogic(new StringToLogic()),
+fCompiledClasses(new AliPSCompiledClasses()),
+fFiredToMatches(new FiredClassesToMatches())
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -162,7 +342,10 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fTriggerToLogic(new StringToLogic()),
+ fCompiledClasses(new AliPSCompiledClasses()),
+ fFiredToMatches(new FiredClassesToMatches())
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,6 +362,9 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fTriggerToLogic;
+  delete fCompiledClasses;
+  delete fFiredToMatches;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -302,21 +488,26 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (eventType != 7) return kFALSE;
   }
   
+  // the trigger classes were compiled in Initialize; the class requirements only
+  // depend on the fired trigger classes and are cached per distinct string
+  const std::vector<Bool_t>& classMatches = MatchTriggerClasses(event->GetFiredTriggerClasses());
+  
   UInt_t accept = 0;
-  Int_t nColl = fCollTrigClasses.GetEntries();
-  Int_t nBG   = fBGTrigClasses.GetEntries();
-  for (Int_t i=0; i<nColl+nBG; i++) {
-    const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
-    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
+  for (UInt_t i=0; i<fCompiledClasses->size(); i++) {
+    const AliPSCompiledClass& triggerClass = (*fCompiledClasses)[i];
     
     AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
     triggerAnalysis->FillTriggerClasses(event);
     
-    Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    if (!classMatches[i]) continue; // required not found or rejected found
+    if (!triggerClass.fBunchCrossings.empty() &&
+        std::find(triggerClass.fBunchCrossings.begin(), triggerClass.fBunchCrossings.end(), (Int_t) event->GetBunchCrossNumber()) == triggerClass.fBunchCrossings.end()) continue;
+    UInt_t singleTriggerResult = triggerClass.fReturnCode;
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    Bool_t onlineDecision  = triggerClass.fOnlineLogic  ? EvaluateCompiledLogic(event, triggerAnalysis, *triggerClass.fOnlineLogic, kFALSE)
+                                                        : EvaluateTriggerLogic(event, triggerAnalysis, triggerClass.fOnlineLogicString, kFALSE);
+    Bool_t offlineDecision = triggerClass.fOfflineLogic ? EvaluateCompiledLogic(event, triggerAnalysis, *triggerClass.fOfflineLogic, kTRUE)
+                                                        : EvaluateTriggerLogic(event, triggerAnalysis, triggerClass.fOfflineLogicString, kTRUE);
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -361,29 +552,33 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   /// Open OADB file and fetch OADB objects
   TString oadbfilename = AliPhysicsSelection::GetOADBFileName();
   
-  TFile * foadb = TFile::Open(oadbfilename);
-  if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+  // The containers are read once per job and shared with the other tasks: take
+  // our own copies of the objects, which may be modified below
+  AliOADBCache* oadbCache = AliOADBCache::Instance();
   
   if(!fPSOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
     AliInfo("Using Standard OADB");
-    AliOADBContainer * psContainer = (AliOADBContainer*) foadb->Get("physSel");
-    if (!psContainer) AliFatal("Cannot fetch OADB container for Physics selection");
-    fPSOADB = (AliOADBPhysicsSelection*) psContainer->GetObject(runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
-    if (!fPSOADB) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "physSel")) AliFatal("Cannot fetch OADB container for Physics selection");
+    TObject* psObject = oadbCache->GetObject(oadbfilename, "physSel", runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
+    if (!psObject) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    delete fPSOADB;
+    fPSOADB = (AliOADBPhysicsSelection*) psObject->Clone();
   } else {
     AliInfo("Using Custom OADB");
   }
   if(!fFillOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * fillContainer = (AliOADBContainer*) foadb->Get("fillScheme");
-    if (!fillContainer) AliFatal("Cannot fetch OADB container for filling scheme");
-    fFillOADB = (AliOADBFillingScheme*) fillContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fFillOADB) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "fillScheme")) AliFatal("Cannot fetch OADB container for filling scheme");
+    TObject* fillObject = oadbCache->GetObject(oadbfilename, "fillScheme", runNumber, "Default",fPassName);
+    if (!fillObject) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    delete fFillOADB;
+    fFillOADB = (AliOADBFillingScheme*) fillObject->Clone();
   }
   if(!fTriggerOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * triggerContainer = (AliOADBContainer*) foadb->Get("trigAnalysis");
-    if (!triggerContainer) AliFatal("Cannot fetch OADB container for trigger analysis");
-    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fTriggerOADB) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "trigAnalysis")) AliFatal("Cannot fetch OADB container for trigger analysis");
+    TObject* triggerObject = oadbCache->GetObject(oadbfilename, "trigAnalysis", runNumber, "Default",fPassName);
+    if (!triggerObject) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    delete fTriggerOADB;
+    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerObject->Clone();
     fTriggerOADB->Print();
   }
   
@@ -487,6 +682,7 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   }
   
   fCurrentRun = runNumber;
+  CompileTriggerClasses();
 
   TH1::AddDirectory(oldStatus);
   return kTRUE;
@@ -907,3 +1103,112 @@ TPRegexp& AliPhysicsSelection::FindRegexp(const std::string& triggers) const {
 
   return fTriggerToRegexp->emplace(triggers, std::move(re)).first->second;
 }
+
+void AliPhysicsSelection::CompileTriggerClasses() {
+  // Parses the collision and background trigger classes once per run
+  // (format see CheckTriggerClass) and resolves their trigger logic
+  fCompiledClasses->clear();
+  fFiredToMatches->clear();
+
+  struct Util {
+    static Int_t atoi(const char*& str) {
+      Int_t ret = 0;
+      while (*str && *str != ' ')
+        ret = 10 * ret + (*str++ - '0');
+      return ret;
+    }
+  };
+
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+    AliPSCompiledClass triggerClass;
+    triggerClass.fReturnCode = AliVEvent::kUserDefined;
+    Int_t triggerLogic = 0;
+
+    std::string str;
+    while (*trigger) {
+      // required or rejected triggers
+      if (*trigger == '+' || *trigger == '-') {
+        Int_t flag = (*trigger == '+');
+        trigger++;
+        const char* begin = trigger;
+        while (*trigger && *trigger != ' ')
+          trigger++;
+        str.assign(begin, trigger);
+        triggerClass.fRequirements.push_back(std::make_pair(&FindRegexp(str), flag));
+        continue;
+      }
+      // bunch crossing
+      if (*trigger == '#') {
+        triggerClass.fBunchCrossings.push_back(Util::atoi(++trigger));
+        continue;
+      }
+      // return value
+      if (*trigger == '&') {
+        triggerClass.fReturnCode = Util::atoi(++trigger);
+        continue;
+      }
+      // triggerLogic value
+      if (*trigger == '*') {
+        triggerLogic = Util::atoi(++trigger);
+        continue;
+      }
+      trigger++;
+    }
+
+    triggerClass.fOnlineLogicString  = fPSOADB->GetHardwareTrigger(triggerLogic);
+    triggerClass.fOfflineLogicString = fPSOADB->GetOfflineTrigger(triggerLogic);
+    AliPSCompiledLogic& online  = FindLogic(triggerClass.fOnlineLogicString);
+    AliPSCompiledLogic& offline = FindLogic(triggerClass.fOfflineLogicString);
+    triggerClass.fOnlineLogic  = online.IsValid()  ? &online  : 0;
+    triggerClass.fOfflineLogic = offline.IsValid() ? &offline : 0;
+    fCompiledClasses->push_back(triggerClass);
+  }
+}
+
+const std::vector<Bool_t>& AliPhysicsSelection::MatchTriggerClasses(const TString& firedClasses) {
+  // Returns for each compiled trigger class whether its required and rejected
+  // trigger classes are fulfilled by the given fired trigger classes
+  auto it = fFiredToMatches->find(firedClasses.Data());
+  if (it != fFiredToMatches->end())
+    return it->second; // cache hit
+
+  // the number of distinct strings per run is small, the limit only protects against unexpected input
+  const size_t kMaxCachedFiredClasses = 10000;
+  if (fFiredToMatches->size() >= kMaxCachedFiredClasses) fFiredToMatches->clear();
+
+  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", firedClasses.Data()));
+
+  std::vector<Bool_t> matches(fCompiledClasses->size(), kTRUE);
+  for (UInt_t i=0; i<fCompiledClasses->size(); i++) {
+    for (const auto& requirement : (*fCompiledClasses)[i].fRequirements) {
+      if (requirement.first->Match(firedClasses, "", 0, 1) != requirement.second) {
+        matches[i] = kFALSE;
+        break;
+      }
+    }
+  }
+  return fFiredToMatches->emplace(std::string(firedClasses.Data()), std::move(matches)).first->second;
+}
+
+AliPSCompiledLogic& AliPhysicsSelection::FindLogic(const char* triggerLogic) {
+  // Returns the compiled form of the trigger logic; if it cannot be
+  // compiled the returned object is invalid and the TFormula is used instead
+  auto it = fTriggerToLogic->find(triggerLogic);
+  if (it != fTriggerToLogic->end())
+    return it->second; // cache hit
+
+  AliPSCompiledLogic& logic = (*fTriggerToLogic)[triggerLogic];
+  if (!logic.Compile(triggerLogic))
+    AliInfo(Form("Trigger logic %s is evaluated with TFormula", triggerLogic));
+  return logic;
+}
+
+Bool_t AliPhysicsSelection::EvaluateCompiledLogic(const AliVEvent* event,
+                                                  AliTriggerAnalysis* triggerAnalysis,
+                                                  AliPSCompiledLogic& logic, Bool_t offline){
+  // Evaluates the compiled trigger logic; trigger bits are only evaluated when needed
+  return logic.Evaluate(event, triggerAnalysis, offline);
+}
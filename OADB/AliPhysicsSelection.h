@@ -45,6 +45,10 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class StringToLogic;
+class AliPSCompiledLogic;
+class AliPSCompiledClasses;
+class FiredClassesToMatches;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -128,6 +132,15 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
+  void CompileTriggerClasses();
+  const std::vector<Bool_t>& MatchTriggerClasses(const TString& firedClasses);
+  AliPSCompiledLogic& FindLogic(const char* triggerLogic);
+  Bool_t EvaluateCompiledLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, AliPSCompiledLogic& logic, Bool_t offline);
+
+  StringToLogic* fTriggerToLogic;           //! Map trigger logic strings to compiled expressions
+  AliPSCompiledClasses* fCompiledClasses;   //! Trigger classes compiled for the current run
+  FiredClassesToMatches* fFiredToMatches;   //! Per-run cache of the class requirements for each distinct fired-class string
+
   ClassDef(AliPhysicsSelection, 24)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
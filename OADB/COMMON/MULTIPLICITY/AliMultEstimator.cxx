@@ -19,12 +19,316 @@
 #include "TObjString.h"
 #include "TBrowser.h"
 #include "TFormula.h"
+#include "TH1.h"
 #include "RVersion.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//________________________________________________________________
+// Estimator definitions compiled once per run into a small stack
+// program. Variables are bound directly to the storage of the
+// AliMultVariables of the input, so evaluating an estimator does not
+// go through TFormula::SetParameter/Eval. The grammar is the C-like
+// subset used in the estimator definitions: numbers, variable names
+// (usually enclosed in parentheses), unary + - !, binary * / + -,
+// comparisons, && || and the ternary ?: operator. Anything else makes
+// Compile() fail and the estimator falls back to TFormula.
+class AliMultEstimatorProgram {
+public:
+    enum EOpCode {
+        kConst, kLoadFloat, kLoadInt,
+        kNeg, kNot,
+        kMul, kDiv, kAdd, kSub,
+        kLT, kGT, kLE, kGE, kEQ, kNE,
+        kAnd, kOr, kSelect
+    };
+    struct Instr {
+        Int_t          fOp;    // EOpCode
+        Int_t          fSlot;  // variable index in AliMultInput
+        Double_t       fConst; // constant for kConst
+        const Float_t* fFloat; // bound storage for kLoadFloat
+        const Int_t*   fInt;   // bound storage for kLoadInt
+    };
+    
+    AliMultEstimatorProgram() : fCode(), fStack(), fInput(0), fExpr(0), fPos(0), fDepth(0), fMaxDepth(0) {}
+    
+    Bool_t Compile(const TString& lDefinition, const AliMultInput* lInput);
+    void   Bind(const AliMultInput* lInput);
+    const AliMultInput* GetInput() const { return fInput; }
+    Double_t Eval();
+    
+private:
+    //Parser (recursive descent, emits postfix code)
+    void SkipSpace() { while (fExpr[fPos] && isspace((unsigned char)fExpr[fPos])) fPos++; }
+    Bool_t Accept(const char* lTok);
+    Bool_t ParseTernary();
+    Bool_t ParseBinary(Int_t lLevel);
+    Bool_t ParseUnary();
+    Bool_t ParsePrimary();
+    void   Emit(Int_t lOp, Int_t lSlot = -1, Double_t lConst = 0);
+    
+    std::vector<Instr>    fCode;
+    std::vector<Double_t> fStack;
+    const AliMultInput*   fInput;
+    //Parser state
+    const char* fExpr;
+    Int_t       fPos;
+    Int_t       fDepth;
+    Int_t       fMaxDepth;
+};
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::Accept(const char* lTok)
+{
+    SkipSpace();
+    Int_t lLen = strlen(lTok);
+    if (strncmp(fExpr + fPos, lTok, lLen) != 0) return kFALSE;
+    //Do not take '<' out of '<=', '!' out of '!=' etc
+    if (lLen == 1 && fExpr[fPos+1] == '=' && strchr("<>!=", lTok[0])) return kFALSE;
+    fPos += lLen;
+    return kTRUE;
+}
+//________________________________________________________________
+void AliMultEstimatorProgram::Emit(Int_t lOp, Int_t lSlot, Double_t lConst)
+{
+    Instr lInstr;
+    lInstr.fOp    = lOp;
+    lInstr.fSlot  = lSlot;
+    lInstr.fConst = lConst;
+    lInstr.fFloat = 0;
+    lInstr.fInt   = 0;
+    fCode.push_back(lInstr);
+    
+    //Track stack depth to size the evaluation stack once
+    if (lOp == kConst || lOp == kLoadFloat || lOp == kLoadInt) fDepth++;
+    else if (lOp == kSelect) fDepth -= 2;
+    else if (lOp != kNeg && lOp != kNot) fDepth--;
+    if (fDepth > fMaxDepth) fMaxDepth = fDepth;
+}
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::Compile(const TString& lDefinition, const AliMultInput* lInput)
+{
+    fCode.clear();
+    fExpr     = lDefinition.Data();
+    fPos      = 0;
+    fDepth    = 0;
+    fMaxDepth = 0;
+    fInput = lInput;
+    
+    Bool_t lOk = lInput && ParseTernary();
+    SkipSpace();
+    if (lOk && fExpr[fPos] != '\0') lOk = kFALSE;
+    fExpr = 0;
+    if (!lOk || fCode.empty()) {
+        fCode.clear();
+        return kFALSE;
+    }
+    fStack.assign(fMaxDepth, 0.);
+    Bind(lInput);
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::ParseTernary()
+{
+    if (!ParseBinary(0)) return kFALSE;
+    if (!Accept("?")) return kTRUE;
+    //Both branches are evaluated and selected afterwards: the
+    //definitions are free of side effects
+    if (!ParseTernary()) return kFALSE;
+    if (!Accept(":")) return kFALSE;
+    if (!ParseTernary()) return kFALSE;
+    Emit(kSelect);
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::ParseBinary(Int_t lLevel)
+{
+    //Precedence levels, lowest first (as in C/C++)
+    static const Int_t kNLevels = 6;
+    static const char* lTokens[kNLevels][4] = {
+        {"||", 0, 0, 0},
+        {"&&", 0, 0, 0},
+        {"==", "!=", 0, 0},
+        {"<=", ">=", "<", ">"},
+        {"+", "-", 0, 0},
+        {"*", "/", 0, 0}
+    };
+    static const Int_t lOps[kNLevels][4] = {
+        {kOr, -1, -1, -1},
+        {kAnd, -1, -1, -1},
+        {kEQ, kNE, -1, -1},
+        {kLE, kGE, kLT, kGT},
+        {kAdd, kSub, -1, -1},
+        {kMul, kDiv, -1, -1}
+    };
+    if (lLevel >= kNLevels) return ParseUnary();
+    if (!ParseBinary(lLevel+1)) return kFALSE;
+    for (;;) {
+        Int_t lOp = -1;
+        for (Int_t i = 0; i < 4 && lTokens[lLevel][i]; i++) {
+            if (Accept(lTokens[lLevel][i])) { lOp = lOps[lLevel][i]; break; }
+        }
+        if (lOp < 0) return kTRUE;
+        if (!ParseBinary(lLevel+1)) return kFALSE;
+        Emit(lOp);
+    }
+}
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::ParseUnary()
+{
+    if (Accept("-")) { if (!ParseUnary()) return kFALSE; Emit(kNeg); return kTRUE; }
+    if (Accept("!")) { if (!ParseUnary()) return kFALSE; Emit(kNot); return kTRUE; }
+    if (Accept("+")) return ParseUnary();
+    return ParsePrimary();
+}
+//________________________________________________________________
+Bool_t AliMultEstimatorProgram::ParsePrimary()
+{
+    SkipSpace();
+    const char* lCur = fExpr + fPos;
+    if (*lCur == '(') {
+        fPos++;
+        if (!ParseTernary()) return kFALSE;
+        return Accept(")");
+    }
+    if (isdigit((unsigned char)*lCur) || *lCur == '.') {
+        char* lEnd = 0;
+        Double_t lVal = strtod(lCur, &lEnd);
+        if (lEnd == lCur) return kFALSE;
+        fPos += lEnd - lCur;
+        Emit(kConst, -1, lVal);
+        return kTRUE;
+    }
+    if (isalpha((unsigned char)*lCur) || *lCur == '_') {
+        Int_t lLen = 0;
+        while (isalnum((unsigned char)lCur[lLen]) || lCur[lLen] == '_') lLen++;
+        TString lName(lCur, lLen);
+        fPos += lLen;
+        //Functions (and anything else TFormula may know about) are left to TFormula
+        SkipSpace();
+        if (fExpr[fPos] == '(' || (fExpr[fPos] == ':' && fExpr[fPos+1] == ':')) return kFALSE;
+        for (Int_t i = 0; i < fInput->GetNVariables(); i++) {
+            AliMultVariable* v = fInput->GetVariable(i);
+            if (!v || lName != v->GetName()) continue;
+            Emit(v->IsInteger() ? kLoadInt : kLoadFloat, i);
+            return kTRUE;
+        }
+        return kFALSE;
+    }
+    return kFALSE;
+}
+//________________________________________________________________
+void AliMultEstimatorProgram::Bind(const AliMultInput* lInput)
+{
+    //Point the load instructions at the variable storage of lInput
+    fInput = lInput;
+    for (size_t i = 0; i < fCode.size(); i++) {
+        Instr& lInstr = fCode[i];
+        if (lInstr.fOp != kLoadFloat && lInstr.fOp != kLoadInt) continue;
+        AliMultVariable* v = lInput ? lInput->GetVariable(lInstr.fSlot) : 0;
+        lInstr.fFloat = v ? &v->GetRValue() : 0;
+        lInstr.fInt   = v ? &v->GetRValueInteger() : 0;
+    }
+}
+//________________________________________________________________
+Double_t AliMultEstimatorProgram::Eval()
+{
+    Double_t* lTop = &fStack[0] - 1;
+    const Instr* lInstr = &fCode[0];
+    const Instr* lLast  = lInstr + fCode.size();
+    for (; lInstr != lLast; ++lInstr) {
+        switch (lInstr->fOp) {
+            case kConst:     *++lTop = lInstr->fConst; break;
+            case kLoadFloat: *++lTop = lInstr->fFloat ? *lInstr->fFloat : 0.; break;
+            case kLoadInt:   *++lTop = lInstr->fInt ? *lInstr->fInt : 0.; break;
+            case kNeg: *lTop = -*lTop; break;
+            case kNot: *lTop = !(*lTop); break;
+            case kMul: lTop--; lTop[0] = lTop[0] *  lTop[1]; break;
+            case kDiv: lTop--; lTop[0] = lTop[0] /  lTop[1]; break;
+            case kAdd: lTop--; lTop[0] = lTop[0] +  lTop[1]; break;
+            case kSub: lTop--; lTop[0] = lTop[0] -  lTop[1]; break;
+            case kLT:  lTop--; lTop[0] = lTop[0] <  lTop[1]; break;
+            case kGT:  lTop--; lTop[0] = lTop[0] >  lTop[1]; break;
+            case kLE:  lTop--; lTop[0] = lTop[0] <= lTop[1]; break;
+            case kGE:  lTop--; lTop[0] = lTop[0] >= lTop[1]; break;
+            case kEQ:  lTop--; lTop[0] = lTop[0] == lTop[1]; break;
+            case kNE:  lTop--; lTop[0] = lTop[0] != lTop[1]; break;
+            case kAnd: lTop--; lTop[0] = lTop[0] && lTop[1]; break;
+            case kOr:  lTop--; lTop[0] = lTop[0] || lTop[1]; break;
+            case kSelect: lTop -= 2; lTop[0] = lTop[0] ? lTop[1] : lTop[2]; break;
+        }
+    }
+    return *lTop;
+}
+
+//________________________________________________________________
+// Flat copy of a calibration histogram (estimator value -> percentile).
+// Fixed-width axes are indexed directly; for variable-width axes a
+// uniform grid over the axis range gives the starting bin, so the
+// look-up costs a few comparisons instead of TAxis::FindBin's binary
+// search. Results are identical to GetBinContent(FindBin(x)).
+class AliMultPercentileTable {
+public:
+    AliMultPercentileTable(const TH1* h);
+    Float_t Lookup(Double_t x) const;
+    
+private:
+    Int_t    fNBins;
+    Double_t fXmin;
+    Double_t fXmax;
+    Bool_t   fVariable;
+    Double_t fGridScale;
+    std::vector<Double_t> fEdges;   // nbins+1 edges (variable binning only)
+    std::vector<Int_t>    fGrid;    // first candidate bin for each grid cell
+    std::vector<Float_t>  fContent; // nbins+2 contents, incl. under/overflow
+};
+//________________________________________________________________
+AliMultPercentileTable::AliMultPercentileTable(const TH1* h)
+: fNBins(h->GetNbinsX()),
+fXmin(h->GetXaxis()->GetXmin()),
+fXmax(h->GetXaxis()->GetXmax()),
+fVariable(h->GetXaxis()->IsVariableBinSize()),
+fGridScale(0),
+fEdges(),
+fGrid(),
+fContent(fNBins+2)
+{
+    for (Int_t i = 0; i < fNBins+2; i++) fContent[i] = h->GetBinContent(i);
+    if (!fVariable) return;
+    
+    const Double_t* lBins = h->GetXaxis()->GetXbins()->GetArray();
+    fEdges.assign(lBins, lBins + fNBins + 1);
+    Int_t lNCells = 4 * fNBins;
+    fGridScale = lNCells / (fXmax - fXmin);
+    fGrid.resize(lNCells);
+    for (Int_t k = 0; k < lNCells; k++) {
+        Double_t lLow = fXmin + k / fGridScale;
+        Int_t lIdx = std::upper_bound(fEdges.begin(), fEdges.end(), lLow) - fEdges.begin() - 1;
+        fGrid[k] = TMath::Max(0, TMath::Min(lIdx, fNBins-1));
+    }
+}
+//________________________________________________________________
+Float_t AliMultPercentileTable::Lookup(Double_t x) const
+{
+    //Same bin conventions as TAxis::FindBin
+    if (x < fXmin) return fContent[0];
+    if (!(x < fXmax)) return fContent[fNBins+1];
+    if (!fVariable) return fContent[1 + Int_t(fNBins*(x-fXmin)/(fXmax-fXmin))];
+    
+    Int_t lCell = TMath::Min(Int_t((x - fXmin) * fGridScale), Int_t(fGrid.size()) - 1);
+    Int_t i = fGrid[lCell];
+    while (i > 0 && fEdges[i] > x) i--;
+    while (fEdges[i+1] <= x) i++;
+    return fContent[i+1];
+}
 
 ClassImp(AliMultEstimator);
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fProgram(0), fCalibTable(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +336,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fProgram(0), fCalibTable(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,11 +351,15 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fProgram(0),
+fCalibTable(0),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
 {
   if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+  if (e.fProgram) fProgram = new AliMultEstimatorProgram(*e.fProgram);
+  if (e.fCalibTable) fCalibTable = new AliMultPercentileTable(*e.fCalibTable);
 }
 //________________________________________________________________
 AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
@@ -68,6 +377,11 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
     
+    delete fProgram;
+    fProgram = e.fProgram ? new AliMultEstimatorProgram(*e.fProgram) : 0;
+    delete fCalibTable;
+    fCalibTable = e.fCalibTable ? new AliMultPercentileTable(*e.fCalibTable) : 0;
+    
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
     fAnchorPoint        = e.fAnchorPoint;
@@ -96,6 +410,8 @@ void AliMultEstimator::Set(const AliMultEstimator* e)
 AliMultEstimator::~AliMultEstimator(){
   // destructor
   if (fFormula) delete fFormula;   
+  delete fProgram;
+  delete fCalibTable;
 }
 //________________________________________________________________
 Float_t AliMultEstimator::GetZ() const {
@@ -109,6 +425,16 @@ Float_t AliMultEstimator::GetZ() const {
 //________________________________________________________________
 void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 {
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    delete fProgram;
+    
+    //Compile to native code bound to the variables of lInput if possible
+    fProgram = new AliMultEstimatorProgram;
+    if (fProgram->Compile(fDefinition, lInput)) return;
+    delete fProgram;
+    fProgram = 0;
+    
     TString expr = fDefinition;
     Int_t   nVar = lInput->GetNVariables();
     for (Int_t i = 0; i < nVar; i++) {
@@ -129,6 +455,10 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 //________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
+    if (fProgram) {
+        if (lInput != fProgram->GetInput()) fProgram->Bind(lInput);
+        return fValue = fProgram->Eval();
+    }
     if (!fFormula) return fValue = 0;
     for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
         AliMultVariable* v = lInput->GetVariable(i);
@@ -138,3 +468,16 @@ Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
     }
     return fValue = fFormula->Eval(0);
 }
+//________________________________________________________________
+void AliMultEstimator::SetupCalibration(const TH1* lCalib)
+{
+    delete fCalibTable;
+    fCalibTable = lCalib ? new AliMultPercentileTable(lCalib) : 0;
+}
+//________________________________________________________________
+Float_t AliMultEstimator::EvaluatePercentile()
+{
+    //Requires SetupCalibration: percentile of the current value
+    if (!fCalibTable) return fPercentile;
+    return fPercentile = fCalibTable->Lookup(fValue);
+}
@@ -3,6 +3,9 @@
 #include <TNamed.h>
 class AliMultInput;
 class TFormula;
+class TH1;
+class AliMultEstimatorProgram;
+class AliMultPercentileTable;
 
 class AliMultEstimator : public TNamed {
     
@@ -43,6 +46,12 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    Bool_t IsCompiled() const { return fProgram != 0; }
+    
+    //Flat calibration table: percentile from estimator value
+    void SetupCalibration(const TH1* lCalib);
+    Bool_t HasCalibration() const { return fCalibTable != 0; }
+    Float_t EvaluatePercentile();
     
 private:
     TString fDefinition; //How to evaluate based on AliMultVariables
@@ -52,6 +61,8 @@ private:
     Float_t fMean;   // estimator mean value
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
+    AliMultEstimatorProgram* fProgram;    //! compiled definition (fallback: fFormula)
+    AliMultPercentileTable*  fCalibTable; //! flat copy of calibration histogram
     
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
@@ -27,6 +27,7 @@ ClassImp(AliMultSelection);
 //________________________________________________________________
 AliMultSelection::AliMultSelection() :
   AliMultSelectionBase(), fNEsts(0), fEvSelCode(0), fEstimatorList(0x0),
+fEstimatorArray(), fEstimatorArrayList(0),
 fThisEvent_VtxZCut(0),
 fThisEvent_IsNotPileup(0),
 fThisEvent_IsNotPileupMV(0),
@@ -45,6 +46,7 @@ fThisEvent_HasGoodVertex2016(0)
 //________________________________________________________________
 AliMultSelection::AliMultSelection(const char * name, const char * title):
 AliMultSelectionBase(name,title), fNEsts(0), fEvSelCode(0), fEstimatorList(0x0),
+fEstimatorArray(), fEstimatorArrayList(0),
 fThisEvent_VtxZCut(0),
 fThisEvent_IsNotPileup(0),
 fThisEvent_IsNotPileupMV(0),
@@ -67,6 +69,8 @@ AliMultSelection::AliMultSelection(const AliMultSelection& lCopyMe)
 fNEsts(0),
 fEvSelCode(lCopyMe.fEvSelCode),
 fEstimatorList(0), 
+fEstimatorArray(),
+fEstimatorArrayList(0),
 fThisEvent_VtxZCut(lCopyMe.fThisEvent_VtxZCut),
 fThisEvent_IsNotPileup(lCopyMe.fThisEvent_IsNotPileup),
 fThisEvent_IsNotPileupMV(lCopyMe.fThisEvent_IsNotPileupMV),
@@ -83,12 +87,15 @@ fThisEvent_HasGoodVertex2016(lCopyMe.fThisEvent_HasGoodVertex2016)
     AliMultEstimator* est = 0;
     while ((est = static_cast<AliMultEstimator*>(next())))
         AddEstimator(new AliMultEstimator(*est));
+    BuildEstimatorArray();
 }
 //________________________________________________________________
 AliMultSelection::AliMultSelection(AliMultSelection *lCopyMe)
     : AliMultSelectionBase(*lCopyMe),
       fNEsts(0),
-      fEstimatorList(0)
+      fEstimatorList(0),
+      fEstimatorArray(),
+      fEstimatorArrayList(0)
 {
     fEvSelCode = lCopyMe->GetEvSelCode();
 
@@ -108,6 +115,7 @@ AliMultSelection::AliMultSelection(AliMultSelection *lCopyMe)
     AliMultEstimator* est = 0;
     while ((est = static_cast<AliMultEstimator*>(next())))
         AddEstimator(new AliMultEstimator(*est));
+    BuildEstimatorArray();
 }
 //________________________________________________________________
 void AliMultSelection::Set(AliMultSelection* s)
@@ -138,6 +146,7 @@ void AliMultSelection::Set(AliMultSelection* s)
         }
         ee->Set(e);
     }
+    BuildEstimatorArray();
 }
 //________________________________________________________________
 AliMultSelection::~AliMultSelection(){
@@ -154,6 +163,8 @@ void AliMultSelection::CleanUp()
 {
     if (fEstimatorList) delete fEstimatorList;
     fEstimatorList = 0;
+    fEstimatorArray.clear();
+    fEstimatorArrayList = 0;
     fNEsts = 0;
     fEvSelCode = 0;
 }
@@ -169,10 +180,13 @@ AliMultSelection& AliMultSelection::operator=(const AliMultSelection& lCopyMe)
         delete fEstimatorList;
         fEstimatorList = 0;
     }
+    fEstimatorArray.clear();
+    fEstimatorArrayList = 0;
     TIter next(lCopyMe.fEstimatorList);
     AliMultEstimator* est = 0;
     while ((est = static_cast<AliMultEstimator*>(next())))
         AddEstimator(new AliMultEstimator(*est));
+    BuildEstimatorArray();
     
     return *this;
 }
@@ -199,9 +213,25 @@ AliMultEstimator* AliMultSelection::GetEstimator (Long_t lEstIdx) const
 {
     if (!fEstimatorList) return 0;
     if (lEstIdx < 0 || lEstIdx >= fNEsts) return 0;
+    //TList::At walks the list: use the index array if still valid
+    if (fEstimatorArrayList == fEstimatorList && Long_t(fEstimatorArray.size()) == fNEsts)
+        return fEstimatorArray[lEstIdx];
     return static_cast<AliMultEstimator*>(fEstimatorList->At(lEstIdx));
 }
 //________________________________________________________________
+Int_t AliMultSelection::GetEstimatorIndex (const TString& lName) const
+{
+    if (!fEstimatorList) return -1;
+    Int_t lIdx = 0;
+    TIter next(fEstimatorList);
+    TObject* est = 0;
+    while ((est = next())) {
+        if (lName == est->GetName()) return lIdx;
+        lIdx++;
+    }
+    return -1;
+}
+//________________________________________________________________
 void AliMultSelection::PrintInfo()
 {
     cout<<"AliMultSelection Name..: "<<GetName()<<endl;
@@ -224,6 +254,18 @@ Float_t AliMultSelection::GetMultiplicityPercentile(TString lName, Bool_t lEmbed
     }
     return lReturnValue;
 }
+//________________________________________________________________
+Float_t AliMultSelection::GetMultiplicityPercentile(Int_t lEstIdx, Bool_t lEmbedEvSel) const
+//Same as above, with the handle from GetEstimatorIndex
+{
+    Float_t lReturnValue = AliMultSelectionCuts::kNoCalib;
+    AliMultEstimator *lThis = GetEstimator(Long_t(lEstIdx));
+    if( lThis ){
+        lReturnValue = lThis->GetPercentile();
+        if ( fEvSelCode > 0 && lEmbedEvSel ) lReturnValue = fEvSelCode;
+    }
+    return lReturnValue;
+}
 
 //________________________________________________________________
 Bool_t AliMultSelection::IsEventSelected()
@@ -240,10 +282,10 @@ void AliMultSelection::Evaluate( AliMultInput *lInput )
 //a set of input variables. Error handling to be done with care...
 {
     //Loop over estimators defined in the acquired list
-    AliMultEstimator* estimator = 0;
-    TIter             next(fEstimatorList);
-    while ((estimator = static_cast<AliMultEstimator*>(next())))
-        estimator->Evaluate(lInput);
+    for (Long_t iEst = 0; iEst < fNEsts; iEst++) {
+        AliMultEstimator* estimator = GetEstimator(iEst);
+        if (estimator) estimator->Evaluate(lInput);
+    }
 
 //deprecated evaluation
 #if 0
@@ -285,4 +327,18 @@ void AliMultSelection::Setup(const AliMultInput* inp)
     
     while ((estimator = static_cast<AliMultEstimator*>(next())))
         estimator->SetupFormula(inp);
+    
+    BuildEstimatorArray();
+}
+//________________________________________________________________
+void AliMultSelection::BuildEstimatorArray()
+{
+    //Index -> estimator array for O(1) GetEstimator(Long_t)
+    fEstimatorArray.clear();
+    fEstimatorArrayList = fEstimatorList;
+    if (!fEstimatorList) return;
+    TIter next(fEstimatorList);
+    AliMultEstimator* estimator = 0;
+    while ((estimator = static_cast<AliMultEstimator*>(next())))
+        fEstimatorArray.push_back(estimator);
 }
@@ -2,6 +2,7 @@
 #define AliMultSelection_H
 #include <TNamed.h>
 #include <TList.h>
+#include <vector>
 #include "AliMultSelectionBase.h"
 #include "AliMultEstimator.h"
 
@@ -27,9 +28,12 @@ public:
     AliMultEstimator* GetEstimator (const TString& lName) const;
     AliMultEstimator* GetEstimator (Long_t lEstIdx) const;
     Long_t GetNEstimators () { return fNEsts; }
+    //Integer handle for repeated look-ups (-1 if not defined)
+    Int_t GetEstimatorIndex (const TString& lName) const;
     
     //User Functions to get percentiles
     Float_t GetMultiplicityPercentile(TString lName, Bool_t lEmbedEvSel = kFALSE);
+    Float_t GetMultiplicityPercentile(Int_t lEstIdx, Bool_t lEmbedEvSel = kFALSE) const;
     Float_t GetZ(TString lName) { return GetEstimator(lName.Data())->GetZ(); }
     
     //Setter and Getter for Event Selection code
@@ -73,9 +77,13 @@ public:
     Bool_t GetThisEventHasGoodVertex2016 () { return fThisEvent_HasGoodVertex2016; }
     
 private:
+    void BuildEstimatorArray();
+
     Long_t fNEsts;    //Number of estimators
     Int_t fEvSelCode; //Event Selection code
     TList *fEstimatorList; //List containing all AliMultEstimators
+    std::vector<AliMultEstimator*> fEstimatorArray; //! direct access by index, see BuildEstimatorArray
+    TList *fEstimatorArrayList; //! list fEstimatorArray was built from
     
     //Event Characterization Variables - optional
     Bool_t fThisEvent_VtxZCut;                  //!
@@ -81,6 +81,7 @@ class AliESDAD; //AD
 
 //For MultSelection Framework
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBMultSelection.h"
 #include "AliMultEstimator.h"
 #include "AliMultVariable.h"
@@ -234,6 +235,7 @@ AliMultSelectionTask::AliMultSelectionTask()
 //------------------------------------------------
 // Tree Variables
 {
+    for( Int_t iq=0; iq<kNQAEstimators; iq++ ) fQAEstimatorIdx[iq] = -1 ;
 
 }
 
@@ -372,6 +374,7 @@ AliMultSelectionTask::AliMultSelectionTask(const char *name, TString lExtraOptio
 {
 
     for( Int_t iq=0; iq<100; iq++ ) fQuantiles[iq] = -1 ;
+    for( Int_t iq=0; iq<kNQAEstimators; iq++ ) fQAEstimatorIdx[iq] = -1 ;
 
     DefineOutput(1, TList::Class()); // Event Counter Histo
     if (fkCalibration) DefineOutput(2, TTree::Class()); // Event Tree
@@ -1552,42 +1555,33 @@ void AliMultSelectionTask::UserExec(Option_t *)
         //Just in case you want to store it for debugging
         fEvSelCode = lSelection->GetEvSelCode();
 
-        //Determine Quantiles from calibration histogram
-        TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
+        //Determine Quantiles from calibration tables (built from hCalib_* in SetupRun)
         Float_t lThisQuantile = -1;
         for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
-            //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
-            lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
-            if ( ! lThisCalibHisto ) {
+            AliMultEstimator* lThisEstimator = lSelection->GetEstimator(iEst);
+            if ( ! lThisEstimator->HasCalibration() ) {
                 lThisQuantile = AliMultSelectionCuts::kNoCalib;
-                if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisEstimator->SetPercentile(lThisQuantile);
             } else {
-                lThisQuantile = lThisCalibHisto->GetBinContent( lThisCalibHisto->FindBin( lSelection->GetEstimator(iEst)->GetValue() ));
-                if( iEst < fNDebug ) {
-                    fQuantiles[iEst] = lThisQuantile; //Debug, please
-                }
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisQuantile = lThisEstimator->EvaluatePercentile();
             }
+            if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile; //Debug, please
         }
 
         //=============================================================================
         // Fill in quick debug information (available in any execution)
 
-        Float_t lV0M = lSelection->GetMultiplicityPercentile("V0M");
-        Float_t lV0A = lSelection->GetMultiplicityPercentile("V0A");
-        Float_t lV0C = lSelection->GetMultiplicityPercentile("V0C");
-        Float_t lCL0 = lSelection->GetMultiplicityPercentile("CL0");
-        Float_t lCL1 = lSelection->GetMultiplicityPercentile("CL1");
-        Float_t lSPDClusters  = lSelection->GetMultiplicityPercentile("SPDClusters" );
-        Float_t lSPDTracklets = lSelection->GetMultiplicityPercentile("SPDTracklets");
-        Float_t lZNA = lSelection->GetMultiplicityPercentile("ZNA");
-        Float_t lZNC = lSelection->GetMultiplicityPercentile("ZNC");
-        Float_t lZNApp = lSelection->GetMultiplicityPercentile("ZNApp");
-        Float_t lZNCpp = lSelection->GetMultiplicityPercentile("ZNCpp");
+        Float_t lV0M = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0M]);
+        Float_t lV0A = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0A]);
+        Float_t lV0C = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0C]);
+        Float_t lCL0 = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQACL0]);
+        Float_t lCL1 = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQACL1]);
+        Float_t lSPDClusters  = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQASPDClusters]);
+        Float_t lSPDTracklets = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQASPDTracklets]);
+        Float_t lZNA = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNA]);
+        Float_t lZNC = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNC]);
+        Float_t lZNApp = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNApp]);
+        Float_t lZNCpp = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNCpp]);
         Int_t ltracklets = fnTracklets->GetValueInteger();
 
         fHistQA_V0M -> Fill( lV0M );
@@ -1606,17 +1600,17 @@ void AliMultSelectionTask::UserExec(Option_t *)
         fHistQA_TrackletsVsCL0 -> Fill( lCL0, ltracklets );
         fHistQA_TrackletsVsCL1 -> Fill( lCL1, ltracklets );
 
-        lV0M = lSelection->GetMultiplicityPercentile("V0M",kTRUE);
-        lV0A = lSelection->GetMultiplicityPercentile("V0A",kTRUE);
-        lV0C = lSelection->GetMultiplicityPercentile("V0C",kTRUE);
-        lCL0 = lSelection->GetMultiplicityPercentile("CL0",kTRUE);
-        lCL1 = lSelection->GetMultiplicityPercentile("CL1",kTRUE);
-        lSPDClusters  = lSelection->GetMultiplicityPercentile("SPDClusters" , kTRUE);
-        lSPDTracklets = lSelection->GetMultiplicityPercentile("SPDTracklets", kTRUE);
-        lZNA = lSelection->GetMultiplicityPercentile("ZNA",kTRUE);
-        lZNC = lSelection->GetMultiplicityPercentile("ZNC",kTRUE);
-        lZNApp = lSelection->GetMultiplicityPercentile("ZNApp",kTRUE);
-        lZNCpp = lSelection->GetMultiplicityPercentile("ZNCpp",kTRUE);
+        lV0M = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0M],kTRUE);
+        lV0A = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0A],kTRUE);
+        lV0C = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAV0C],kTRUE);
+        lCL0 = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQACL0],kTRUE);
+        lCL1 = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQACL1],kTRUE);
+        lSPDClusters  = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQASPDClusters], kTRUE);
+        lSPDTracklets = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQASPDTracklets], kTRUE);
+        lZNA = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNA],kTRUE);
+        lZNC = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNC],kTRUE);
+        lZNApp = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNApp],kTRUE);
+        lZNCpp = lSelection->GetMultiplicityPercentile(fQAEstimatorIdx[kQAZNCpp],kTRUE);
         
         fHistQASelected_V0M -> Fill( lV0M );
         fHistQASelected_V0A -> Fill( lV0A );
@@ -1769,6 +1763,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
     else
         fCurrentRun = esd->GetRunNumber();
     AliInfoF("Detected run number: %i",fCurrentRun);
+    for( Int_t iq=0; iq<kNQAEstimators; iq++ ) fQAEstimatorIdx[iq] = -1 ;
 
     TString lPathInput = CurrentFileName();
     
@@ -1880,20 +1875,17 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         lOADBref = Form("BYPASS: %s", fAlternateOADBFullManualBypass.Data());
     }
 
-    //Open File without calling InitFromFile, don't load it all!
-    TFile * foadb = TFile::Open(fileName);
-    if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileName.Data()));
+    //Container is read only once per job and shared with the other tasks: never modify it!
+    AliOADBContainer * MultContainer = AliOADBCache::Instance()->GetContainer(fileName, "MultSel");
+    if(!MultContainer) AliFatal(Form("OADB file %s does not exist or does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
 
     //Managed to open, save name of opened OADB file
     lHistTitle.Append(Form(", OADB: %s",lOADBref.Data()));
     
-    AliOADBContainer * MultContainer = (AliOADBContainer*) foadb->Get("MultSel");
-    if(!MultContainer) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
-    
     //Get Object for this run!
     TObject *lObjAcquired = 0x0;
 
-    lObjAcquired = MultContainer->GetObject(fCurrentRun, "Default");
+    lObjAcquired = AliOADBCache::Instance()->GetObject(fileName, "MultSel", fCurrentRun, "Default");
 
     if (!lObjAcquired) {
         if ( fkUseDefaultCalib ) {
@@ -1954,20 +1946,13 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         //Managed to open, save name of opened OADB file
         lHistTitle.Append(Form(", muOADB: %s",lmuOADBref.Data()));
         
-        //Open fileNameAlter
-        TFile * foadbAlter = 0x0;
-        foadbAlter = TFile::Open(fileNameAlter);
-        
-        //Check existence, please
-        if(!foadbAlter) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        if(!foadbAlter->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        
-        AliOADBContainer * MultContainerAlter = (AliOADBContainer*) foadbAlter->Get("MultSel");
-        if(!MultContainerAlter) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
+        //Get (shared) container from fileNameAlter
+        AliOADBContainer * MultContainerAlter = AliOADBCache::Instance()->GetContainer(fileNameAlter, "MultSel");
+        if(!MultContainerAlter) AliFatal(Form("OADB file %s does not exist or does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
 
         //Get Object for this run
         TObject *lObjAcquiredAlter = 0x0;
-        lObjAcquiredAlter = MultContainerAlter->GetObject(fCurrentRun, "Default");
+        lObjAcquiredAlter = AliOADBCache::Instance()->GetObject(fileNameAlter, "MultSel", fCurrentRun, "Default");
         if (!lObjAcquiredAlter) {
             if ( fkUseDefaultMCCalib ) {
                 AliWarning("======================================================================");
@@ -2016,6 +2001,14 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         sel->SetName(fStoredObjectName.Data());
         //Optimize evaluation
         sel->Setup(fInput);
+        //Flat percentile tables and estimator handles for the event loop
+        for(Long_t iEst=0; iEst<sel->GetNEstimators(); iEst++) {
+            AliMultEstimator* lEst = sel->GetEstimator(iEst);
+            lEst->SetupCalibration(fOadbMultSelection->GetCalibHisto(Form("hCalib_%s",lEst->GetName())));
+        }
+        const char* lQANames[kNQAEstimators] = { "V0M", "V0A", "V0C", "CL0", "CL1", "SPDClusters", "SPDTracklets",
+            "ZNA", "ZNC", "ZNApp", "ZNCpp" };
+        for( Int_t iq=0; iq<kNQAEstimators; iq++ ) fQAEstimatorIdx[iq] = sel->GetEstimatorIndex(lQANames[iq]);
     }
 
     AliInfo("---> Successfully set up! Inspect MultSelection:");
@@ -334,6 +334,11 @@ private:
     //AliMultSelection Framework
     AliOADBMultSelection *fOadbMultSelection;
     AliMultInput         *fInput;
+    
+    //Estimator handles for the QA histograms, resolved in SetupRun
+    enum { kQAV0M, kQAV0A, kQAV0C, kQACL0, kQACL1, kQASPDClusters, kQASPDTracklets,
+        kQAZNA, kQAZNC, kQAZNApp, kQAZNCpp, kNQAEstimators };
+    Int_t fQAEstimatorIdx[kNQAEstimators]; //!
 
     AliMultSelectionTask(const AliMultSelectionTask&);            // not implemented
     AliMultSelectionTask& operator=(const AliMultSelectionTask&); // not implemented
@@ -6,6 +6,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
+#pragma link C++ class AliOADBCache+;
 #pragma link C++ class AliOADBCentrality+;
 #pragma link C++ class AliOADBPhysicsSelection+;
 #pragma link C++ class AliOADBFillingScheme+;
@@ -24,6 +25,7 @@
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
 #pragma link C++ class AliEventCutsContainer+;
+#pragma link C++ class AliEventQuantityCache+;
 
 #pragma link C++ class AliMultVariable+;
 #pragma link C++ class AliMultInput+;
@@ -74,7 +74,8 @@ AliGenEMCocktailV2::AliGenEMCocktailV2():AliGenCocktail(),
   fDynPtRange(kFALSE),
   fForceConv(kFALSE),
   fSelectedParticles(kGenHadrons),
-  fUseFixedEP(kFALSE)  
+  fUseFixedEP(kFALSE),
+  fPtTableNodes(0)
 {
   // Constructor
 }
@@ -801,6 +802,10 @@ void AliGenEMCocktailV2::AddSource2Generator(Char_t* nameSource,
   genSource->SetWeighting(fWeightingMode);
   genSource->SetForceGammaConversion(fForceConv);
   if (!TVirtualMC::GetMC()) genSource->SetDecayer(fDecayer);
+  // tabulate the pt parametrization over the generated range before the
+  // generator sets up its pt function (direct photons are not tabulated)
+  if (fPtTableNodes > 0)
+    AliGenEMlibV2::TabulatePtParametrization(genSource->GetParam(), fPtMin, maxPtStretchFactor*fPtMax, fPtTableNodes);
   genSource->Init();
 
   AddGenerator(genSource,nameSource,1.); // Adding Generator
@@ -72,6 +72,7 @@ public:
   static  void    SetMtScalingFactors();
   static  Bool_t  SetPtYDistributions();
   void    SetFixedEventPlane(Bool_t toFix=kTRUE){fUseFixedEP=toFix;} //Default is random
+  void    SetPtTableNodes(Int_t nNodes)                               { fPtTableNodes = nNodes;           } // 0: evaluate the pt parametrizations directly
  
   // getters
   Bool_t    GetDynamicalPtRangeOption()       const                   { return fDynPtRange;               }
@@ -85,6 +86,7 @@ public:
   TString   GetParametrizationFileDirectory() const                   { return fParametrizationDir;       }
   TString   GetParametrizationFileV2Directory() const                 { return fV2ParametrizationDir;     }
   Int_t     GetNumberOfParticles()            const                   { return fNPart;                    }
+  Int_t     GetPtTableNodes()                 const                   { return fPtTableNodes;             }
   Double_t  GetMaxPtStretchFactor(Int_t pdgCode);
   Double_t  GetYWeight(Int_t pdgCode, TParticle* part);
   void      GetPtRange(Double_t &ptMin, Double_t &ptMax);
@@ -140,8 +142,9 @@ private:
   Bool_t        fForceConv;                             // select whether you want to force all gammas to convert imidediately
   UInt_t        fSelectedParticles;                     // which particles to simulate, allows to switch on and off 32 different particles
   Bool_t        fUseFixedEP;                            // use random Event Plane or fixed Psi=0
+  Int_t         fPtTableNodes;                          // number of nodes of the tabulated pt parametrizations, 0: no tables
   
-  ClassDef(AliGenEMCocktailV2,9)                        // cocktail for EM physics
+  ClassDef(AliGenEMCocktailV2,10)                        // cocktail for EM physics
 };
 
 #endif
@@ -49,6 +49,9 @@ Int_t AliGenEMlibV2::fgSelectedCentrality       = AliGenEMlibV2::kpp;
 Int_t AliGenEMlibV2::fgSelectedV2Systematic     = AliGenEMlibV2::kNoV2Sys;
 TF1*  AliGenEMlibV2::fV2Parametrization[]={0x0} ;
 Int_t AliGenEMlibV2::fV2RefParameterization[] = {0} ;
+Double_t AliGenEMlibV2::fPtTableMin[]           = {0.};
+Double_t AliGenEMlibV2::fPtTableStep[]          = {0.};
+std::vector<Double_t> AliGenEMlibV2::fPtTableDensity[26];
 
 Double_t AliGenEMlibV2::CrossOverLc(double a, double b, double x){
   if(x<b-a/2) return 1.0;
@@ -271,7 +274,7 @@ Int_t AliGenEMlibV2::IpPizero(TRandom *)
 Double_t AliGenEMlibV2::PtPizero( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kPizero]->Eval(pt);
+  return EvalPt(kPizero, pt);
 }
 
 Double_t AliGenEMlibV2::YPizero( const Double_t *py, const Double_t */*dummy*/ )
@@ -349,7 +352,7 @@ Int_t AliGenEMlibV2::IpEta(TRandom *)
 Double_t AliGenEMlibV2::PtEta( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kEta]->Eval(pt);
+  return EvalPt(kEta, pt);
 }
 
 Double_t AliGenEMlibV2::YEta( const Double_t *py, const Double_t */*dummy*/ )
@@ -382,7 +385,7 @@ Int_t AliGenEMlibV2::IpRho0(TRandom *)
 Double_t AliGenEMlibV2::PtRho0( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kRho0]->Eval(pt);
+  return EvalPt(kRho0, pt);
 }
 
 Double_t AliGenEMlibV2::YRho0( const Double_t *py, const Double_t */*dummy*/ )
@@ -415,7 +418,7 @@ Int_t AliGenEMlibV2::IpOmega(TRandom *)
 Double_t AliGenEMlibV2::PtOmega( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kOmega]->Eval(pt);
+  return EvalPt(kOmega, pt);
 }
 
 Double_t AliGenEMlibV2::YOmega( const Double_t *py, const Double_t */*dummy*/ )
@@ -448,7 +451,7 @@ Int_t AliGenEMlibV2::IpEtaprime(TRandom *)
 Double_t AliGenEMlibV2::PtEtaprime( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kEtaprime]->Eval(pt);
+  return EvalPt(kEtaprime, pt);
 }
 
 Double_t AliGenEMlibV2::YEtaprime( const Double_t *py, const Double_t */*dummy*/ )
@@ -482,7 +485,7 @@ Int_t AliGenEMlibV2::IpPhi(TRandom *)
 Double_t AliGenEMlibV2::PtPhi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kPhi]->Eval(pt);
+  return EvalPt(kPhi, pt);
 }
 
 Double_t AliGenEMlibV2::YPhi( const Double_t *py, const Double_t */*dummy*/ )
@@ -515,7 +518,7 @@ Int_t AliGenEMlibV2::IpJpsi(TRandom *)
 Double_t AliGenEMlibV2::PtJpsi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kJpsi]->Eval(pt);
+  return EvalPt(kJpsi, pt);
 }
 
 Double_t AliGenEMlibV2::YJpsi( const Double_t *py, const Double_t */*dummy*/ )
@@ -558,7 +561,7 @@ Int_t AliGenEMlibV2::IpSigma0(TRandom *)
 Double_t AliGenEMlibV2::PtSigma0( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kSigma0]->Eval(pt);
+  return EvalPt(kSigma0, pt);
 }
 
 Double_t AliGenEMlibV2::YSigma0( const Double_t *py, const Double_t */*dummy*/ )
@@ -592,7 +595,7 @@ Int_t AliGenEMlibV2::IpK0short(TRandom *)
 Double_t AliGenEMlibV2::PtK0short( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kK0s]->Eval(pt);
+  return EvalPt(kK0s, pt);
 }
 
 Double_t AliGenEMlibV2::YK0short( const Double_t *py, const Double_t */*dummy*/ )
@@ -626,7 +629,7 @@ Int_t AliGenEMlibV2::IpK0long(TRandom *)
 Double_t AliGenEMlibV2::PtK0long( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kK0l]->Eval(pt);
+  return EvalPt(kK0l, pt);
 }
 
 Double_t AliGenEMlibV2::YK0long( const Double_t *py, const Double_t */*dummy*/ )
@@ -660,7 +663,7 @@ Int_t AliGenEMlibV2::IpLambda(TRandom *)
 Double_t AliGenEMlibV2::PtLambda( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kLambda]->Eval(pt);
+  return EvalPt(kLambda, pt);
 }
 
 Double_t AliGenEMlibV2::YLambda( const Double_t *py, const Double_t */*dummy*/ )
@@ -694,7 +697,7 @@ Int_t AliGenEMlibV2::IpDeltaPlPl(TRandom *)
 Double_t AliGenEMlibV2::PtDeltaPlPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kDeltaPlPl]->Eval(pt);
+  return EvalPt(kDeltaPlPl, pt);
 }
 
 Double_t AliGenEMlibV2::YDeltaPlPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -728,7 +731,7 @@ Int_t AliGenEMlibV2::IpDeltaPl(TRandom *)
 Double_t AliGenEMlibV2::PtDeltaPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kDeltaPl]->Eval(pt);
+  return EvalPt(kDeltaPl, pt);
 }
 
 Double_t AliGenEMlibV2::YDeltaPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -762,7 +765,7 @@ Int_t AliGenEMlibV2::IpDeltaMi(TRandom *)
 Double_t AliGenEMlibV2::PtDeltaMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kDeltaMi]->Eval(pt);
+  return EvalPt(kDeltaMi, pt);
 }
 
 Double_t AliGenEMlibV2::YDeltaMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -796,7 +799,7 @@ Int_t AliGenEMlibV2::IpDeltaZero(TRandom *)
 Double_t AliGenEMlibV2::PtDeltaZero( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kDeltaZero]->Eval(pt);
+  return EvalPt(kDeltaZero, pt);
 }
 
 Double_t AliGenEMlibV2::YDeltaZero( const Double_t *py, const Double_t */*dummy*/ )
@@ -830,7 +833,7 @@ Int_t AliGenEMlibV2::IpRhoPl(TRandom *)
 Double_t AliGenEMlibV2::PtRhoPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kRhoPl]->Eval(pt);
+  return EvalPt(kRhoPl, pt);
 }
 
 Double_t AliGenEMlibV2::YRhoPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -864,7 +867,7 @@ Int_t AliGenEMlibV2::IpRhoMi(TRandom *)
 Double_t AliGenEMlibV2::PtRhoMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kRhoMi]->Eval(pt);
+  return EvalPt(kRhoMi, pt);
 }
 
 Double_t AliGenEMlibV2::YRhoMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -898,7 +901,7 @@ Int_t AliGenEMlibV2::IpK0star(TRandom *)
 Double_t AliGenEMlibV2::PtK0star( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kK0star]->Eval(pt);
+  return EvalPt(kK0star, pt);
 }
 
 Double_t AliGenEMlibV2::YK0star( const Double_t *py, const Double_t */*dummy*/ )
@@ -932,7 +935,7 @@ Int_t AliGenEMlibV2::IpKPl(TRandom *)
 Double_t AliGenEMlibV2::PtKPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kKPl]->Eval(pt);
+  return EvalPt(kKPl, pt);
 }
 
 Double_t AliGenEMlibV2::YKPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -965,7 +968,7 @@ Int_t AliGenEMlibV2::IpKMi(TRandom *)
 Double_t AliGenEMlibV2::PtKMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kKMi]->Eval(pt);
+  return EvalPt(kKMi, pt);
 }
 
 Double_t AliGenEMlibV2::YKMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -997,7 +1000,7 @@ Int_t AliGenEMlibV2::IpOmegaPl(TRandom *)
 Double_t AliGenEMlibV2::PtOmegaPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kOmegaPl]->Eval(pt);
+  return EvalPt(kOmegaPl, pt);
 }
 
 Double_t AliGenEMlibV2::YOmegaPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -1025,7 +1028,7 @@ Int_t AliGenEMlibV2::IpOmegaMi(TRandom *)
 Double_t AliGenEMlibV2::PtOmegaMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kOmegaMi]->Eval(pt);
+  return EvalPt(kOmegaMi, pt);
 }
 
 Double_t AliGenEMlibV2::YOmegaMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -1053,7 +1056,7 @@ Int_t AliGenEMlibV2::IpXiPl(TRandom *)
 Double_t AliGenEMlibV2::PtXiPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kXiPl]->Eval(pt);
+  return EvalPt(kXiPl, pt);
 }
 
 Double_t AliGenEMlibV2::YXiPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -1081,7 +1084,7 @@ Int_t AliGenEMlibV2::IpXiMi(TRandom *)
 Double_t AliGenEMlibV2::PtXiMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kXiMi]->Eval(pt);
+  return EvalPt(kXiMi, pt);
 }
 
 Double_t AliGenEMlibV2::YXiMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -1109,7 +1112,7 @@ Int_t AliGenEMlibV2::IpSigmaPl(TRandom *)
 Double_t AliGenEMlibV2::PtSigmaPl( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kSigmaPl]->Eval(pt);
+  return EvalPt(kSigmaPl, pt);
 }
 
 Double_t AliGenEMlibV2::YSigmaPl( const Double_t *py, const Double_t */*dummy*/ )
@@ -1137,7 +1140,7 @@ Int_t AliGenEMlibV2::IpSigmaMi(TRandom *)
 Double_t AliGenEMlibV2::PtSigmaMi( const Double_t *px, const Double_t */*dummy*/ )
 {
   const double &pt=px[0];
-  return fPtParametrization[kSigmaMi]->Eval(pt);
+  return EvalPt(kSigmaMi, pt);
 }
 
 Double_t AliGenEMlibV2::YSigmaMi( const Double_t *py, const Double_t */*dummy*/ )
@@ -1327,6 +1330,9 @@ Double_t AliGenEMlibV2::GetTAA(Int_t cent){
 //--------------------------------------------------------------------------
 Bool_t AliGenEMlibV2::SetPtParametrizations(TString fileName, TString dirName) {
 
+  // tables of previous parametrizations are no longer valid
+  ClearPtTables();
+
   // open parametrizations file
   TFile* fParametrizationFile = TFile::Open(fileName.Data());
   if (!fParametrizationFile) AliFatalClass(Form("File %s not found",fileName.Data()));
@@ -1613,6 +1619,65 @@ TH2F* AliGenEMlibV2::GetPtYDistribution(Int_t np) {
 }
 
 
+//--------------------------------------------------------------------------
+//
+//                     tabulated pt parametrizations
+//
+//--------------------------------------------------------------------------
+Bool_t AliGenEMlibV2::TabulatePtParametrization(Int_t np, Double_t ptMin, Double_t ptMax, Int_t nNodes) {
+
+  // tabulate the pt parametrization of particle np on nNodes equidistant
+  // nodes in [ptMin,ptMax]. Inside the table EvalPt interpolates linearly
+  // instead of evaluating the TF1.
+  if (np<0 || np>=26 || !fPtParametrization[np]) return kFALSE;
+  if (nNodes<2 || ptMax<=ptMin) {
+    AliWarningClass(Form("Invalid pt table (%d nodes in [%f,%f]) for particle %d", nNodes, ptMin, ptMax, np));
+    return kFALSE;
+  }
+
+  fPtTableDensity[np].clear();
+
+  Double_t step = (ptMax-ptMin)/(nNodes-1);
+  std::vector<Double_t> density(nNodes);
+  Double_t integral = 0.;
+  for (Int_t i=0; i<nNodes; i++) {
+    density[i] = fPtParametrization[np]->Eval(ptMin+i*step);
+    if (i) integral += 0.5*step*(density[i-1]+density[i]);
+  }
+  if (!(integral>0.)) {
+    AliWarningClass(Form("Pt parametrization %s has no positive integral in [%f,%f], not tabulated", fPtParametrization[np]->GetName(), ptMin, ptMax));
+    return kFALSE;
+  }
+
+  fPtTableMin[np]  = ptMin;
+  fPtTableStep[np] = step;
+  fPtTableDensity[np].swap(density);
+  return kTRUE;
+}
+
+//--------------------------------------------------------------------------
+void AliGenEMlibV2::ClearPtTables() {
+  for (Int_t i=0; i<26; i++) fPtTableDensity[i].clear();
+}
+
+//--------------------------------------------------------------------------
+Double_t AliGenEMlibV2::EvalPt(Int_t np, Double_t pt) {
+
+  // pt parametrization of particle np, from the table if pt is inside it
+  const std::vector<Double_t> &density = fPtTableDensity[np];
+  Int_t nNodes = density.size();
+  if (nNodes>1) {
+    Double_t x = (pt-fPtTableMin[np])/fPtTableStep[np];
+    if (x>=0. && x<=nNodes-1) {
+      Int_t i = (Int_t)x;
+      if (i>=nNodes-1) return density[nNodes-1];
+      return density[i]+(x-i)*(density[i+1]-density[i]);
+    }
+  }
+  return fPtParametrization[np]->Eval(pt);
+}
+
+
 //==========================================================================
 //
 //                     Set Getters
@@ -20,6 +20,7 @@
 #include "TF1.h"
 #include "TH1D.h"
 #include "TH2F.h"
+#include <vector>
 
 class iostream;
 class TRandom;
@@ -69,6 +70,12 @@ public:
   static TH1D*  GetMtScalingFactors();
   static TH2F*  GetPtYDistribution(Int_t np);
 
+  // tabulated pt parametrizations
+  static Bool_t   TabulatePtParametrization(Int_t np, Double_t ptMin, Double_t ptMax, Int_t nNodes=10000);
+  static void     ClearPtTables();
+  static Bool_t   HasPtTable(Int_t np) { return np>=0 && np<26 && fPtTableDensity[np].size()>1; }
+  static Double_t EvalPt(Int_t np, Double_t pt);
+
   static Int_t fgSelectedCollisionsSystem;                                                      // selected pT parameter
   static Int_t fgSelectedCentrality;                                                            // selected Centrality
   static Int_t fgSelectedV2Systematic;                                                          // selected v2 systematics, usefully values: -1,0,1
@@ -273,6 +280,9 @@ private:
   static TH2F*    fPtYDistribution[26];       // pt-y distributions
   static TF1*     fV2Parametrization[27];     // pt paramtrizations
   static Int_t    fV2RefParameterization[27]; // ID of a hadron used for parameterization of V2 for Et scaling
+  static Double_t fPtTableMin[26];            // lower edge of the pt tables
+  static Double_t fPtTableStep[26];           // node spacing of the pt tables
+  static std::vector<Double_t> fPtTableDensity[26]; // pt parametrizations at the table nodes
 
   ClassDef(AliGenEMlibV2,7);
 };
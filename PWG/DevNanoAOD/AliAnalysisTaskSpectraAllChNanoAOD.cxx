@@ -33,6 +33,8 @@
 #include "AliVParticle.h"
 #include "AliAODEvent.h"
 #include "AliAODInputHandler.h"
+#include "AliAnalysisManager.h"
+#include "TList.h"
 #include "AliAnalysisTaskSpectraAllChNanoAOD.h"
 #include "AliAnalysisTaskESDfilter.h"
 #include "AliAnalysisDataContainer.h"
@@ -49,6 +51,7 @@
 #include <iostream>
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
 
 using namespace AliHelperPIDNameSpace;
 using namespace std;
@@ -162,6 +165,25 @@ void AliAnalysisTaskSpectraAllChNanoAOD::UserCreateOutputObjects()
   PostData(4, fHelperPID);
 }
 
+//________________________________________________________________________
+Bool_t AliAnalysisTaskSpectraAllChNanoAOD::UserNotify()
+{
+  // The track mapping of a nanoAOD is stored in the tree UserInfo and
+  // loaded by the input handler: resolve the track offsets once per file
+  AliInputEventHandler * handler = (AliInputEventHandler*) AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler();
+  TList * userInfo = handler ? handler->GetUserInfo() : 0;
+  if (!userInfo) return kTRUE;
+  TIter next(userInfo);
+  TObject * obj = 0;
+  while ((obj = next())) {
+    if (obj->InheritsFrom(AliNanoAODTrackMapping::Class())) {
+      AliNanoAODTrack::UpdateOffsets();
+      break;
+    }
+  }
+  return kTRUE;
+}
+
 //________________________________________________________________________
 
 void AliAnalysisTaskSpectraAllChNanoAOD::UserExec(Option_t *)
@@ -60,6 +60,7 @@ class AliAnalysisTaskSpectraAllChNanoAOD : public AliAnalysisTaskSE
   
   virtual void   UserCreateOutputObjects();
   virtual void   UserExec(Option_t *option);
+  virtual Bool_t UserNotify();
   virtual void   Terminate(Option_t *);
   
   AliSpectraAODTrackCuts      * GetTrackCuts()         {  return fTrackCuts; }
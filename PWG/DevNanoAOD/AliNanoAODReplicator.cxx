@@ -438,6 +438,10 @@ TList* AliNanoAODReplicator::GetList() const
       fTracks = new TClonesArray("AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fTracks);
+      // the layout of the tracks is fixed by the var list for the whole job:
+      // resolve the offsets once, the tracks fill their storage through them
+      AliNanoAODTrackMapping::GetInstance(fVarList);
+      AliNanoAODTrack::UpdateOffsets();
 
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -521,6 +525,9 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
   if(entries<=0) return;
 
+  // selected tracks are stored back to back, grow the array at most once per event
+  if (fTracks->GetSize() < entries) fTracks->Expand(entries);
+
   for(Int_t j=0; j<entries; j++){
     AliVTrack *track = 0x0;
     if (particleArray) track = (AliVTrack*)particleArray->At(j);
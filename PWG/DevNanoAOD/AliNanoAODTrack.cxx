@@ -21,6 +21,7 @@
 //-------------------------------------------------------------------------
 
 #include <TVector3.h>
+#include <TClonesArray.h>
 #include "AliLog.h"
 #include "AliExternalTrackParam.h"
 #include "AliVVertex.h"
@@ -33,6 +34,8 @@
 
 ClassImp(AliNanoAODTrack)
 
+AliNanoAODTrackOffsets AliNanoAODTrack::fgOffsets;
+
 
 //______________________________________________________________________________
 AliNanoAODTrack::AliNanoAODTrack() : 
@@ -69,61 +72,57 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
 
   Double_t position[3];
   Bool_t isPosAvailable = !(aodTrack->GetXYZ(position)); // GetXYZ() returns kTRUE, if it's DCA information
-  AliNanoAODTrackMapping::GetInstance(vars);
+  const AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance(vars);
+  const AliNanoAODTrackOffsets & o = (mapping == fgOffsets.fMapping) ? fgOffsets : UpdateOffsets();
 
   // Create internal structure
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-
-  for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
-    TString varString = AliNanoAODTrackMapping::GetInstance()->GetVarName(index);
-
-    if     (varString == "pt"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()               , aodTrack->Pt()                      );
-    else if(varString == "phi"                    ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()              , aodTrack->Phi()                     );
-    else if(varString == "theta"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()            , aodTrack->Theta()                   );
-    else if(varString == "chi2perNDF"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()       , aodTrack->Chi2perNDF()              );  
-    else if(varString == "posx" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()             , position[0]                         );
-    else if(varString == "posy" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()             , position[1]                         );
-    else if(varString == "posz" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()             , position[2]                         );
-    else if(varString == "posDCAx"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()          , aodTrack->XAtDCA()                  );
-    else if(varString == "posDCAy"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()          , aodTrack->YAtDCA()                  );
-    else if(varString == "pDCAx"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()            , aodTrack->PxAtDCA()                 );
-    else if(varString == "pDCAy"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()            , aodTrack->PyAtDCA()                 );
-    else if(varString == "pDCAz"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()            , aodTrack->PzAtDCA()                 );
-    else if(varString == "RAtAbsorberEnd"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()   , aodTrack->GetRAtAbsorberEnd()       );
-    else if(varString == "TPCncls"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()          , aodTrack->GetTPCNcls()              );
-    else if(varString == "id"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->Getid()               , aodTrack->GetID()                   );
-    else if(varString == "TPCnclsF"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()         , aodTrack->GetTPCNclsF()             );
-    else if(varString == "TPCNCrossedRows"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()  , aodTrack->GetTPCNCrossedRows()      );
-    else if(varString == "TrackPhiOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()  , aodTrack->GetTrackPhiOnEMCal()      );
-    else if(varString == "TrackEtaOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()  , aodTrack->GetTrackEtaOnEMCal()      );
-    else if(varString == "TrackPtOnEMCal"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()   , aodTrack->GetTrackPtOnEMCal()       );
-    else if(varString == "ITSsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()        , aodTrack->GetITSsignal()            );
-    else if(varString == "TPCsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()        , aodTrack->GetTPCsignal()            );
-    else if(varString == "TPCsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()   , aodTrack->GetTPCsignalTunedOnData() );
-    else if(varString == "TPCsignalN"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()       , aodTrack->GetTPCsignalN()           );
-    else if(varString == "TPCmomentum"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()      , aodTrack->GetTPCmomentum()          );
-    else if(varString == "TPCTgl"                 ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()           , aodTrack->GetTPCTgl()               );
-    else if(varString == "TOFsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()        , aodTrack->GetTOFsignal()            );
-    else if(varString == "integratedLength"       ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetintegratedLenght() , aodTrack->GetIntegratedLength()     );
-    else if(varString == "TOFsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()   , aodTrack->GetTOFsignalTunedOnData() );
-    else if(varString == "HMPIDsignal"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()      , aodTrack->GetHMPIDsignal()          );
-    else if(varString == "HMPIDoccupancy"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()   , aodTrack->GetHMPIDoccupancy()       );
-    else if(varString == "TRDsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()        , aodTrack->GetTRDsignal()            );
-    else if(varString == "TRDChi2"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()          , aodTrack->GetTRDchi2()              );
-    else if(varString == "TRDnSlices"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()       , aodTrack->GetNumberOfTRDslices()    );  
-    else if(varString == "IsMuonTrack"             ) {
-        if (aodTrack->IsMuonTrack()) SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 1.);
-        else SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 0.);
-    }
-    else if(varString == "TPCnclsS"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS()         , aodTrack->GetTPCnclsS()             );
-    else if(varString == "FilterMap"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()        , aodTrack->GetFilterMap()            );
-    else if(varString == "covmat0"                 ) {
-        Double_t covMatrix[21];
-        aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
-        for(Int_t i=0;i<21;i++){
-            SetVar(AliNanoAODTrackMapping::GetInstance()->GetCovMat(i)       , covMatrix[i]                        );
-        }
-        index+=20;
+  AllocateInternalStorage(o.fSize);
+
+  // Only the variables present in the mapping have an offset >= 0
+  if (o.fPt               >= 0) SetVar(o.fPt               , aodTrack->Pt()                      );
+  if (o.fPhi              >= 0) SetVar(o.fPhi              , aodTrack->Phi()                     );
+  if (o.fTheta            >= 0) SetVar(o.fTheta            , aodTrack->Theta()                   );
+  if (o.fChi2PerNDF       >= 0) SetVar(o.fChi2PerNDF       , aodTrack->Chi2perNDF()              );
+  if (isPosAvailable) {
+    if (o.fPosX           >= 0) SetVar(o.fPosX             , position[0]                         );
+    if (o.fPosY           >= 0) SetVar(o.fPosY             , position[1]                         );
+    if (o.fPosZ           >= 0) SetVar(o.fPosZ             , position[2]                         );
+  }
+  if (o.fPosDCAx          >= 0) SetVar(o.fPosDCAx          , aodTrack->XAtDCA()                  );
+  if (o.fPosDCAy          >= 0) SetVar(o.fPosDCAy          , aodTrack->YAtDCA()                  );
+  if (o.fPDCAX            >= 0) SetVar(o.fPDCAX            , aodTrack->PxAtDCA()                 );
+  if (o.fPDCAY            >= 0) SetVar(o.fPDCAY            , aodTrack->PyAtDCA()                 );
+  if (o.fPDCAZ            >= 0) SetVar(o.fPDCAZ            , aodTrack->PzAtDCA()                 );
+  if (o.fRAtAbsorberEnd   >= 0) SetVar(o.fRAtAbsorberEnd   , aodTrack->GetRAtAbsorberEnd()       );
+  if (o.fTPCncls          >= 0) SetVar(o.fTPCncls          , aodTrack->GetTPCNcls()              );
+  if (o.fId               >= 0) SetVar(o.fId               , aodTrack->GetID()                   );
+  if (o.fTPCnclsF         >= 0) SetVar(o.fTPCnclsF         , aodTrack->GetTPCNclsF()             );
+  if (o.fTPCNCrossedRows  >= 0) SetVar(o.fTPCNCrossedRows  , aodTrack->GetTPCNCrossedRows()      );
+  if (o.fTrackPhiOnEMCal  >= 0) SetVar(o.fTrackPhiOnEMCal  , aodTrack->GetTrackPhiOnEMCal()      );
+  if (o.fTrackEtaOnEMCal  >= 0) SetVar(o.fTrackEtaOnEMCal  , aodTrack->GetTrackEtaOnEMCal()      );
+  if (o.fTrackPtOnEMCal   >= 0) SetVar(o.fTrackPtOnEMCal   , aodTrack->GetTrackPtOnEMCal()       );
+  if (o.fITSsignal        >= 0) SetVar(o.fITSsignal        , aodTrack->GetITSsignal()            );
+  if (o.fTPCsignal        >= 0) SetVar(o.fTPCsignal        , aodTrack->GetTPCsignal()            );
+  if (o.fTPCsignalTuned   >= 0) SetVar(o.fTPCsignalTuned   , aodTrack->GetTPCsignalTunedOnData() );
+  if (o.fTPCsignalN       >= 0) SetVar(o.fTPCsignalN       , aodTrack->GetTPCsignalN()           );
+  if (o.fTPCmomentum      >= 0) SetVar(o.fTPCmomentum      , aodTrack->GetTPCmomentum()          );
+  if (o.fTPCTgl           >= 0) SetVar(o.fTPCTgl           , aodTrack->GetTPCTgl()               );
+  if (o.fTOFsignal        >= 0) SetVar(o.fTOFsignal        , aodTrack->GetTOFsignal()            );
+  if (o.fIntegratedLength >= 0) SetVar(o.fIntegratedLength , aodTrack->GetIntegratedLength()     );
+  if (o.fTOFsignalTuned   >= 0) SetVar(o.fTOFsignalTuned   , aodTrack->GetTOFsignalTunedOnData() );
+  if (o.fHMPIDsignal      >= 0) SetVar(o.fHMPIDsignal      , aodTrack->GetHMPIDsignal()          );
+  if (o.fHMPIDoccupancy   >= 0) SetVar(o.fHMPIDoccupancy   , aodTrack->GetHMPIDoccupancy()       );
+  if (o.fTRDsignal        >= 0) SetVar(o.fTRDsignal        , aodTrack->GetTRDsignal()            );
+  if (o.fTRDChi2          >= 0) SetVar(o.fTRDChi2          , aodTrack->GetTRDchi2()              );
+  if (o.fTRDnSlices       >= 0) SetVar(o.fTRDnSlices       , aodTrack->GetNumberOfTRDslices()    );
+  if (o.fIsMuonTrack      >= 0) SetVar(o.fIsMuonTrack      , aodTrack->IsMuonTrack() ? 1. : 0.   );
+  if (o.fTPCnclsS         >= 0) SetVar(o.fTPCnclsS         , aodTrack->GetTPCnclsS()             );
+  if (o.fFilterMap        >= 0) SetVar(o.fFilterMap        , aodTrack->GetFilterMap()            );
+  if (o.fCovMat[0]        >= 0) {
+    Double_t covMatrix[21];
+    aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
+    for(Int_t i=0;i<21;i++){
+      SetVar(o.fCovMat[i], covMatrix[i]);
     }
   }
 
@@ -161,10 +160,11 @@ AliNanoAODTrack::AliNanoAODTrack(const char * vars) :
   fAODEvent(NULL)
 {
    // ctor: Creates a special track simply allocating the required variables
-  AliNanoAODTrackMapping::GetInstance(vars);
+  const AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance(vars);
+  const AliNanoAODTrackOffsets & o = (mapping == fgOffsets.fMapping) ? fgOffsets : UpdateOffsets();
 
   // Create internal structure
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
+  AllocateInternalStorage(o.fSize);
 
 
 }
@@ -202,8 +202,8 @@ AliNanoAODTrack::AliNanoAODTrack(const AliNanoAODTrack& trk) :
   // Copy constructor
   // std::cout << "Copy Ctor" << std::endl;
   
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-  for (Int_t isize = 0; isize<AliNanoAODTrackMapping::GetInstance()->GetSize(); isize++) {
+  AllocateInternalStorage(Offsets().fSize);
+  for (Int_t isize = 0; isize<Offsets().fSize; isize++) {
     SetVar(isize, trk.GetVar(isize));    
   }
 
@@ -345,18 +345,18 @@ template <typename T> void AliNanoAODTrack::SetP(const T *p, const Bool_t cartes
       Double_t pt2 = p[0]*p[0] + p[1]*p[1];
       Double_t pp  = TMath::Sqrt(pt2 + p[2]*p[2]);
         
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt() ,TMath::Sqrt(pt2)); // pt
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi() , (pt2 != 0.) ? TMath::Pi()+TMath::ATan2(-p[1], -p[0]) : -999); // phi
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta() , (pp != 0.) ? TMath::ACos(p[2] / pp) : -999.); // theta
+      SetVar(Offsets().fPt ,TMath::Sqrt(pt2)); // pt
+      SetVar(Offsets().fPhi , (pt2 != 0.) ? TMath::Pi()+TMath::ATan2(-p[1], -p[0]) : -999); // phi
+      SetVar(Offsets().fTheta , (pp != 0.) ? TMath::ACos(p[2] / pp) : -999.); // theta
     } else {
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()      , p[0]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()     , p[1]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()   , p[2]);  
+      SetVar(Offsets().fPt      , p[0]);  
+      SetVar(Offsets().fPhi     , p[1]);  
+      SetVar(Offsets().fTheta   , p[2]);  
     }
   } else {
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()      , p[0]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()     , p[1]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()   , p[2]);  
+      SetVar(Offsets().fPt      , p[0]);  
+      SetVar(Offsets().fPhi     , p[1]);  
+      SetVar(Offsets().fTheta   , p[2]);  
   }
 }
 
@@ -398,9 +398,9 @@ void AliNanoAODTrack::SetDCA(Double_t d, Double_t z)
   // where the same variable is used to store DCA or position,
   // according to the value of the bit kIsDCA. We can probably get rid
   // of this in the special track.
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX(), d);
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY(), z);
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ(), 0);
+  SetVar(Offsets().fPosX, d);
+  SetVar(Offsets().fPosY, z);
+  SetVar(Offsets().fPosZ, 0);
   SetBit(AliAODTrack::kIsDCA);
 }
 
@@ -408,10 +408,10 @@ void AliNanoAODTrack::SetDCA(Double_t d, Double_t z)
 void AliNanoAODTrack::Print(Option_t* /* option */) const
 {
   // prints information about AliNanoAODTrack
-  //  std::cout << "Size: " << AliNanoAODTrackMapping::GetInstance()->GetSize() << std::endl;
+  //  std::cout << "Size: " << Offsets().fSize << std::endl;
   AliNanoAODTrackMapping::GetInstance()->Print();
 
-  for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
+  for (Int_t index = 0; index<Offsets().fSize; index++) {
     printf(" - [%2.2d] %-10s : %f\n", index, AliNanoAODTrackMapping::GetInstance()->GetVarName(index), GetVar(index));    
   }
   std::cout << "" << std::endl;  
@@ -432,7 +432,7 @@ Bool_t AliNanoAODTrack::PropagateToDCA(const AliVVertex *vtx,
   // return kFALSE is something went wrong
 
   // allowed only for tracks inside the beam pipe
-  Float_t xstart2 = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())+GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+  Float_t xstart2 = GetVar(Offsets().fPosX)*GetVar(Offsets().fPosX)+GetVar(Offsets().fPosY)*GetVar(Offsets().fPosY);
 
   if(xstart2 > 3.*3.) { // outside beampipe radius
     AliError("This method can be used only for propagation inside the beam pipe");
@@ -483,12 +483,12 @@ Bool_t AliNanoAODTrack::GetXYZAt(Double_t x, Double_t b, Double_t *r) const
   //maybe some of this code can be moved to AliVTrack to avoid code duplication
   const double kSafe = 1e-5;
   Double_t alpha=0.0;
-  Double_t radPos2 = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())+GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+  Double_t radPos2 = GetVar(Offsets().fPosX)*GetVar(Offsets().fPosX)+GetVar(Offsets().fPosY)*GetVar(Offsets().fPosY);
   Double_t radMax  = 45.; // approximately ITS outer radius
   if (radPos2 < radMax*radMax) { // inside the ITS     
     alpha = TMath::ATan2(Py(),Px());
   } else { // outside the ITS
-    Float_t phiPos = TMath::Pi()+TMath::ATan2(-GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()), -GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()));
+    Float_t phiPos = TMath::Pi()+TMath::ATan2(-GetVar(Offsets().fPosY), -GetVar(Offsets().fPosX));
      alpha = 
      TMath::DegToRad()*(20*((((Int_t)(phiPos*TMath::RadToDeg()))/20))+10);
   }
@@ -507,7 +507,7 @@ Bool_t AliNanoAODTrack::GetXYZAt(Double_t x, Double_t b, Double_t *r) const
   }
   
   // Get the vertex of origin and the momentum
-  TVector3 ver(GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()), GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()), GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()));
+  TVector3 ver(GetVar(Offsets().fPosX), GetVar(Offsets().fPosY), GetVar(Offsets().fPosZ));
   TVector3 mom(Px(),Py(),Pz());
   //
   // avoid momenta along axis
@@ -548,7 +548,7 @@ Bool_t AliNanoAODTrack::GetCovarianceXYZPxPyPz(Double_t cv[21]) const
     
     for (Int_t i=0; i<21; i++){
         
-        cv[i]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetCovMat(i));
+        cv[i]=GetVar(Offsets().fCovMat[i]);
         
     }
     
@@ -561,3 +561,71 @@ void  AliNanoAODTrack::Clear(Option_t * /*opt*/) {
   fVars.clear();
   fNVars = 0;
 }
+
+//_______________________________________________________
+const AliNanoAODTrackOffsets & AliNanoAODTrack::UpdateOffsets()
+{
+  // Resolves the positions of all standard variables from the current
+  // mapping. The offsets are shared by all tracks, call this again
+  // whenever a different mapping is loaded (e.g. in UserNotify)
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+
+  fgOffsets.fPt               = mapping->GetPt();
+  fgOffsets.fPhi              = mapping->GetPhi();
+  fgOffsets.fTheta            = mapping->GetTheta();
+  fgOffsets.fChi2PerNDF       = mapping->GetChi2PerNDF();
+  fgOffsets.fPosX             = mapping->GetPosX();
+  fgOffsets.fPosY             = mapping->GetPosY();
+  fgOffsets.fPosZ             = mapping->GetPosZ();
+  fgOffsets.fPosDCAx          = mapping->GetPosDCAx();
+  fgOffsets.fPosDCAy          = mapping->GetPosDCAy();
+  fgOffsets.fPDCAX            = mapping->GetPDCAX();
+  fgOffsets.fPDCAY            = mapping->GetPDCAY();
+  fgOffsets.fPDCAZ            = mapping->GetPDCAZ();
+  fgOffsets.fRAtAbsorberEnd   = mapping->GetRAtAbsorberEnd();
+  fgOffsets.fTPCncls          = mapping->GetTPCncls();
+  fgOffsets.fId               = mapping->Getid();
+  fgOffsets.fTPCnclsF         = mapping->GetTPCnclsF();
+  fgOffsets.fTPCNCrossedRows  = mapping->GetTPCNCrossedRows();
+  fgOffsets.fTrackPhiOnEMCal  = mapping->GetTrackPhiOnEMCal();
+  fgOffsets.fTrackEtaOnEMCal  = mapping->GetTrackEtaOnEMCal();
+  fgOffsets.fTrackPtOnEMCal   = mapping->GetTrackPtOnEMCal();
+  fgOffsets.fITSsignal        = mapping->GetITSsignal();
+  fgOffsets.fTPCsignal        = mapping->GetTPCsignal();
+  fgOffsets.fTPCsignalTuned   = mapping->GetTPCsignalTuned();
+  fgOffsets.fTPCsignalN       = mapping->GetTPCsignalN();
+  fgOffsets.fTPCmomentum      = mapping->GetTPCmomentum();
+  fgOffsets.fTPCTgl           = mapping->GetTPCTgl();
+  fgOffsets.fTOFsignal        = mapping->GetTOFsignal();
+  fgOffsets.fIntegratedLength = mapping->GetintegratedLenght();
+  fgOffsets.fTOFsignalTuned   = mapping->GetTOFsignalTuned();
+  fgOffsets.fHMPIDsignal      = mapping->GetHMPIDsignal();
+  fgOffsets.fHMPIDoccupancy   = mapping->GetHMPIDoccupancy();
+  fgOffsets.fTRDsignal        = mapping->GetTRDsignal();
+  fgOffsets.fTRDChi2          = mapping->GetTRDChi2();
+  fgOffsets.fTRDnSlices       = mapping->GetTRDnSlices();
+  fgOffsets.fIsMuonTrack      = mapping->GetIsMuonTrack();
+  fgOffsets.fTPCnclsS         = mapping->GetTPCnclsS();
+  fgOffsets.fFilterMap        = mapping->GetFilterMap();
+  for (Int_t i = 0; i < 21; i++) fgOffsets.fCovMat[i] = mapping->GetCovMat(i);
+  fgOffsets.fSize             = mapping->GetSize();
+  fgOffsets.fMapping          = mapping;
+
+  return fgOffsets;
+}
+
+//_______________________________________________________
+Int_t AliNanoAODTrack::GetColumn(const TClonesArray * tracks, Int_t index, std::vector<Double_t> & column)
+{
+  // Copies variable "index" (e.g. Offsets().fPt) of all the tracks in
+  // the array into one contiguous column. The column is only resized,
+  // so reusing it from event to event does not allocate
+
+  Int_t ntracks = (tracks && index >= 0) ? tracks->GetEntriesFast() : 0;
+  column.resize(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    column[itrack] = static_cast<const AliNanoAODTrack*>(tracks->UncheckedAt(itrack))->GetVar(index);
+  }
+  return ntracks;
+}
@@ -65,6 +65,53 @@ class AliTPCdEdxInfo;
 class AliAODEvent;
 class AliAODTrack;
 class AliESDTrack;
+class TClonesArray;
+
+// Positions of the standard variables in the internal storage, resolved
+// from the AliNanoAODTrackMapping instance by AliNanoAODTrack::UpdateOffsets()
+// and shared by all tracks (-1 if the variable is not stored)
+struct AliNanoAODTrackOffsets {
+  Int_t fPt;
+  Int_t fPhi;
+  Int_t fTheta;
+  Int_t fChi2PerNDF;
+  Int_t fPosX;
+  Int_t fPosY;
+  Int_t fPosZ;
+  Int_t fPosDCAx;
+  Int_t fPosDCAy;
+  Int_t fPDCAX;
+  Int_t fPDCAY;
+  Int_t fPDCAZ;
+  Int_t fRAtAbsorberEnd;
+  Int_t fTPCncls;
+  Int_t fId;
+  Int_t fTPCnclsF;
+  Int_t fTPCNCrossedRows;
+  Int_t fTrackPhiOnEMCal;
+  Int_t fTrackEtaOnEMCal;
+  Int_t fTrackPtOnEMCal;
+  Int_t fITSsignal;
+  Int_t fTPCsignal;
+  Int_t fTPCsignalTuned;
+  Int_t fTPCsignalN;
+  Int_t fTPCmomentum;
+  Int_t fTPCTgl;
+  Int_t fTOFsignal;
+  Int_t fIntegratedLength;
+  Int_t fTOFsignalTuned;
+  Int_t fHMPIDsignal;
+  Int_t fHMPIDoccupancy;
+  Int_t fTRDsignal;
+  Int_t fTRDChi2;
+  Int_t fTRDnSlices;
+  Int_t fIsMuonTrack;
+  Int_t fTPCnclsS;
+  Int_t fFilterMap;
+  Int_t fCovMat[21];
+  Int_t fSize;                              // number of variables
+  const AliNanoAODTrackMapping * fMapping;  // mapping the offsets were resolved from
+};
 
 class AliNanoAODTrack : public AliVTrack, public AliNanoAODStorage {
 
@@ -83,16 +130,23 @@ public:
 
 
   virtual void Clear(Option_t * opt) ;
+
+  // offsets of the variables, no mapping lookup: call UpdateOffsets() where the
+  // mapping changes (readers in UserNotify, AliNanoAODReplicator; done by the constructors with a var list)
+  static const AliNanoAODTrackOffsets & Offsets() { return fgOffsets; }
+  static const AliNanoAODTrackOffsets & UpdateOffsets();
+  // contiguous copy of one variable of all tracks, e.g. GetColumn(tracks, AliNanoAODTrack::Offsets().fPt, pts)
+  static Int_t GetColumn(const TClonesArray * tracks, Int_t index, std::vector<Double_t> & column);
   
   // kinematics
   virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
-  virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
-  virtual Double_t Theta()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
+  virtual Double_t Phi()       const { return GetVar(Offsets().fPhi);   }
+  virtual Double_t Theta()     const { return GetVar(Offsets().fTheta); }
   
   virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
   virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
   virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
-  virtual Double_t Pt() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()); }
+  virtual Double_t Pt() const { return GetVar(Offsets().fPt); }
   virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
   virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
 
@@ -101,8 +155,8 @@ public:
   virtual Double_t Zv() const { return GetProdVertex() ? GetProdVertex()->GetZ() : -999.; }
   virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0] = Xv(); x[1] = Yv(); x[2] = Zv(); return kTRUE; }
 
-  Double_t Chi2perNDF()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()); }  
-  UShort_t GetTPCNcls()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()); } // FIXME: should this be short?
+  Double_t Chi2perNDF()  const { return GetVar(Offsets().fChi2PerNDF); }  
+  UShort_t GetTPCNcls()  const { return GetVar(Offsets().fTPCncls); } // FIXME: should this be short?
 
   virtual Double_t M() const { AliFatal("Not Implemented"); return -1; }
   Double_t M(AliAODTrack::AODTrkPID_t pid) const;
@@ -151,7 +205,7 @@ public:
 
   
   template <typename T> Bool_t GetPosition(T *x) const {
-    x[0]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()); x[1]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()); x[2]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ());
+    x[0]=GetVar(Offsets().fPosX); x[1]=GetVar(Offsets().fPosY); x[2]=GetVar(Offsets().fPosZ);
     return TestBit(AliAODTrack::kIsDCA);}
 
   // FIXME: only allocate if listed?
@@ -175,32 +229,32 @@ public:
   // void RemoveCovMatrix() {delete fCovMatrix; fCovMatrix=NULL;}
 
   Bool_t IsMuonTrack() const {
-  if (GetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack())==1) return kTRUE ; 
+  if (GetVar(Offsets().fIsMuonTrack)==1) return kTRUE ; 
   else return kFALSE;
   } 
 
-  Double_t XAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()); }
-  Double_t YAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()); }
+  Double_t XAtDCA() const { return GetVar(Offsets().fPosDCAx); }
+  Double_t YAtDCA() const { return GetVar(Offsets().fPosDCAy); }
   Double_t ZAtDCA() const { 
-    if (IsMuonTrack())  return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ());
-    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+    if (IsMuonTrack())  return GetVar(Offsets().fPosZ);
+    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(Offsets().fPosY);
      else return -999.; }
 
   Bool_t   XYZAtDCA(Double_t x[3]) const { x[0] = XAtDCA(); x[1] = YAtDCA(); x[2] = ZAtDCA(); return kTRUE; }
   
   Double_t DCA() const { 
     if (IsMuonTrack()) return TMath::Sqrt(XAtDCA()*XAtDCA() + YAtDCA()*YAtDCA());
-    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()); // FIXME: Why does this return posX?
+    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(Offsets().fPosX); // FIXME: Why does this return posX?
     else return -999.; }
 
   
-  Double_t PxAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()); }
-  Double_t PyAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()); }
-  Double_t PzAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()); }
+  Double_t PxAtDCA() const { return GetVar(Offsets().fPDCAX); }
+  Double_t PyAtDCA() const { return GetVar(Offsets().fPDCAY); }
+  Double_t PzAtDCA() const { return GetVar(Offsets().fPDCAZ); }
   Double_t PAtDCA() const { return TMath::Sqrt(PxAtDCA()*PxAtDCA() + PyAtDCA()*PyAtDCA() + PzAtDCA()*PzAtDCA()); }
   Bool_t   PxPyPzAtDCA(Double_t p[3]) const { p[0] = PxAtDCA(); p[1] = PyAtDCA(); p[2] = PzAtDCA(); return kTRUE; }
   
-  Double_t GetRAtAbsorberEnd() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()); }
+  Double_t GetRAtAbsorberEnd() const { return GetVar(Offsets().fRAtAbsorberEnd); }
   
   // For this whole block of cluster maps I could simply define a cluster map in the int array. For the moment comment all maps. Maybe not neede 
   UChar_t  GetITSClusterMap() const       { AliFatal("Not Implemented"); return 0;};
@@ -210,10 +264,10 @@ public:
   // UInt_t   GetMUONClusterMap() const      { return (fITSMuonClusterMap&0x3ff0000)>>16; } // 
   // UInt_t   GetITSMUONClusterMap() const   { return fITSMuonClusterMap; }
   
-   Bool_t  TestFilterBit(UInt_t filterBit) const {return (Bool_t) ((filterBit & UInt_t(GetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()))) != 0);}
+   Bool_t  TestFilterBit(UInt_t filterBit) const {return (Bool_t) ((filterBit & UInt_t(GetVar(Offsets().fFilterMap))) != 0);}
   // Bool_t  TestFilterMask(UInt_t filterMask) const {return (Bool_t) ((filterMask & fFilterMap) == filterMask);}
   // void    SetFilterMap(UInt_t i){fFilterMap = i;}
-   UInt_t  GetFilterMap() const {return UInt_t(GetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()));}
+   UInt_t  GetFilterMap() const {return UInt_t(GetVar(Offsets().fFilterMap));}
 
   // const TBits& GetTPCClusterMap() const {return fTPCClusterMap;}
   // const TBits* GetTPCClusterMapPtr() const {return &fTPCClusterMap;}
@@ -228,12 +282,12 @@ public:
   // void    SetTPCSharedMap(const TBits amap) {fTPCSharedMap = amap;}
   // void    SetTPCFitMap(const TBits amap) {fTPCFitMap = amap;}
   // 
-  void    SetTPCPointsF(UShort_t  findable){fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()] = findable;}
-  void    SetTPCNCrossedRows(UInt_t n)     {fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()] = n;}
+  void    SetTPCPointsF(UShort_t  findable){fVars[Offsets().fTPCnclsF] = findable;}
+  void    SetTPCNCrossedRows(UInt_t n)     {fVars[Offsets().fTPCNCrossedRows] = n;}
 
-  UShort_t GetTPCNclsF() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF());}
-  UShort_t GetTPCnclsS() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS());}
-  UShort_t GetTPCNCrossedRows()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows());}
+  UShort_t GetTPCNclsF() const { return GetVar(Offsets().fTPCnclsF);}
+  UShort_t GetTPCnclsS() const { return GetVar(Offsets().fTPCnclsS);}
+  UShort_t GetTPCNCrossedRows()  const { return GetVar(Offsets().fTPCNCrossedRows);}
   Float_t  GetTPCFoundFraction() const { return GetTPCNCrossedRows()>0 ? float(GetTPCNcls())/GetTPCNCrossedRows() : 0;}
 
   // Calorimeter Cluster
@@ -242,11 +296,11 @@ public:
   // void SetEMCALcluster(Int_t index) {fCaloIndex=index;}
   // Bool_t IsEMCAL() const {return fFlags&kEMCALmatch;}
 
-  Double_t GetTrackPhiOnEMCal() const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal());}
-  Double_t GetTrackEtaOnEMCal() const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal());}
-  Double_t GetTrackPtOnEMCal() const  {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal());}
+  Double_t GetTrackPhiOnEMCal() const {return GetVar(Offsets().fTrackPhiOnEMCal);}
+  Double_t GetTrackEtaOnEMCal() const {return GetVar(Offsets().fTrackEtaOnEMCal);}
+  Double_t GetTrackPtOnEMCal() const  {return GetVar(Offsets().fTrackPtOnEMCal);}
   Double_t GetTrackPOnEMCal() const {return TMath::Abs(GetTrackEtaOnEMCal()) < 1 ? GetTrackPtOnEMCal()*TMath::CosH(GetTrackEtaOnEMCal()) : -999;}
-  void SetTrackPhiEtaPtOnEMCal(Double_t phi,Double_t eta,Double_t pt) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()]=phi;fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()]=eta;fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()]=pt;}
+  void SetTrackPhiEtaPtOnEMCal(Double_t phi,Double_t eta,Double_t pt) {fVars[Offsets().fTrackPhiOnEMCal]=phi;fVars[Offsets().fTrackEtaOnEMCal]=eta;fVars[Offsets().fTrackPtOnEMCal]=pt;}
 
   //  Int_t GetPHOScluster() const {return fCaloIndex;} // TODO: int array
   //  void SetPHOScluster(Int_t index) {fCaloIndex=index;}
@@ -254,21 +308,21 @@ public:
 
   //pid signal interface
   //TODO you can remove the PID object
-  Double_t  GetITSsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal());}
-  Double_t  GetTPCsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal());}
-  Double_t  GetTPCsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned());}
-  void      SetTPCsignalTunedOnData(Double_t signal) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()] = signal;}
-  UShort_t  GetTPCsignalN()      const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN());}// FIXME: what is this?
+  Double_t  GetITSsignal()       const { return GetVar(Offsets().fITSsignal);}
+  Double_t  GetTPCsignal()       const { return GetVar(Offsets().fTPCsignal);}
+  Double_t  GetTPCsignalTunedOnData() const { return GetVar(Offsets().fTPCsignalTuned);}
+  void      SetTPCsignalTunedOnData(Double_t signal) {fVars[Offsets().fTPCsignalTuned] = signal;}
+  UShort_t  GetTPCsignalN()      const { return GetVar(Offsets().fTPCsignalN);}// FIXME: what is this?
   //  virtual AliTPCdEdxInfo* GetTPCdEdxInfo() const {return fDetPid?fDetPid->GetTPCdEdxInfo():0;} // FIXME: is this needed?
-  Double_t  GetTPCmomentum()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()); }
-  Double_t  GetTPCTgl()          const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl());      } // FIXME: what is this?
-  Double_t  GetTOFsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal());   } 
+  Double_t  GetTPCmomentum()     const { return GetVar(Offsets().fTPCmomentum); }
+  Double_t  GetTPCTgl()          const { return GetVar(Offsets().fTPCTgl);      } // FIXME: what is this?
+  Double_t  GetTOFsignal()       const { return GetVar(Offsets().fTOFsignal);   } 
   Double_t  GetIntegratedLength() const { AliFatal("Not implemented"); return 0;} // TODO: implement track lenght
   void      SetIntegratedLength(Double_t/* l*/) {AliFatal("Not implemented");}
-  Double_t  GetTOFsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned());}
-  void      SetTOFsignalTunedOnData(Double_t signal) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()] = signal;}
-  Double_t  GetHMPIDsignal()      const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal());}; 
-  Double_t  GetHMPIDoccupancy()  const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy());}; 
+  Double_t  GetTOFsignalTunedOnData() const { return GetVar(Offsets().fTOFsignalTuned);}
+  void      SetTOFsignalTunedOnData(Double_t signal) {fVars[Offsets().fTOFsignalTuned] = signal;}
+  Double_t  GetHMPIDsignal()      const {return GetVar(Offsets().fHMPIDsignal);}; 
+  Double_t  GetHMPIDoccupancy()  const {return GetVar(Offsets().fHMPIDoccupancy);}; 
   
       
   
@@ -288,10 +342,10 @@ public:
   Double_t  GetTRDmomentum(Int_t /*plane*/, Double_t */*sp*/=0x0) const {AliFatal("Not Implemented"); return 0;};
   // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
-  Double_t  GetTRDsignal()         const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal());}
-  Double_t  GetTRDchi2()           const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2());}
+  Double_t  GetTRDsignal()         const {return GetVar(Offsets().fTRDsignal);}
+  Double_t  GetTRDchi2()           const {return GetVar(Offsets().fTRDChi2);}
   UChar_t   GetTRDncls()           const {return GetTRDncls(-1);}
-  Int_t     GetNumberOfTRDslices() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()); }
+  Int_t     GetNumberOfTRDslices() const { return GetVar(Offsets().fTRDnSlices); }
 
   const AliAODEvent* GetAODEvent() const {return fAODEvent;}// FIXME: change to special event type
   void SetAODEvent(const AliAODEvent* ptr){fAODEvent = ptr;}
@@ -324,20 +378,20 @@ public:
 
 
 
-  void SetOneOverPt(Double_t oneOverPt) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPt()] = 1. / oneOverPt; }
-  void SetPt(Double_t pt) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPt()] = pt; };
-  void SetPhi(Double_t phi) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPhi()] = phi; }
-  void SetTheta(Double_t theta) { fVars[AliNanoAODTrackMapping::GetInstance()->GetTheta()] = theta; }
+  void SetOneOverPt(Double_t oneOverPt) { fVars[Offsets().fPt] = 1. / oneOverPt; }
+  void SetPt(Double_t pt) { fVars[Offsets().fPt] = pt; };
+  void SetPhi(Double_t phi) { fVars[Offsets().fPhi] = phi; }
+  void SetTheta(Double_t theta) { fVars[Offsets().fTheta] = theta; }
   template <typename T> void SetP(const T *p, Bool_t cartesian = kTRUE);// TODO: WHAT IS THIS FOR?
   void SetP() {AliFatal("Not Implemented");}
 
-  void SetXYAtDCA(Double_t x, Double_t y) {fVars[AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()] = x;  fVars[AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()]= y;}
-  void SetPxPyPzAtDCA(Double_t pX, Double_t pY, Double_t pZ) {fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAX()] = pX; fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAY()] = pY; fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()] = pZ;}
+  void SetXYAtDCA(Double_t x, Double_t y) {fVars[Offsets().fPosDCAx] = x;  fVars[Offsets().fPosDCAy]= y;}
+  void SetPxPyPzAtDCA(Double_t pX, Double_t pY, Double_t pZ) {fVars[Offsets().fPDCAX] = pX; fVars[Offsets().fPDCAY] = pY; fVars[Offsets().fPDCAZ] = pZ;}
   
-void SetRAtAbsorberEnd(Double_t r) { fVars[AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()] = r; }
+void SetRAtAbsorberEnd(Double_t r) { fVars[Offsets().fRAtAbsorberEnd] = r; }
   
   void SetCharge(Short_t q) { fCharge = q; }
-void SetChi2perNDF(Double_t chi2perNDF) { fVars[AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()] = chi2perNDF; }
+void SetChi2perNDF(Double_t chi2perNDF) { fVars[Offsets().fChi2PerNDF] = chi2perNDF; }
 
   // void SetITSClusterMap(UChar_t itsClusMap)                 { fITSMuonClusterMap = (fITSMuonClusterMap&0xffffff00)|(((UInt_t)itsClusMap)&0xff); }
   // void SetHitsPatternInTrigCh(UShort_t hitsPatternInTrigCh) { fITSMuonClusterMap = (fITSMuonClusterMap&0xffff00ff)|((((UInt_t)hitsPatternInTrigCh)&0xff)<<8); }
@@ -383,6 +437,8 @@ private :
   Short_t       fCharge; // track charge
   const AliAODEvent* fAODEvent;     //! 
 
+  static AliNanoAODTrackOffsets fgOffsets; //! offsets shared by all tracks
+
   ClassDef(AliNanoAODTrack, 1);
 };
 
@@ -417,22 +473,22 @@ void AliNanoAODTrack::SetPosition(const T *x, const Bool_t dca)
     if (!dca) {
       ResetBit(AliAODTrack::kIsDCA);
 
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = x[0];
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = x[1];
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = x[2];
+      fVars[Offsets().fPosX] = x[0];
+      fVars[Offsets().fPosY] = x[1];
+      fVars[Offsets().fPosZ] = x[2];
     } else {
       SetBit(AliAODTrack::kIsDCA);
       // don't know any better yet
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = -999.;
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = -999.;
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = -999.;
+      fVars[Offsets().fPosX] = -999.;
+      fVars[Offsets().fPosY] = -999.;
+      fVars[Offsets().fPosZ] = -999.;
     }
   } else {
     ResetBit(AliAODTrack::kIsDCA);
 
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = -999.;
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = -999.;
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = -999.;
+    fVars[Offsets().fPosX] = -999.;
+    fVars[Offsets().fPosY] = -999.;
+    fVars[Offsets().fPosZ] = -999.;
   }
 }
 
@@ -31,6 +31,7 @@
 #include "AliEMCALTriggerAlgorithm.h"
 #include "AliEMCALTriggerRawPatch.h"
 #include "AliEmcalTriggerMakerKernel.h"
+#include "AliEmcalTriggerPatchSumTable.h"
 #include "AliEmcalTriggerSetupInfo.h"
 #include "AliLog.h"
 #include "AliVCaloCells.h"
@@ -72,6 +73,10 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
+  fSumTableAmplitudes(nullptr),
+  fSumTableADCSimple(nullptr),
+  fSumTableADC(nullptr),
+  fSumTableEnergySmeared(nullptr),
   fADCtoGeV(1.)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
@@ -87,6 +92,10 @@ AliEmcalTriggerMakerKernel::~AliEmcalTriggerMakerKernel() {
   delete fPatchEnergySimpleSmeared;
   delete fLevel0TimeMap;
   delete fTriggerBitMap;
+  delete fSumTableAmplitudes;
+  delete fSumTableADCSimple;
+  delete fSumTableADC;
+  delete fSumTableEnergySmeared;
   delete fPatchFinder;
   delete fLevel0PatchFinder;
   if(fTriggerBitConfig) delete fTriggerBitConfig;
@@ -114,10 +123,20 @@ void AliEmcalTriggerMakerKernel::Init(){
   fLevel0TimeMap->Allocate(48, nrows);
   fTriggerBitMap->Allocate(48, nrows);
 
+  // Allocate summed-area tables for the patch sums
+  fSumTableAmplitudes = new PWG::EMCAL::AliEmcalTriggerPatchSumTable;
+  fSumTableADCSimple = new PWG::EMCAL::AliEmcalTriggerPatchSumTable;
+  fSumTableADC = new PWG::EMCAL::AliEmcalTriggerPatchSumTable;
+  fSumTableAmplitudes->Allocate(48, nrows);
+  fSumTableADCSimple->Allocate(48, nrows);
+  fSumTableADC->Allocate(48, nrows);
+
   if(fSmearModelMean && fSmearModelSigma){
     // Allocate container for energy smearing (if enabled)
     fPatchEnergySimpleSmeared = new AliEMCALTriggerDataGrid<double>;
     fPatchEnergySimpleSmeared->Allocate(48, nrows);
+    fSumTableEnergySmeared = new PWG::EMCAL::AliEmcalTriggerPatchSumTable;
+    fSumTableEnergySmeared->Allocate(48, nrows);
   }
 }
 
@@ -312,6 +331,10 @@ void AliEmcalTriggerMakerKernel::Reset(){
   fLevel0TimeMap->Reset();
   fTriggerBitMap->Reset();
   if(fPatchEnergySimpleSmeared) fPatchEnergySimpleSmeared->Reset();
+  fSumTableAmplitudes->Reset();
+  fSumTableADCSimple->Reset();
+  fSumTableADC->Reset();
+  if(fSumTableEnergySmeared) fSumTableEnergySmeared->Reset();
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
 }
 
@@ -504,6 +527,9 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
+  // Patch sums are obtained from the summed-area tables
+  BuildPatchSumTables();
+
   std::vector<AliEMCALTriggerRawPatch> patches;
   if (fPatchFinder) {
     if (useL0amp) {
@@ -547,12 +573,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetOffSet(offset);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = fSumTableEnergySmeared->GetPatchSum(fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
       fullpatch.SetSmearedEnergy(energysmear);
     }
@@ -578,12 +599,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     fullpatch.SetTriggerBitConfig(fTriggerBitConfig);
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
-      double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
-        }
-      }
+      double energysmear = fSumTableEnergySmeared->GetPatchSum(fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
       fullpatch.SetSmearedEnergy(energysmear);
     }
     outputcont.push_back(fullpatch);
@@ -653,6 +669,42 @@ double AliEmcalTriggerMakerKernel::GetTriggerChannelEnergySmeared(Int_t col, Int
   return adc;
 }
 
+void AliEmcalTriggerMakerKernel::BuildPatchSumTables(){
+  fSumTableAmplitudes->Build(*fPatchAmplitudes);
+  fSumTableADCSimple->Build(*fPatchADCSimple);
+  fSumTableADC->Build(*fPatchADC);
+  if(fPatchEnergySimpleSmeared) fSumTableEnergySmeared->Build(*fPatchEnergySimpleSmeared);
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchL0Amplitude(Int_t col, Int_t row, Int_t patchsize) const {
+  return fSumTableAmplitudes->GetPatchSum(col, row, patchsize);
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchADC(Int_t col, Int_t row, Int_t patchsize) const {
+  return fSumTableADC->GetPatchSum(col, row, patchsize);
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchEnergyRough(Int_t col, Int_t row, Int_t patchsize) const {
+  return fSumTableADC->GetPatchSum(col, row, patchsize) * EMCALTrigger::kEMCL1ADCtoGeV;
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchADCSimple(Int_t col, Int_t row, Int_t patchsize) const {
+  return fSumTableADCSimple->GetPatchSum(col, row, patchsize);
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchEnergy(Int_t col, Int_t row, Int_t patchsize) const {
+  return fSumTableADCSimple->GetPatchSum(col, row, patchsize) * fADCtoGeV;
+}
+
+double AliEmcalTriggerMakerKernel::GetPatchEnergySmeared(Int_t col, Int_t row, Int_t patchsize) const {
+  if(!fSumTableEnergySmeared) return 0.;
+  return fSumTableEnergySmeared->GetPatchSum(col, row, patchsize);
+}
+
+Int_t AliEmcalTriggerMakerKernel::ScanOfflinePatches(Int_t patchsize, Int_t subregion, Int_t rowmin, Int_t rowmax, std::vector<double> &adcsums) const {
+  return fSumTableADCSimple->ScanPatches(patchsize, subregion, rowmin, rowmax, adcsums);
+}
+
 double AliEmcalTriggerMakerKernel::GetDataGridDimensionRows() const{
   return fPatchADC->GetNumberOfRows();
 }
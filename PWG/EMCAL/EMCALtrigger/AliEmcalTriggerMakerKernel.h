@@ -25,6 +25,12 @@ template<class T> class AliEMCALTriggerDataGrid;
 template<class T> class AliEMCALTriggerAlgorithm;
 template<class T> class AliEMCALTriggerPatchFinder;
 
+namespace PWG {
+namespace EMCAL {
+class AliEmcalTriggerPatchSumTable;
+}
+}
+
 // To be moved to AliRoot in AliEMCALTriggerConstants.h at the first occasion
 namespace EMCALTrigger {
 const Double_t kEMCL0ADCtoGeV_AP = 0.018970588*4;  // 0.075882352;             ///< Conversion from EMCAL Level0 ADC to energy
@@ -163,6 +169,88 @@ public:
    */
   double GetTriggerChannelEnergySmeared(Int_t col, Int_t row) const;
 
+  /**
+   * @brief Get the summed L0 amplitude of a patch (in col-row space)
+   *
+   * Requires the patch sum tables to be built for the current event (see BuildPatchSumTables).
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Summed L0 amplitude of the patch (channels outside the grid do not contribute)
+   */
+  double GetPatchL0Amplitude(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Get the summed ADC value of a patch (in col-row space)
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Summed ADC value of the patch
+   */
+  double GetPatchADC(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Get the estimated patch energy based on ADC measurement (in col-row space)
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Estimated energy of the patch
+   */
+  double GetPatchEnergyRough(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Get the summed ADC value of a patch estimated from cell energies (in col-row space)
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Summed ADC value of the patch from cell energies
+   */
+  double GetPatchADCSimple(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Get the patch energy estimated from cells (in col-row space)
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Energy of the patch
+   */
+  double GetPatchEnergy(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Get the (simulated) smeared patch energy (in col-row space)
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in trigger channels)
+   * @return Smeared patch energy (0 if smearing is not enabled)
+   */
+  double GetPatchEnergySmeared(Int_t col, Int_t row, Int_t patchsize) const;
+
+  /**
+   * @brief Calculate offline ADC values of all patches of a given size with a sliding window
+   *
+   * Patches are started every subregion step in column and row direction
+   * within the row range. The patch ADC values (estimated from cell energies)
+   * are written row-major into the output vector. Requires the patch sum tables
+   * to be built for the current event.
+   * @param[in] patchsize Size of the patches (in trigger channels)
+   * @param[in] subregion Step size of the sliding window (in trigger channels)
+   * @param[in] rowmin Minimum start row of the patches
+   * @param[in] rowmax Maximum row covered by the patches
+   * @param[out] adcsums Offline ADC values of the patches
+   * @return Number of patches per row of patches
+   */
+  Int_t ScanOfflinePatches(Int_t patchsize, Int_t subregion, Int_t rowmin, Int_t rowmax, std::vector<double> &adcsums) const;
+
+  /**
+   * @brief Build the patch sum tables from the data grids
+   *
+   * Summed-area tables are built once per event for each amplitude grid so
+   * that patch sums can be obtained independent of the patch size. Called
+   * automatically in CreateTriggerPatches, needs to be called explicitly by
+   * users requesting patch sums before.
+   */
+  void BuildPatchSumTables();
+
   /**
    * @brief Get the dimension of the underlying data grids in row direction
    * @return Number of rows
@@ -506,11 +594,15 @@ protected:
   AliEMCALTriggerDataGrid<double>           *fPatchEnergySimpleSmeared;   //!<! Data grid for smeared energy values from cell energies
   AliEMCALTriggerDataGrid<char>             *fLevel0TimeMap;              //!<! Map needed to store the level0 times
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
+  PWG::EMCAL::AliEmcalTriggerPatchSumTable  *fSumTableAmplitudes;         //!<! Summed-area table of the TRU amplitudes
+  PWG::EMCAL::AliEmcalTriggerPatchSumTable  *fSumTableADCSimple;          //!<! Summed-area table of the offline ADC values
+  PWG::EMCAL::AliEmcalTriggerPatchSumTable  *fSumTableADC;                //!<! Summed-area table of the ADC values
+  PWG::EMCAL::AliEmcalTriggerPatchSumTable  *fSumTableEnergySmeared;      //!<! Summed-area table of the smeared energies
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -0,0 +1,106 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEmcalTriggerPatchSumTable.h"
+
+namespace PWG {
+
+namespace EMCAL {
+
+AliEmcalTriggerPatchSumTable::AliEmcalTriggerPatchSumTable():
+  fNCols(0),
+  fNRows(0),
+  fTable()
+{
+}
+
+void AliEmcalTriggerPatchSumTable::Allocate(Int_t ncols, Int_t nrows){
+  fNCols = ncols;
+  fNRows = nrows;
+  fTable.assign((ncols + 1) * (nrows + 1), 0.);
+}
+
+void AliEmcalTriggerPatchSumTable::Reset(){
+  std::fill(fTable.begin(), fTable.end(), 0.);
+}
+
+void AliEmcalTriggerPatchSumTable::Build(const AliEMCALTriggerDataGrid<double> &grid, Double_t scale){
+  if(!IsAllocated() || grid.GetNumberOfCols() != fNCols || grid.GetNumberOfRows() != fNRows)
+    Allocate(grid.GetNumberOfCols(), grid.GetNumberOfRows());
+
+  // Leading row and column stay 0, each following row is the running
+  // sum of the grid row added to the previous table row
+  for(int irow = 0; irow < fNRows; irow++){
+    const double *prev = &fTable[GetTableIndex(0, irow)];
+    double *current = &fTable[GetTableIndex(0, irow + 1)];
+    double rowsum = 0.;
+    current[0] = 0.;
+    for(int icol = 0; icol < fNCols; icol++){
+      rowsum += grid(icol, irow) * scale;
+      current[icol + 1] = prev[icol + 1] + rowsum;
+    }
+  }
+}
+
+Double_t AliEmcalTriggerPatchSumTable::GetAreaSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const {
+  if(!IsAllocated()) return 0.;
+  int colmin = std::max(col, 0), colmax = std::min(col + ncols, fNCols),
+      rowmin = std::max(row, 0), rowmax = std::min(row + nrows, fNRows);
+  if(colmin >= colmax || rowmin >= rowmax) return 0.;
+  return fTable[GetTableIndex(colmax, rowmax)] - fTable[GetTableIndex(colmin, rowmax)]
+       - fTable[GetTableIndex(colmax, rowmin)] + fTable[GetTableIndex(colmin, rowmin)];
+}
+
+Int_t AliEmcalTriggerPatchSumTable::ScanPatches(Int_t patchsize, Int_t subregion, Int_t rowmin, Int_t rowmax, std::vector<double> &sums) const {
+  sums.clear();
+  if(!IsAllocated() || patchsize <= 0 || subregion <= 0) return 0;
+  rowmin = std::max(rowmin, 0);
+  rowmax = std::min(rowmax, fNRows - 1);
+  if(patchsize > fNCols || rowmax - rowmin + 1 < patchsize) return 0;
+
+  const int npatchcols = (fNCols - patchsize) / subregion + 1,
+            npatchrows = (rowmax - rowmin + 1 - patchsize) / subregion + 1;
+  sums.resize(npatchcols * npatchrows);
+  for(int iprow = 0; iprow < npatchrows; iprow++){
+    const int rowstart = rowmin + iprow * subregion;
+    const double *lower = &fTable[GetTableIndex(0, rowstart)],
+                 *upper = &fTable[GetTableIndex(0, rowstart + patchsize)];
+    double *out = &sums[iprow * npatchcols];
+    // independent iterations - vectorizable
+    for(int ipcol = 0; ipcol < npatchcols; ipcol++){
+      const int colstart = ipcol * subregion;
+      out[ipcol] = upper[colstart + patchsize] - upper[colstart] - lower[colstart + patchsize] + lower[colstart];
+    }
+  }
+  return npatchcols;
+}
+
+}
+
+}
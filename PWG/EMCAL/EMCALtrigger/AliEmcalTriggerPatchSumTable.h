@@ -0,0 +1,170 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRIGGERPATCHSUMTABLE_H
+#define ALIEMCALTRIGGERPATCHSUMTABLE_H
+
+#include <vector>
+#include <Rtypes.h>
+
+template<class T> class AliEMCALTriggerDataGrid;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTriggerPatchSumTable
+ * @brief Summed-area table of a trigger channel data grid
+ * @ingroup EMCALTRGFW
+ *
+ * The table stores for each position (col, row) the integral of the
+ * data grid over all channels with lower column and row index. Once
+ * built (once per event and per amplitude grid) the sum of any
+ * rectangular area, as needed for trigger patches, is obtained from
+ * four table entries independent of the patch size.
+ *
+ * The table is stored with one additional leading column and row
+ * of zeros so that patches at the border of the grid need no special
+ * treatment.
+ */
+class AliEmcalTriggerPatchSumTable {
+public:
+
+  /**
+   * @brief Dummy constructor
+   */
+  AliEmcalTriggerPatchSumTable();
+
+  /**
+   * @brief Destructor
+   */
+  ~AliEmcalTriggerPatchSumTable() {}
+
+  /**
+   * @brief Allocate the table for a grid of the given dimension
+   * @param[in] ncols Number of columns of the underlying data grid
+   * @param[in] nrows Number of rows of the underlying data grid
+   */
+  void Allocate(Int_t ncols, Int_t nrows);
+
+  /**
+   * @brief Build the table from the data grid
+   *
+   * Needs to be called once per event after the data grid
+   * is filled. In case the table is not yet allocated or the
+   * dimension does not match, it is (re)allocated according
+   * to the dimension of the grid.
+   * @param[in] grid Data grid with the channel amplitudes
+   * @param[in] scale Scale factor applied to each channel (i.e. ADC to energy conversion)
+   */
+  void Build(const AliEMCALTriggerDataGrid<double> &grid, Double_t scale = 1.);
+
+  /**
+   * @brief Reset the table content (keeping the allocation)
+   */
+  void Reset();
+
+  /**
+   * @brief Get the sum over a rectangular area of the data grid
+   *
+   * Parts of the area outside the grid do not contribute.
+   * @param[in] col Starting column of the area
+   * @param[in] row Starting row of the area
+   * @param[in] ncols Number of columns of the area
+   * @param[in] nrows Number of rows of the area
+   * @return Sum of the channel amplitudes in the area
+   */
+  Double_t GetAreaSum(Int_t col, Int_t row, Int_t ncols, Int_t nrows) const;
+
+  /**
+   * @brief Get the sum of a quadratic trigger patch
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] patchsize Size of the patch (in channels)
+   * @return Sum of the channel amplitudes in the patch
+   */
+  Double_t GetPatchSum(Int_t col, Int_t row, Int_t patchsize) const { return GetAreaSum(col, row, patchsize, patchsize); }
+
+  /**
+   * @brief Calculate patch sums of all patches within a row range with a sliding window
+   *
+   * Patches are started at each subregion step in column and row
+   * direction. The patch sums are written row-major into the output
+   * vector, with (ncols - patchsize)/subregion + 1 entries per row
+   * of patches. The inner loop only consists of independent
+   * differences of table rows and can be vectorized by the compiler.
+   *
+   * @param[in] patchsize Size of the patch (in channels)
+   * @param[in] subregion Step size of the sliding window (in channels)
+   * @param[in] rowmin Minimum start row of the patches
+   * @param[in] rowmax Maximum row (inclusive) covered by the patches
+   * @param[out] sums Patch sums
+   * @return Number of patches per row of patches (0 if no patch fits in the range)
+   */
+  Int_t ScanPatches(Int_t patchsize, Int_t subregion, Int_t rowmin, Int_t rowmax, std::vector<double> &sums) const;
+
+  /**
+   * @brief Get the number of columns of the underlying data grid
+   * @return Number of columns
+   */
+  Int_t GetNumberOfCols() const { return fNCols; }
+
+  /**
+   * @brief Get the number of rows of the underlying data grid
+   * @return Number of rows
+   */
+  Int_t GetNumberOfRows() const { return fNRows; }
+
+  /**
+   * @brief Check whether the table is allocated
+   * @return True if the table is allocated, false otherwise
+   */
+  Bool_t IsAllocated() const { return fTable.size() > 0; }
+
+protected:
+
+  /**
+   * @brief Get the index in the table for a given column and row
+   *
+   * Column and row are the (exclusive) upper edge of the integration area,
+   * meaning that (0, 0) corresponds to the leading row and column of zeros.
+   * @param[in] col Column in the table
+   * @param[in] row Row in the table
+   * @return Index in the linearized table
+   */
+  Int_t GetTableIndex(Int_t col, Int_t row) const { return row * (fNCols + 1) + col; }
+
+  Int_t                           fNCols;         ///< Number of columns of the underlying data grid
+  Int_t                           fNRows;         ///< Number of rows of the underlying data grid
+  std::vector<double>             fTable;         ///< Summed-area table, (ncols + 1) x (nrows + 1), row-major
+};
+
+}
+
+}
+
+#endif /* ALIEMCALTRIGGERPATCHSUMTABLE_H */
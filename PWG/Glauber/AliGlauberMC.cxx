@@ -31,7 +31,11 @@
 #include <TNtuple.h>
 #include <TFile.h>
 #include <TTree.h>
+#include <TDirectory.h>
 #include <TF1.h>
+#include <TRandom3.h>
+#include <algorithm>
+#include <thread>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -40,6 +44,206 @@
 using std::flush;
 ClassImp(AliGlauberMC)
 
+namespace {
+  // columns of the ntuple filled by AliGlauberMC::Run, in the order of GetEventRow
+  const Int_t kNColumns = 48;
+  const char *kColumnNames[kNColumns] = {
+    "Npart","Ncoll","B","MeanX","MeanY","MeanX2","MeanY2","MeanXY","VarX","VarY","VarXY",
+    "MeanXSystem","MeanYSystem","MeanXA","MeanYA","MeanXB","MeanYB","VarE","Stoa","VarEColl",
+    "VarECom","VarEPart","VarEPartColl","VarEPartCom","dNdEta","dNdEtaGBW","dNdEtaTwoNBD",
+    "xsect","tAA","Epsl2","Epsl3","Epsl4","Epsl5","E2Coll","E3Coll","E4Coll","E5Coll","E2Com",
+    "E3Com","E4Com","E5Com","Psi2","Psi3","Psi4","Psi5","BNN","signn","Ncollw"
+  };
+}
+
+//______________________________________________________________________________
+// Collision finder of AliGlauberMC::CalcEvent.
+//
+// The transverse positions of the nucleons are copied into flat arrays, and the
+// nucleons of A are sorted into a 2D grid whose cells are as large as the
+// largest interaction distance. A nucleon of B is then only tested against the
+// nucleons of A in the 3x3 cells around it; each row of three cells is a
+// contiguous range of the sorted arrays, so the distances are computed in a
+// plain loop that the compiler vectorises. The hits of a nucleon of B are
+// accumulated in the order of the nucleons of A, which keeps all the sums
+// identical to those of the full double loop.
+class AliGlauberCollider {
+public:
+  AliGlauberCollider() : fXA(), fYA(), fD2A(), fNCollA(), fXB(), fYB(), fD2B(), fNCollB(),
+                         fX0(0), fY0(0), fInvCell(0), fNX(0), fNY(0),
+                         fCellStart(), fSortX(), fSortY(), fSortD2(), fSortIdx(), fDist(), fHits() {}
+
+  void Fill(TObjArray *nucleons, Int_t n, Bool_t isA);
+  void Collide(Double_t d2, Bool_t fluc, Double_t &bNN, Double_t &nco, Double_t &ncohc);
+
+  std::vector<Double_t> fXA;      // x of the nucleons of A
+  std::vector<Double_t> fYA;      // y of the nucleons of A
+  std::vector<Double_t> fD2A;     // sigNN/(10 pi) of the nucleons of A
+  std::vector<Int_t>    fNCollA;  // number of collisions of the nucleons of A
+  std::vector<Double_t> fXB;      // same for B
+  std::vector<Double_t> fYB;
+  std::vector<Double_t> fD2B;
+  std::vector<Int_t>    fNCollB;
+
+private:
+  void BuildGrid(Double_t d2max);
+
+  Double_t fX0;                   // lower edge of the grid in x
+  Double_t fY0;                   // lower edge of the grid in y
+  Double_t fInvCell;              // inverse of the cell size
+  Int_t    fNX;                   // number of cells in x
+  Int_t    fNY;                   // number of cells in y
+  std::vector<Int_t>    fCellStart; // first sorted nucleon of each cell (fNX*fNY+1 entries)
+  std::vector<Double_t> fSortX;   // nucleons of A sorted by cell
+  std::vector<Double_t> fSortY;
+  std::vector<Double_t> fSortD2;
+  std::vector<Int_t>    fSortIdx; // index of the sorted nucleons in fXA
+  std::vector<Double_t> fDist;    // distances to the candidates of one nucleon of B
+  std::vector<std::pair<Int_t,Double_t> > fHits; // (index in A, distance) of the hits
+};
+
+//______________________________________________________________________________
+void AliGlauberCollider::Fill(TObjArray *nucleons, Int_t n, Bool_t isA)
+{
+  std::vector<Double_t> &x  = isA ? fXA : fXB;
+  std::vector<Double_t> &y  = isA ? fYA : fYB;
+  std::vector<Double_t> &d2 = isA ? fD2A : fD2B;
+  std::vector<Int_t> &ncoll = isA ? fNCollA : fNCollB;
+  x.resize(n);
+  y.resize(n);
+  d2.resize(n);
+  ncoll.assign(n, 0);
+  for (Int_t i = 0; i<n; i++)
+  {
+    AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(nucleons->UncheckedAt(i));
+    x[i]  = nucleon->GetX();
+    y[i]  = nucleon->GetY();
+    d2[i] = (Double_t)nucleon->GetSigNN()/(TMath::Pi()*10);
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberCollider::BuildGrid(Double_t d2max)
+{
+  // sort the nucleons of A into cells of size sqrt(d2max): two nucleons closer than that
+  // are at most one cell apart (the small margin covers the rounding of the cell index)
+
+  const Int_t kMaxCells = 64;
+  Int_t na = fXA.size();
+  Double_t xmin = fXA[0], xmax = fXA[0], ymin = fYA[0], ymax = fYA[0];
+  for (Int_t j = 1; j<na; j++)
+  {
+    xmin = TMath::Min(xmin, fXA[j]);
+    xmax = TMath::Max(xmax, fXA[j]);
+    ymin = TMath::Min(ymin, fYA[j]);
+    ymax = TMath::Max(ymax, fYA[j]);
+  }
+  Double_t cell = TMath::Sqrt(d2max)*(1+1e-9);
+  cell = TMath::Max(cell, TMath::Max(xmax-xmin, ymax-ymin)/(kMaxCells-1));
+  fX0 = xmin;
+  fY0 = ymin;
+  fInvCell = 1./cell;
+  fNX = TMath::Min(Int_t((xmax-xmin)*fInvCell)+1, kMaxCells);
+  fNY = TMath::Min(Int_t((ymax-ymin)*fInvCell)+1, kMaxCells);
+
+  std::vector<Int_t> cellOf(na);
+  fCellStart.assign(fNX*fNY+1, 0);
+  for (Int_t j = 0; j<na; j++)
+  {
+    Int_t ix = TMath::Min(Int_t((fXA[j]-fX0)*fInvCell), fNX-1);
+    Int_t iy = TMath::Min(Int_t((fYA[j]-fY0)*fInvCell), fNY-1);
+    cellOf[j] = iy*fNX+ix;
+    fCellStart[cellOf[j]+1]++;
+  }
+  for (Int_t c = 0; c<fNX*fNY; c++)
+    fCellStart[c+1] += fCellStart[c];
+
+  fSortX.resize(na);
+  fSortY.resize(na);
+  fSortD2.resize(na);
+  fSortIdx.resize(na);
+  std::vector<Int_t> next(fCellStart.begin(), fCellStart.end()-1);
+  for (Int_t j = 0; j<na; j++)
+  {
+    Int_t k = next[cellOf[j]]++;
+    fSortX[k]   = fXA[j];
+    fSortY[k]   = fYA[j];
+    fSortD2[k]  = fD2A[j];
+    fSortIdx[k] = j;
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberCollider::Collide(Double_t d2, Bool_t fluc, Double_t &bNN, Double_t &nco, Double_t &ncohc)
+{
+  // find all the colliding pairs; with fluc the interaction distance of a pair is given
+  // by the larger cross section of the two nucleons, otherwise by d2
+
+  Int_t na = fXA.size();
+  Int_t nb = fXB.size();
+  if (!na || !nb) return;
+
+  Double_t d2max = d2;
+  if (fluc)
+  {
+    d2max = 0;
+    for (Int_t j = 0; j<na; j++) d2max = TMath::Max(d2max, fD2A[j]);
+    for (Int_t i = 0; i<nb; i++) d2max = TMath::Max(d2max, fD2B[i]);
+  }
+  if (!(d2max>0)) return;
+  BuildGrid(d2max);
+  fDist.resize(na);
+
+  for (Int_t i = 0; i<nb; i++)
+  {
+    Double_t xb = fXB[i];
+    Double_t yb = fYB[i];
+    Double_t fx = TMath::Floor((xb-fX0)*fInvCell);
+    Double_t fy = TMath::Floor((yb-fY0)*fInvCell);
+    if (fx<-1 || fx>fNX || fy<-1 || fy>fNY) continue;
+    Int_t ix0 = TMath::Max(Int_t(fx)-1, 0), ix1 = TMath::Min(Int_t(fx)+1, fNX-1);
+    Int_t iy0 = TMath::Max(Int_t(fy)-1, 0), iy1 = TMath::Min(Int_t(fy)+1, fNY-1);
+    Double_t d2b = fluc ? fD2B[i] : d2;
+
+    fHits.clear();
+    for (Int_t iy = iy0; iy<=iy1; iy++)
+    {
+      Int_t kbeg = fCellStart[iy*fNX+ix0];
+      Int_t kend = fCellStart[iy*fNX+ix1+1];
+      const Double_t *sx = &fSortX[0];
+      const Double_t *sy = &fSortY[0];
+      Double_t *dist = &fDist[0];
+      for (Int_t k = kbeg; k<kend; k++)
+      {
+        Double_t dx = xb-sx[k];
+        Double_t dy = yb-sy[k];
+        dist[k] = dx*dx+dy*dy;
+      }
+      for (Int_t k = kbeg; k<kend; k++)
+      {
+        Double_t d2pair = fluc ? TMath::Max(fSortD2[k], d2b) : d2b;
+        if (dist[k] < d2pair)
+          fHits.push_back(std::make_pair(fSortIdx[k], dist[k]));
+      }
+    }
+    if (fHits.empty()) continue;
+
+    std::sort(fHits.begin(), fHits.end());
+    for (UInt_t h = 0; h<fHits.size(); h++)
+    {
+      Int_t j = fHits[h].first;
+      Double_t dij = fHits[h].second;
+      Double_t d2pair = fluc ? TMath::Max(fD2A[j], d2b) : d2b;
+      bNN += dij;
+      ++nco;
+      ++fNCollB[i];
+      ++fNCollA[j];
+      if (dij<d2pair/4)
+        ++ncohc;
+    }
+  }
+}
+
 //______________________________________________________________________________
 AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   TNamed(),
@@ -172,7 +376,25 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNThreads(1),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCDF(),
+  fCollider(0),
+  fOutDir(0),
+  fChunkSize(10000),
+  fColumns(),
+  fRow(),
+  fSaveParts(kFALSE),
+  fPartTree(0),
+  fPartEvent(0),
+  fPartN(0),
+  fPartX(),
+  fPartY(),
+  fPartZ(),
+  fPartNColl(),
+  fPartInA()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -188,7 +410,8 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
 AliGlauberMC::~AliGlauberMC()
 {
   //dtor
-  delete fnt;
+  Reset();
+  delete fCollider;
 }
 
 //______________________________________________________________________________
@@ -322,7 +545,25 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fNThreads(in.fNThreads),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCDF(),
+  fCollider(0),
+  fOutDir(0),
+  fChunkSize(in.fChunkSize),
+  fColumns(in.fColumns),
+  fRow(),
+  fSaveParts(in.fSaveParts),
+  fPartTree(0),
+  fPartEvent(0),
+  fPartN(0),
+  fPartX(),
+  fPartY(),
+  fPartZ(),
+  fPartNColl(),
+  fPartInA()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,21 +694,55 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNThreads=in.fNThreads;
+  fChunkSize=in.fChunkSize;
+  fColumns=in.fColumns;
+  fSaveParts=in.fSaveParts;
   return *this;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::InitSigFluc()
+{
+  // create the parameterization of the fluctuating sigNN
+  if (!fSigFluc) {
+    fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+    fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+    cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+  }
+  if (fRandom && fSigFlucCDF.empty())
+    AliGlauberNucleus::TabulateCDF(fSigFluc, fSigFlucX, fSigFlucCDF);
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::SampleSigNN()
+{
+  // fluctuating sigNN; TF1::GetRandom always uses gRandom, hence the table with fRandom
+  if (!fRandom) return fSigFluc->GetRandom();
+  return AliGlauberNucleus::SampleCDF(fSigFlucX, fSigFlucCDF, fRandom->Rndm());
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::SetRandom(TRandom* rnd)
+{
+  // use rnd instead of gRandom for all the random numbers of this generator
+  fRandom = rnd;
+  fSigFlucX.clear();
+  fSigFlucCDF.clear();
+  fANucleus.SetRandom(rnd);
+  fBNucleus.SetRandom(rnd);
+  if (fDoFluc) InitSigFluc();
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc)
+    InitSigFluc();
+  if (!fCollider)
+    fCollider = new AliGlauberCollider;
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
@@ -480,7 +755,7 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(SampleSigNN());
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
@@ -493,17 +768,11 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(SampleSigNN());
   }
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
-  }
+  if (fDoFluc)
+    fXSect = SampleSigNN();
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
@@ -511,32 +780,18 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
-  // for each of the A nucleons in nucleus B
+  // test all the pairs of nucleons of A and B
+  fCollider->Fill(fNucleonsA, fAN, kTRUE);
+  fCollider->Fill(fNucleonsB, fBN, kFALSE);
+  fCollider->Collide(d2, fDoFluc, bNN, Nco, Ncohc);
+  for (Int_t i = 0; i<fAN; i++)
+    ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i)))->SetNColl(fCollider->fNCollA[i]);
   for (Int_t i = 0; i<fBN; i++)
-  {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
-    {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
-      {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
-      }
-    }
+    ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->SetNColl(fCollider->fNCollB[i]);
+  if (fDoFluc && fAN>0 && fBN>0) {
+    // the cross section of the last pair tested, as left by the pair loop
+    fXSect = TMath::Max(((AliGlauberNucleon*)fNucleonsA->UncheckedAt(fAN-1))->GetSigNN(),
+                        ((AliGlauberNucleon*)fNucleonsB->UncheckedAt(fBN-1))->GetSigNN());
   }
 
   if (Nco>0) {
@@ -547,10 +802,6 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     fBNN    = 0.;
   }
 
-  if (Nco>0)
-    fBNN = bNN/Nco;
-  else
-    fBNN = 0.;
   return CalcResults(bgen);
 }
 
@@ -652,17 +903,19 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   fMeanr5Cos5PhiCom=0.;
   fMeanr5Sin5PhiCom=0.;
 
+  // the nucleon positions and collisions as flat arrays, filled in CalcEvent
+  const AliGlauberCollider &c = *fCollider;
+
   for (Int_t i = 0; i<fAN; i++)
   {
-    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
-    Double_t oXA = nucleonA->GetX();
-    Double_t oYA = nucleonA->GetY();
+    Double_t oXA = c.fXA[i];
+    Double_t oYA = c.fYA[i];
     //fMeanOXSystem  += oXA;
     //fMeanOYSystem  += oYA;
     fMeanOXA  += oXA;
     fMeanOYA  += oYA;
 
-    if(nucleonA->IsWounded())
+    if(c.fNCollA[i])
     {
       fONpart++;
       fMeanOXParts  += oXA;
@@ -676,13 +929,12 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 
   for (Int_t i = 0; i<fBN; i++)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    Double_t oXB=nucleonB->GetX();
-    Double_t oYB=nucleonB->GetY();
+    Double_t oXB=c.fXB[i];
+    Double_t oYB=c.fYB[i];
     
-    if(nucleonB->IsWounded())
+    if(c.fNCollB[i])
     {
-      Int_t oNcoll = nucleonB->GetNColl();
+      Int_t oNcoll = c.fNCollB[i];
       fONpart++;
       fMeanOXParts  += oXB;
       fMeanOXColl  += oXB*oNcoll;
@@ -731,9 +983,19 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   //////////////////////////////////////////////////////////////////
   for (Int_t i = 0; i<fAN; i++)
   {
-    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
-    Double_t xAA = nucleonA->GetX(); // X
-    Double_t yAA = nucleonA->GetY(); // Y
+    Double_t xAA = c.fXA[i]; // X
+    Double_t yAA = c.fYA[i]; // Y
+    fMeanXSystem  += xAA;
+    fMeanYSystem  += yAA;
+    fMeanXA  += xAA;
+    fMeanYA  += yAA;
+    fMeanX2 += xAA * xAA;
+    fMeanY2 += yAA * yAA;
+    fMeanXY += xAA * yAA;
+
+    // the moments only take the wounded nucleons
+    if(!c.fNCollA[i]) continue;
+
     Double_t xAPart = xAA - fMeanOXParts; // X'
     Double_t yAPart = yAA - fMeanOYParts; // Y'
     Double_t r2APart = xAPart *xAPart+yAPart*yAPart;     // r'^2
@@ -769,15 +1031,6 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
     Double_t sin5PhiACom = TMath::Sin(5.*phiACom);
     Double_t cos5PhiACom = TMath::Cos(5.*phiACom);   
     
-    fMeanXSystem  += xAA;
-    fMeanYSystem  += yAA;
-    fMeanXA  += xAA;
-    fMeanYA  += yAA;
-    fMeanX2 += xAA * xAA;
-    fMeanY2 += yAA * yAA;
-    fMeanXY += xAA * yAA;
-    
-    if(nucleonA->IsWounded())
      {
        //Wounded
       fNpart++;
@@ -836,9 +1089,18 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   
   for (Int_t i = 0; i<fBN; i++)
     {
-      AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-      Double_t xBB = nucleonB->GetX();
-      Double_t yBB = nucleonB->GetY();
+      Double_t xBB = c.fXB[i];
+      Double_t yBB = c.fYB[i];
+      fMeanXSystem  += xBB;
+      fMeanYSystem  += yBB;
+      fMeanXB  += xBB;
+      fMeanYB  += yBB;
+      fMeanX2 += xBB*xBB;
+      fMeanY2 += yBB*yBB;
+      fMeanXY += xBB*yBB;
+
+      if(!c.fNCollB[i]) continue;
+
       // for Wounded
       Double_t xBPart = xBB - fMeanOXParts; // X'
       Double_t yBPart = yBB - fMeanOYParts; // Y'
@@ -891,17 +1153,8 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
       Double_t sin5PhiBCom = TMath::Sin(5.*phiBCom);
       Double_t cos5PhiBCom = TMath::Cos(5.*phiBCom);   
       
-      fMeanXSystem  += xBB;
-      fMeanYSystem  += yBB;
-      fMeanXB  += xBB;
-      fMeanYB  += yBB;
-      fMeanX2 += xBB*xBB;
-      fMeanY2 += yBB*yBB;
-      fMeanXY += xBB*yBB;
-      
-      if(nucleonB->IsWounded())
 	{
-	  Int_t ncoll = nucleonB->GetNColl();
+	  Int_t ncoll = c.fNCollB[i];
 	  fNpart++;
 	  fMeanXParts  += xBPart;
 	  fMeanXColl  += xBColl*ncoll;
@@ -1267,7 +1520,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = Rng()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1531,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=Rng()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1561,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = Rng()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1759,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*Rng()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1681,21 +1934,155 @@ Double_t AliGlauberMC::GetPsi4m2() const
   return (TMath::Cos(4*(((TMath::ATan2(fMeanr4Sin4Phi,fMeanr4Cos4Phi)+TMath::Pi())/4)-((TMath::ATan2(fMeanr2Sin2Phi,fMeanr2Cos2Phi)+TMath::Pi())/2))));
 }
 */
+//______________________________________________________________________________
+void AliGlauberMC::SetColumns(const char *columns)
+{
+  // Write only the given colon-separated ntuple columns, e.g. "Npart:Ncoll:B:Epsl2".
+  // An empty list selects all the columns. Takes effect when the ntuple is created.
+
+  fColumns.clear();
+  TObjArray *tokens = TString(columns).Tokenize(":");
+  for (Int_t i = 0; i<tokens->GetEntries(); i++)
+  {
+    TString col = tokens->At(i)->GetName();
+    Int_t c = 0;
+    while (c<kNColumns && col!=kColumnNames[c]) c++;
+    if (c<kNColumns)
+      fColumns.push_back(c);
+    else
+      cout << "AliGlauberMC::SetColumns: unknown column " << col << ", ignored" << endl;
+  }
+  delete tokens;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::CreateOutput()
+{
+  // Create the ntuple with the selected columns and, if requested, the tree of the
+  // participants. Without output directory they stay in memory as before; with one,
+  // the baskets (one per column, fChunkSize events each) are written out as they fill.
+
+  TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
+  TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
+  if (fColumns.empty())
+    for (Int_t c = 0; c<kNColumns; c++) fColumns.push_back(c);
+  TString varlist;
+  for (UInt_t i = 0; i<fColumns.size(); i++)
+  {
+    if (i) varlist += ":";
+    varlist += kColumnNames[fColumns[i]];
+  }
+  fRow.resize(fColumns.size());
+
+  Int_t bufsize = fOutDir ? TMath::Max(Int_t(fChunkSize*sizeof(Float_t)), 8000) : 32000;
+  fnt = new TNtuple(name,title,varlist,bufsize);
+  fnt->SetDirectory(fOutDir);
+  if (fOutDir) fnt->SetAutoFlush(fChunkSize);
+
+  if (!fSaveParts) return;
+  // positions are rounded to 1/1024 fm, which keeps the low mantissa bits at 0 and the
+  // baskets compressible
+  Int_t nmax = fANucleus.GetN()+fBNucleus.GetN();
+  fPartX.resize(nmax);
+  fPartY.resize(nmax);
+  fPartZ.resize(nmax);
+  fPartNColl.resize(nmax);
+  fPartInA.resize(nmax);
+  fPartTree = new TTree(Form("parts_%s_%s",fANucleus.GetName(),fBNucleus.GetName()),
+                        Form("%s participants (x,y,z in fm, 1/1024 fm precision)",title.Data()));
+  fPartTree->SetDirectory(fOutDir);
+  fPartTree->Branch("event",&fPartEvent,"event/I");
+  fPartTree->Branch("n",&fPartN,"n/I");
+  fPartTree->Branch("x",&fPartX[0],"x[n]/F");
+  fPartTree->Branch("y",&fPartY[0],"y[n]/F");
+  fPartTree->Branch("z",&fPartZ[0],"z[n]/F");
+  fPartTree->Branch("ncoll",&fPartNColl[0],"ncoll[n]/s");
+  fPartTree->Branch("inA",&fPartInA[0],"inA[n]/b");
+  if (fOutDir) fPartTree->SetAutoFlush(fChunkSize);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::GetParticipants(std::vector<Float_t> &buf) const
+{
+  // append the participants of the current event to buf as n, then x, y, z, ncoll, inA for each
+  Int_t first = buf.size();
+  buf.push_back(0);
+  for (Int_t i = 0; i<fAN+fBN; i++)
+  {
+    AliGlauberNucleon *nucleon = (AliGlauberNucleon*)(i<fAN ? fNucleonsA->UncheckedAt(i) : fNucleonsB->UncheckedAt(i-fAN));
+    if (!nucleon->IsWounded()) continue;
+    buf.push_back(nucleon->GetX());
+    buf.push_back(nucleon->GetY());
+    buf.push_back(nucleon->GetZ());
+    buf.push_back(nucleon->GetNColl());
+    buf.push_back(i<fAN);
+    buf[first]++;
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FillOutput(const Float_t *v, const Float_t *parts)
+{
+  // fill the selected columns of the full row v and the participants packed by GetParticipants
+  for (UInt_t i = 0; i<fColumns.size(); i++)
+    fRow[i] = v[fColumns[i]];
+  fnt->Fill(&fRow[0]);
+  if (!fPartTree || !parts) return;
+
+  fPartEvent = fnt->GetEntries()-1;
+  fPartN = TMath::Min(Int_t(parts[0]), Int_t(fPartX.size()));
+  for (Int_t i = 0; i<fPartN; i++)
+  {
+    const Float_t *p = parts+1+5*i;
+    fPartX[i] = TMath::Nint(p[0]*1024)/1024.;
+    fPartY[i] = TMath::Nint(p[1]*1024)/1024.;
+    fPartZ[i] = TMath::Nint(p[2]*1024)/1024.;
+    fPartNColl[i] = UShort_t(p[3]);
+    fPartInA[i] = UChar_t(p[4]);
+  }
+  fPartTree->Fill();
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::WriteOutput()
+{
+  // Write the output trees to fOutDir. They belong to the directory, which the caller
+  // may close or delete after Run: forget them and the directory, so that the next Run
+  // starts new trees (in memory, unless SetOutput is called again).
+  if (!fOutDir) return;
+  TDirectory *savedir = gDirectory;
+  fOutDir->cd();
+  fnt->Write(0, TObject::kOverwrite);
+  if (fPartTree) fPartTree->Write(0, TObject::kOverwrite);
+  savedir->cd();
+  fnt = 0;
+  fPartTree = 0;
+  fOutDir = 0;
+}
+
 //______________________________________________________________________________
 void AliGlauberMC::Run(Int_t nevents)
 {
   //example run
   cout << "Generating " << nevents << " events..." << endl;
-  TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
-  TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
   if (fnt == 0)
+    CreateOutput();
+  else if (fOutDir && fnt->GetDirectory()!=fOutDir)
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    // trees kept in memory by a previous Run: move them to the output directory
+    fnt->SetDirectory(fOutDir);
+    if (fPartTree) fPartTree->SetDirectory(fOutDir);
   }
+  if (fNThreads>1)
+  {
+    RunParallel(nevents);
+    WriteOutput();
+    return;
+  }
+
   Int_t q = 0;
   Int_t u = 0;
+  std::vector<Float_t> parts;
   for (Int_t i = 0; i<nevents; i++)
   {
 
@@ -1706,73 +2093,191 @@ void AliGlauberMC::Run(Int_t nevents)
     }
 
     q++;
-    Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
+    Float_t v[kNColumns];
+    GetEventRow(v);
+    parts.clear();
+    if (fPartTree) GetParticipants(parts);
+
+    //always at the end
+    FillOutput(v, fPartTree ? &parts[0] : 0);
+
+    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  }
+  WriteOutput();
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::GetEventRow(Float_t *v)
+{
+  // fill all the kNColumns ntuple columns for the current event
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunParallel(Int_t nevents)
+{
+  // Run the events in fNThreads threads. Each thread has its own copy of the
+  // generator and its own TRandom3, seeded from the generator of this one, so that
+  // a given seed, number of threads and chunk size always give the same ntuple.
+  // The events are generated in batches of fChunkSize events per thread; after each
+  // batch the rows are added to the output thread by thread, so that the memory use
+  // does not grow with the number of events.
+
+  Int_t nthreads = TMath::Max(1, TMath::Min(fNThreads, nevents));
+  Int_t chunk = TMath::Max(1, fChunkSize);
+  if (fDoFluc) InitSigFluc();
+
+  std::vector<AliGlauberMC*> workers(nthreads);
+  std::vector<TRandom3*> rndms(nthreads);
+  std::vector<std::vector<Float_t> > rows(nthreads);
+  std::vector<std::vector<Float_t> > parts(nthreads);
+  std::vector<Int_t> discarded(nthreads, 0);
+  Bool_t saveParts = (fPartTree!=0);
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    // TF1 and TObject creation is not thread safe: set up everything here
+    AliGlauberMC *w = new AliGlauberMC(fANucleus.GetName(), fBNucleus.GetName(), fXSect);
+    w->fANucleus.SetR(fANucleus.GetR());
+    w->fANucleus.SetA(fANucleus.GetA());
+    w->fANucleus.SetW(fANucleus.GetW());
+    w->fANucleus.SetMinDist(fANucleus.GetMinDist());
+    w->fBNucleus.SetR(fBNucleus.GetR());
+    w->fBNucleus.SetA(fBNucleus.GetA());
+    w->fBNucleus.SetW(fBNucleus.GetW());
+    w->fBNucleus.SetMinDist(fBNucleus.GetMinDist());
+    w->fBMin = fBMin;
+    w->fBMax = fBMax;
+    memcpy(w->fdNdEtaParam,fdNdEtaParam,sizeof(fdNdEtaParam));
+    w->fMultType = fMultType;
+    w->fX = fX;
+    w->fNpp = fNpp;
+    w->fDoPartProd = fDoPartProd;
+    w->fDoFluc = fDoFluc;
+    w->fOmega = fOmega;
+    w->fSig0 = fSig0;
+    w->fLambda = fLambda;
+    w->fSigFluc = fSigFluc;
+    rndms[t] = new TRandom3(1+Rng()->Integer(kMaxInt));
+    w->SetRandom(rndms[t]);
+    w->fCollider = new AliGlauberCollider;
+    w->fANucleus.ThrowNucleons();
+    w->fBNucleus.ThrowNucleons();
+    workers[t] = w;
+  }
+
+  Int_t q = 0;
+  Int_t u = 0;
+  for (Int_t done = 0; done<nevents; )
+  {
+    Int_t nbatch = TMath::Min(nevents-done, nthreads*chunk);
+    std::vector<std::thread> threads;
+    for (Int_t t = 0; t<nthreads; t++)
     {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
+      Int_t nevt = Long64_t(nbatch)*(t+1)/nthreads - Long64_t(nbatch)*t/nthreads;
+      rows[t].clear();
+      parts[t].clear();
+      threads.push_back(std::thread([&workers, &rows, &parts, &discarded, t, nevt, saveParts]() {
+        Float_t v[kNColumns];
+        for (Int_t i = 0; i<nevt; i++)
+        {
+          if (!workers[t]->NextEvent())
+          {
+            discarded[t]++;
+            continue;
+          }
+          workers[t]->GetEventRow(v);
+          rows[t].insert(rows[t].end(), v, v+kNColumns);
+          if (saveParts) workers[t]->GetParticipants(parts[t]);
+        }
+      }));
     }
-    else
+    for (Int_t t = 0; t<nthreads; t++)
+      threads[t].join();
+
+    for (Int_t t = 0; t<nthreads; t++)
     {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
+      UInt_t p = 0;
+      for (UInt_t r = 0; r<rows[t].size(); r += kNColumns)
+      {
+        FillOutput(&rows[t][r], saveParts ? &parts[t][p] : 0);
+        if (saveParts) p += 1+5*Int_t(parts[t][p]);
+      }
+      q += rows[t].size()/kNColumns;
     }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
-
-    //always at the end
-    fnt->Fill(v);
+    done += nbatch;
+    std::cout << "Generating Event # " << done << "... \r" << flush;
+  }
 
-    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    u += discarded[t];
+    fEvents += workers[t]->fEvents;
+    fTotalEvents += workers[t]->fTotalEvents;
+    fMaxNpartFound = TMath::Max(fMaxNpartFound, workers[t]->fMaxNpartFound);
+    workers[t]->fSigFluc = 0;
+    delete workers[t];
+    delete rndms[t];
   }
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
@@ -1792,10 +2297,9 @@ void AliGlauberMC::RunAndSaveNtuple( Int_t n,
   mcg.SetMinDistance(mind);
   mcg.Setr(r);
   mcg.Seta(a);
-  mcg.Run(n);
-  TNtuple  *nt=mcg.GetNtuple();
   TFile out(fname,"recreate",fname,9);
-  if(nt) nt->Write();
+  mcg.SetOutput(&out);
+  mcg.Run(n);
   printf("total cross section with a nucleon-nucleon cross section \t%f is \t%f",signn,mcg.GetTotXSect());
   out.Close();
 }
@@ -1853,7 +2357,11 @@ void AliGlauberMC::RunAndSaveNucleons( Int_t n,
 //---------------------------------------------------------------------------------
 void AliGlauberMC::Reset()
 {
-  //delete the ntuple
-  delete fnt;
+  //delete the ntuple (unless it belongs to a directory)
+  if (fnt && !fnt->GetDirectory())
+    delete fnt;
+  if (fPartTree && !fPartTree->GetDirectory())
+    delete fPartTree;
   fnt=NULL;
+  fPartTree=NULL;
 }
@@ -16,9 +16,14 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <TRandom.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TTree;
+class TDirectory;
+class AliGlauberCollider;
 
 using std::cout;
 using std::endl;
@@ -79,6 +84,7 @@ public:
    Int_t        GetNpart()           const {return fNpart;}
    Int_t        GetNpartFound()      const {return fMaxNpartFound;}
    TNtuple*     GetNtuple()          const {return fnt;}
+   TTree*       GetParticipantTree() const {return fPartTree;}
    TObjArray   *GetNucleons();
    Double_t     GetTotXSect()        const;
    Double_t     GetTotXSectErr()     const;
@@ -100,6 +106,11 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetNThreads(Int_t n)        {fNThreads = n;}
+   void   SetRandom(TRandom* rnd);
+   void   SetColumns(const char *columns);
+   void   SetOutput(TDirectory *dir, Int_t chunk=10000) {fOutDir = dir; fChunkSize = chunk;}
+   void   SetSaveParticipants(Bool_t b=kTRUE) {fSaveParts = b;}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,7 +262,34 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNThreads;       //!number of threads used by Run
+   TRandom     *fRandom;         //!random number generator (gRandom if not set)
+   std::vector<Double_t> fSigFlucX;   //!abscissae of the tabulated fSigFluc
+   std::vector<Double_t> fSigFlucCDF; //!cumulative of the tabulated fSigFluc
+   AliGlauberCollider *fCollider; //!flat nucleon arrays and collision finder
+   TDirectory  *fOutDir;         //!directory of the output trees of the next Run (kept in memory if 0)
+   Int_t        fChunkSize;      //!number of events per basket of the output trees
+   std::vector<Int_t> fColumns;  //!written ntuple columns (all if empty)
+   std::vector<Float_t> fRow;    //!values of the written columns
+   Bool_t       fSaveParts;      //!=kTRUE then write the participants to fPartTree
+   TTree       *fPartTree;       //!participants, one entry per ntuple entry
+   Int_t        fPartEvent;      //!ntuple entry of the participants
+   Int_t        fPartN;          //!number of participants
+   std::vector<Float_t> fPartX;  //!x of the participants
+   std::vector<Float_t> fPartY;  //!y of the participants
+   std::vector<Float_t> fPartZ;  //!z of the participants
+   std::vector<UShort_t> fPartNColl; //!number of collisions of the participants
+   std::vector<UChar_t> fPartInA; //!=1 for the participants of nucleus A
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     SampleSigNN();
+   void         GetEventRow(Float_t *v);
+   void         GetParticipants(std::vector<Float_t> &buf) const;
+   void         CreateOutput();
+   void         FillOutput(const Float_t *v, const Float_t *parts);
+   void         WriteOutput();
+   void         RunParallel(Int_t nevents);
+   TRandom     *Rng() const {return fRandom ? fRandom : gRandom;}
 
    ClassDef(AliGlauberMC,4)
 };
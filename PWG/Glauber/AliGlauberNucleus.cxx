@@ -49,7 +49,10 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(0),
+  fRadiusX(),
+  fRadiusCDF()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -77,7 +80,10 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fF(in.fF),
   fTrials(in.fTrials),
   fFunction(in.fFunction),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(0),
+  fRadiusX(),
+  fRadiusCDF()
 {
   //copy ctor
   if (in.fNucleons)
@@ -97,6 +103,9 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fF=in.fF;
   fTrials=in.fTrials;
   fFunction=in.fFunction;
+  fRandom=0;
+  fRadiusX.clear();
+  fRadiusCDF.clear();
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -225,6 +234,73 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+void AliGlauberNucleus::SetRandom(TRandom* rnd)
+{
+   // Use the given generator instead of gRandom. The radial distribution is then
+   // sampled from a table built here rather than with TF1::GetRandom (which always
+   // uses gRandom), so that nuclei with different generators can be thrown in
+   // parallel. Passing 0 restores the default behaviour.
+
+   fRandom = rnd;
+   fRadiusX.clear();
+   fRadiusCDF.clear();
+   if (fRandom && fFunction)
+      TabulateCDF(fFunction, fRadiusX, fRadiusCDF);
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::Uniform() const
+{
+   return fRandom ? fRandom->Rndm() : gRandom->Rndm();
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::SampleRadius()
+{
+   if (!fRandom) return fFunction->GetRandom();
+   return SampleCDF(fRadiusX, fRadiusCDF, fRandom->Rndm());
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::TabulateCDF(TF1* f, std::vector<Double_t>& x, std::vector<Double_t>& cdf, Int_t npx)
+{
+   // Tabulate the normalised cumulative of f over its range (trapezoidal rule)
+
+   Double_t xmin = 0, xmax = 0;
+   f->GetRange(xmin, xmax);
+   x.resize(npx+1);
+   cdf.resize(npx+1);
+   Double_t dx = (xmax-xmin)/npx;
+   Double_t fprev = TMath::Max(f->Eval(xmin), 0.);
+   x[0] = xmin;
+   cdf[0] = 0;
+   for (Int_t i = 1; i<=npx; i++) {
+      x[i] = xmin + i*dx;
+      Double_t fi = TMath::Max(f->Eval(x[i]), 0.);
+      cdf[i] = cdf[i-1] + 0.5*(fprev+fi)*dx;
+      fprev = fi;
+   }
+   if (cdf[npx]>0) {
+      for (Int_t i = 1; i<=npx; i++)
+         cdf[i] /= cdf[npx];
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::SampleCDF(const std::vector<Double_t>& x, const std::vector<Double_t>& cdf, Double_t u)
+{
+   // Invert a table made by TabulateCDF for u in [0,1), linear within a bin
+
+   Int_t n = cdf.size();
+   if (n<2) return 0;
+   Int_t i = TMath::BinarySearch(n, &cdf[0], u);
+   if (i<0) return x[0];
+   if (i>=n-1) return x[n-1];
+   Double_t w = cdf[i+1]-cdf[i];
+   return (w>0) ? x[i] + (x[i+1]-x[i])*(u-cdf[i])/w : x[i];
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
@@ -246,9 +322,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = SampleRadius()/2;
+      Double_t phi = Uniform() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*Uniform() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +346,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = SampleRadius();
+         Double_t phi = Uniform() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*Uniform() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -16,8 +16,10 @@
 
 //class TNamed;
 #include <TNamed.h>
+#include <vector>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,13 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Random number generator (gRandom if not set)
+   std::vector<Double_t> fRadiusX;   //!Abscissae of the tabulated rho(r)
+   std::vector<Double_t> fRadiusCDF; //!Cumulative of the tabulated rho(r)
 
    void       Lookup(Option_t* name);
+   Double_t   Uniform() const;
+   Double_t   SampleRadius();
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -47,13 +54,18 @@ public:
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
+   Double_t   GetMinDist()       const {return fMinDist;}
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom* rnd);
    void       ThrowNucleons(Double_t xshift=0.);
 
+   static void     TabulateCDF(TF1* f, std::vector<Double_t>& x, std::vector<Double_t>& cdf, Int_t npx=2000);
+   static Double_t SampleCDF(const std::vector<Double_t>& x, const std::vector<Double_t>& cdf, Double_t u);
+
    ClassDef(AliGlauberNucleus,1)
 };
 
@@ -13,6 +13,7 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 #include "AliEmcalJet.h"
+#include "AliEmcalJetConstituentBlock.h"
 
 #include "AliLog.h"
 #include "Riostream.h"
@@ -64,7 +65,8 @@ AliEmcalJet::AliEmcalJet() :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fConstituentBlock(nullptr)
 {
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
@@ -116,7 +118,8 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fConstituentBlock(nullptr)
 {
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
@@ -173,7 +176,8 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fConstituentBlock(nullptr)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
@@ -224,7 +228,8 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fJetShapeProperties(0),
   fJetAcceptanceType(jet.fJetAcceptanceType),
   fParticleConstituents(jet.fParticleConstituents),
-  fClusterConstituents(jet.fClusterConstituents)
+  fClusterConstituents(jet.fClusterConstituents),
+  fConstituentBlock(nullptr)
 
 {
   // Copy constructor.
@@ -236,6 +241,10 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   if (jet.fJetShapeProperties) {
     fJetShapeProperties = new AliEmcalJetShapeProperties(*(jet.fJetShapeProperties));
   }
+
+  if (jet.fConstituentBlock) {
+    fConstituentBlock = new PWG::JETFW::AliEmcalJetConstituentBlock(*(jet.fConstituentBlock));
+  }
 }
 
 /**
@@ -244,6 +253,7 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
 AliEmcalJet::~AliEmcalJet()
 {
   if (fJetShapeProperties) delete fJetShapeProperties;
+  if (fConstituentBlock) delete fConstituentBlock;
 }
 
 /**
@@ -296,6 +306,13 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
     fJetAcceptanceType  = jet.fJetAcceptanceType;
     fParticleConstituents = jet.fParticleConstituents;
     fClusterConstituents = jet.fClusterConstituents;
+    if (fConstituentBlock) {
+      delete fConstituentBlock;
+      fConstituentBlock = nullptr;
+    }
+    if (jet.fConstituentBlock) {
+      fConstituentBlock = new PWG::JETFW::AliEmcalJetConstituentBlock(*(jet.fConstituentBlock));
+    }
   }
 
   return *this;
@@ -677,6 +694,20 @@ void AliEmcalJet::Clear(Option_t */*option*/)
   fHasGhost = kFALSE;
   fClusterConstituents.clear();
   fParticleConstituents.clear();
+  if (fConstituentBlock) fConstituentBlock->Clear();
+}
+
+/**
+ * Create the packed constituent block. In case the block already exists
+ * it is cleared. The jet axis of the block is set to the current jet axis.
+ * @return The (empty) constituent block
+ */
+PWG::JETFW::AliEmcalJetConstituentBlock *AliEmcalJet::CreateConstituentBlock()
+{
+  if (fConstituentBlock) fConstituentBlock->Clear();
+  else fConstituentBlock = new PWG::JETFW::AliEmcalJetConstituentBlock;
+  fConstituentBlock->SetJetAxis(fEta, fPhi);
+  return fConstituentBlock;
 }
 
 /**
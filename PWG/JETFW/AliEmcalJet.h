@@ -23,6 +23,12 @@
 #include "AliEmcalClusterJetConstituent.h"
 #include "AliEmcalParticleJetConstituent.h"
 
+namespace PWG {
+namespace JETFW {
+class AliEmcalJetConstituentBlock;
+}
+}
+
 /**
  * @class AliEmcalJet
  * @brief Represent a jet reconstructed using the EMCal jet framework
@@ -241,6 +247,21 @@ class AliEmcalJet : public AliVParticle
    */
   bool HasParticleConstituent(const AliVParticle *const part) const;
 
+  /**
+   * @brief Get the packed constituent block (if filled by the jet finder)
+   *
+   * The block contains the constituent kinematics in contiguous arrays and
+   * can be used with the jet shape kernels (AliEmcalJetShapeKernels).
+   * @return Constituent block (nullptr if not created)
+   */
+  const PWG::JETFW::AliEmcalJetConstituentBlock *GetConstituentBlock() const { return fConstituentBlock; }
+
+  /**
+   * @brief Create (or reset) the packed constituent block
+   * @return The (empty) constituent block
+   */
+  PWG::JETFW::AliEmcalJetConstituentBlock *CreateConstituentBlock();
+
   // Fragmentation function
   Double_t          GetZ(const Double_t trkPx, const Double_t trkPy, const Double_t trkPz)  const;
   Double_t          GetZ(const AliVParticle* trk )                                          const;
@@ -421,6 +442,7 @@ class AliEmcalJet : public AliVParticle
 
   std::vector<PWG::JETFW::AliEmcalParticleJetConstituent>      fParticleConstituents;  ///< List of particle constituents
   std::vector<PWG::JETFW::AliEmcalClusterJetConstituent>       fClusterConstituents;   ///< List of cluster constituents
+  PWG::JETFW::AliEmcalJetConstituentBlock                     *fConstituentBlock;      //!<! Packed constituent kinematics (optional)
 
  private:
   /**
@@ -0,0 +1,88 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEmcalJetConstituentBlock.h"
+
+namespace PWG {
+
+namespace JETFW {
+
+AliEmcalJetConstituentBlock::AliEmcalJetConstituentBlock():
+  fAxisEta(0.),
+  fAxisPhi(0.),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fM(),
+  fDeltaR(),
+  fCharge(),
+  fLabel()
+{
+}
+
+void AliEmcalJetConstituentBlock::Reserve(UInt_t n){
+  fPt.reserve(n);
+  fEta.reserve(n);
+  fPhi.reserve(n);
+  fM.reserve(n);
+  fDeltaR.reserve(n);
+  fCharge.reserve(n);
+  fLabel.reserve(n);
+}
+
+void AliEmcalJetConstituentBlock::Clear(){
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fM.clear();
+  fDeltaR.clear();
+  fCharge.clear();
+  fLabel.clear();
+}
+
+void AliEmcalJetConstituentBlock::AddConstituent(Double_t pt, Double_t eta, Double_t phi, Double_t m, Short_t charge, Int_t label){
+  Double_t deta = eta - fAxisEta, dphi = TVector2::Phi_mpi_pi(phi - fAxisPhi);
+  fPt.push_back(pt);
+  fEta.push_back(eta);
+  fPhi.push_back(phi);
+  fM.push_back(m);
+  fDeltaR.push_back(TMath::Sqrt(deta * deta + dphi * dphi));
+  fCharge.push_back(charge);
+  fLabel.push_back(label);
+}
+
+UInt_t AliEmcalJetConstituentBlock::GetNumberOfChargedConstituents() const {
+  UInt_t ncharged = 0;
+  for(auto charge : fCharge) if(charge != 0) ncharged++;
+  return ncharged;
+}
+
+}
+
+}
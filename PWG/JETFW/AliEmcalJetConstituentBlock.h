@@ -0,0 +1,151 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETCONSTITUENTBLOCK_H
+#define ALIEMCALJETCONSTITUENTBLOCK_H
+
+#include <vector>
+#include <Rtypes.h>
+
+namespace PWG {
+
+namespace JETFW {
+
+/**
+ * @class AliEmcalJetConstituentBlock
+ * @brief Packed kinematics of the constituents of a jet
+ * @ingroup JETFW
+ *
+ * Optional per-jet block storing the constituent kinematics (pt, eta, phi, mass),
+ * the charge and the MC label in contiguous arrays (structure of arrays). The block
+ * is filled by the jet finder when the jet is created, so that jet shape algorithms
+ * (see AliEmcalJetShapeKernels) can run over the constituents without dereferencing
+ * each of them through the particle / cluster containers.
+ *
+ * In addition to the kinematics the distance \f$ \Delta R \f$ of each constituent to
+ * the jet axis is stored. It is calculated with respect to the axis set via SetJetAxis
+ * at the moment the constituent is added.
+ *
+ * The block is a transient object and not written to file.
+ */
+class AliEmcalJetConstituentBlock {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalJetConstituentBlock();
+
+  /**
+   * @brief Destructor
+   */
+  ~AliEmcalJetConstituentBlock() {}
+
+  /**
+   * @brief Set the jet axis used for the calculation of the distance \f$ \Delta R \f$
+   * @param[in] eta Pseudorapidity of the jet axis
+   * @param[in] phi Azimuthal angle of the jet axis
+   */
+  void SetJetAxis(Double_t eta, Double_t phi) { fAxisEta = eta; fAxisPhi = phi; }
+
+  /**
+   * @brief Reserve space for a given number of constituents
+   * @param[in] n Expected number of constituents
+   */
+  void Reserve(UInt_t n);
+
+  /**
+   * @brief Remove all constituents (keeping the allocated memory)
+   */
+  void Clear();
+
+  /**
+   * @brief Append a constituent to the block
+   * @param[in] pt Transverse momentum
+   * @param[in] eta Pseudorapidity
+   * @param[in] phi Azimuthal angle
+   * @param[in] m Mass
+   * @param[in] charge Charge (0 for clusters)
+   * @param[in] label MC label
+   */
+  void AddConstituent(Double_t pt, Double_t eta, Double_t phi, Double_t m, Short_t charge, Int_t label);
+
+  /**
+   * @brief Get the number of constituents in the block
+   * @return Number of constituents
+   */
+  UInt_t GetNumberOfConstituents() const { return fPt.size(); }
+
+  /**
+   * @brief Get the number of charged constituents in the block
+   * @return Number of constituents with non-zero charge
+   */
+  UInt_t GetNumberOfChargedConstituents() const;
+
+  /**
+   * @brief Get the pseudorapidity of the jet axis used for \f$ \Delta R \f$
+   * @return Pseudorapidity of the jet axis
+   */
+  Double_t GetAxisEta() const { return fAxisEta; }
+
+  /**
+   * @brief Get the azimuthal angle of the jet axis used for \f$ \Delta R \f$
+   * @return Azimuthal angle of the jet axis
+   */
+  Double_t GetAxisPhi() const { return fAxisPhi; }
+
+  /**
+   * @brief Access to the contiguous constituent arrays
+   *
+   * All arrays have GetNumberOfConstituents() entries, in the order
+   * in which the constituents were added. nullptr for empty blocks.
+   * @return Pointer to the first element of the array
+   */
+  const Float_t *GetPt() const { return fPt.empty() ? nullptr : &fPt[0]; }
+  const Float_t *GetEta() const { return fEta.empty() ? nullptr : &fEta[0]; }
+  const Float_t *GetPhi() const { return fPhi.empty() ? nullptr : &fPhi[0]; }
+  const Float_t *GetM() const { return fM.empty() ? nullptr : &fM[0]; }
+  const Float_t *GetDeltaR() const { return fDeltaR.empty() ? nullptr : &fDeltaR[0]; }
+  const Short_t *GetCharge() const { return fCharge.empty() ? nullptr : &fCharge[0]; }
+  const Int_t   *GetLabel() const { return fLabel.empty() ? nullptr : &fLabel[0]; }
+
+private:
+  Double_t                fAxisEta;       ///< Pseudorapidity of the jet axis
+  Double_t                fAxisPhi;       ///< Azimuthal angle of the jet axis
+  std::vector<Float_t>    fPt;            ///< Constituent transverse momentum
+  std::vector<Float_t>    fEta;           ///< Constituent pseudorapidity
+  std::vector<Float_t>    fPhi;           ///< Constituent azimuthal angle
+  std::vector<Float_t>    fM;             ///< Constituent mass
+  std::vector<Float_t>    fDeltaR;        ///< Distance of the constituent to the jet axis
+  std::vector<Short_t>    fCharge;        ///< Constituent charge
+  std::vector<Int_t>      fLabel;         ///< Constituent MC label
+};
+
+}
+
+}
+
+#endif /* ALIEMCALJETCONSTITUENTBLOCK_H */
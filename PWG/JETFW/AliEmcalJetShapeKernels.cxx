@@ -0,0 +1,135 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <TMath.h>
+
+#include "AliEmcalJetConstituentBlock.h"
+#include "AliEmcalJetShapeKernels.h"
+
+namespace PWG {
+
+namespace JETFW {
+
+Double_t AliEmcalJetShapeKernels::Girth(const AliEmcalJetConstituentBlock &block, Double_t jetpt){
+  const UInt_t n = block.GetNumberOfConstituents();
+  if(!n || jetpt <= 0.) return 0.;
+  const Float_t *pt = block.GetPt(), *dr = block.GetDeltaR();
+  Double_t sum = 0.;
+  for(UInt_t i = 0; i < n; i++) sum += pt[i] * dr[i];
+  return sum / jetpt;
+}
+
+Double_t AliEmcalJetShapeKernels::PtD(const AliEmcalJetConstituentBlock &block){
+  const UInt_t n = block.GetNumberOfConstituents();
+  if(!n) return 0.;
+  const Float_t *pt = block.GetPt();
+  Double_t sumpt = 0., sumpt2 = 0.;
+  for(UInt_t i = 0; i < n; i++){
+    sumpt += pt[i];
+    sumpt2 += pt[i] * pt[i];
+  }
+  return sumpt > 0. ? TMath::Sqrt(sumpt2) / sumpt : 0.;
+}
+
+Double_t AliEmcalJetShapeKernels::Angularity(const AliEmcalJetConstituentBlock &block, Double_t jetpt, Double_t jetR, Double_t kappa, Double_t beta){
+  const UInt_t n = block.GetNumberOfConstituents();
+  if(!n || jetpt <= 0. || jetR <= 0.) return 0.;
+  const Float_t *pt = block.GetPt(), *dr = block.GetDeltaR();
+  const Double_t invpt = 1. / jetpt, invr = 1. / jetR;
+  Double_t sum = 0.;
+  if(kappa == 1. && beta == 1.){
+    // most common case (girth-like angularity), avoids the power function
+    for(UInt_t i = 0; i < n; i++) sum += pt[i] * dr[i];
+    return sum * invpt * invr;
+  }
+  for(UInt_t i = 0; i < n; i++) sum += TMath::Power(pt[i] * invpt, kappa) * TMath::Power(dr[i] * invr, beta);
+  return sum;
+}
+
+Double_t AliEmcalJetShapeKernels::LeSub(const AliEmcalJetConstituentBlock &block, Bool_t chargedOnly){
+  const UInt_t n = block.GetNumberOfConstituents();
+  const Float_t *pt = block.GetPt();
+  const Short_t *charge = block.GetCharge();
+  Double_t lead = -1., sublead = -1.;
+  for(UInt_t i = 0; i < n; i++){
+    if(chargedOnly && !charge[i]) continue;
+    if(pt[i] > lead){
+      sublead = lead;
+      lead = pt[i];
+    } else if(pt[i] > sublead) {
+      sublead = pt[i];
+    }
+  }
+  return sublead < 0. ? 0. : lead - sublead;
+}
+
+Double_t AliEmcalJetShapeKernels::RadialMoment(const AliEmcalJetConstituentBlock &block, Int_t order){
+  const UInt_t n = block.GetNumberOfConstituents();
+  if(!n) return 0.;
+  const Float_t *pt = block.GetPt(), *dr = block.GetDeltaR();
+  Double_t sumpt = 0., sum = 0.;
+  for(UInt_t i = 0; i < n; i++){
+    Double_t drn = 1.;
+    for(Int_t iord = 0; iord < order; iord++) drn *= dr[i];
+    sumpt += pt[i];
+    sum += pt[i] * drn;
+  }
+  return sumpt > 0. ? sum / sumpt : 0.;
+}
+
+void AliEmcalJetShapeKernels::ComputeShapes(const AliEmcalJetConstituentBlock &block, Double_t jetpt, JetShapes_t &shapes){
+  const UInt_t n = block.GetNumberOfConstituents();
+  shapes.fNConstituents = n;
+  shapes.fGirth = shapes.fPtD = shapes.fLeSub = shapes.fRadialMoment2 = shapes.fSumPt = 0.;
+  if(!n) return;
+
+  const Float_t *pt = block.GetPt(), *dr = block.GetDeltaR();
+  Double_t sumpt = 0., sumpt2 = 0., sumptdr = 0., sumptdr2 = 0., lead = -1., sublead = -1.;
+  for(UInt_t i = 0; i < n; i++){
+    const Double_t ptdr = pt[i] * dr[i];
+    sumpt += pt[i];
+    sumpt2 += pt[i] * pt[i];
+    sumptdr += ptdr;
+    sumptdr2 += ptdr * dr[i];
+    if(pt[i] > lead){
+      sublead = lead;
+      lead = pt[i];
+    } else if(pt[i] > sublead) {
+      sublead = pt[i];
+    }
+  }
+  shapes.fSumPt = sumpt;
+  if(jetpt > 0.) shapes.fGirth = sumptdr / jetpt;
+  if(sumpt > 0.){
+    shapes.fPtD = TMath::Sqrt(sumpt2) / sumpt;
+    shapes.fRadialMoment2 = sumptdr2 / sumpt;
+  }
+  if(sublead >= 0.) shapes.fLeSub = lead - sublead;
+}
+
+}
+
+}
@@ -0,0 +1,128 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETSHAPEKERNELS_H
+#define ALIEMCALJETSHAPEKERNELS_H
+
+#include <Rtypes.h>
+
+namespace PWG {
+
+namespace JETFW {
+
+class AliEmcalJetConstituentBlock;
+
+/**
+ * @class AliEmcalJetShapeKernels
+ * @brief Jet shape observables evaluated on packed constituent blocks
+ * @ingroup JETFW
+ *
+ * Collection of jet shape algorithms working directly on the contiguous
+ * constituent arrays of an AliEmcalJetConstituentBlock, without accessing
+ * the constituent objects through the particle / cluster containers. For
+ * tasks evaluating several shapes per jet, ComputeShapes obtains the common
+ * shapes in a single pass over the constituents.
+ *
+ * Definitions (\f$ p_{t,i} \f$ and \f$ \Delta R_{i} \f$ being the transverse momentum
+ * and the distance to the jet axis of constituent i):
+ * - Girth: \f$ g = \sum_{i} p_{t,i} \Delta R_{i} / p_{t,jet} \f$
+ * - \f$ p_{t}D = \sqrt{\sum_{i} p_{t,i}^{2}} / \sum_{i} p_{t,i} \f$
+ * - Angularity: \f$ \lambda^{\kappa}_{\beta} = \sum_{i} (p_{t,i}/p_{t,jet})^{\kappa} (\Delta R_{i}/R)^{\beta} \f$
+ * - LeSub: \f$ p_{t,lead} - p_{t,sublead} \f$
+ * - Radial moment of order n: \f$ \sum_{i} p_{t,i} \Delta R_{i}^{n} / \sum_{i} p_{t,i} \f$
+ */
+class AliEmcalJetShapeKernels {
+public:
+
+  /**
+   * @struct JetShapes_t
+   * @brief Result of the single-pass shape evaluation
+   */
+  struct JetShapes_t {
+    Double_t fGirth;            ///< Girth
+    Double_t fPtD;              ///< \f$ p_{t}D \f$
+    Double_t fLeSub;            ///< Leading minus subleading constituent \f$ p_{t} \f$
+    Double_t fRadialMoment2;    ///< Second radial moment
+    Double_t fSumPt;            ///< Scalar sum of constituent \f$ p_{t} \f$
+    UInt_t   fNConstituents;    ///< Number of constituents
+  };
+
+  /**
+   * @brief Calculate girth
+   * @param[in] block Constituent block of the jet
+   * @param[in] jetpt Transverse momentum of the jet
+   * @return Girth (0 for jets without constituents or non-positive \f$ p_{t} \f$)
+   */
+  static Double_t Girth(const AliEmcalJetConstituentBlock &block, Double_t jetpt);
+
+  /**
+   * @brief Calculate \f$ p_{t}D \f$
+   * @param[in] block Constituent block of the jet
+   * @return \f$ p_{t}D \f$ (0 for jets without constituents)
+   */
+  static Double_t PtD(const AliEmcalJetConstituentBlock &block);
+
+  /**
+   * @brief Calculate generalized angularity \f$ \lambda^{\kappa}_{\beta} \f$
+   * @param[in] block Constituent block of the jet
+   * @param[in] jetpt Transverse momentum of the jet
+   * @param[in] jetR Jet radius
+   * @param[in] kappa Momentum exponent
+   * @param[in] beta Angular exponent
+   * @return Angularity
+   */
+  static Double_t Angularity(const AliEmcalJetConstituentBlock &block, Double_t jetpt, Double_t jetR, Double_t kappa, Double_t beta);
+
+  /**
+   * @brief Calculate the difference between leading and subleading constituent \f$ p_{t} \f$
+   * @param[in] block Constituent block of the jet
+   * @param[in] chargedOnly If true only charged constituents are considered
+   * @return LeSub (0 for jets with less than 2 (charged) constituents)
+   */
+  static Double_t LeSub(const AliEmcalJetConstituentBlock &block, Bool_t chargedOnly = kFALSE);
+
+  /**
+   * @brief Calculate the \f$ p_{t} \f$-weighted radial moment of order n
+   * @param[in] block Constituent block of the jet
+   * @param[in] order Order n of the moment
+   * @return Radial moment
+   */
+  static Double_t RadialMoment(const AliEmcalJetConstituentBlock &block, Int_t order);
+
+  /**
+   * @brief Calculate girth, \f$ p_{t}D \f$, LeSub and the second radial moment in a single pass
+   * @param[in] block Constituent block of the jet
+   * @param[in] jetpt Transverse momentum of the jet
+   * @param[out] shapes Result of the shape calculation
+   */
+  static void ComputeShapes(const AliEmcalJetConstituentBlock &block, Double_t jetpt, JetShapes_t &shapes);
+};
+
+}
+
+}
+
+#endif /* ALIEMCALJETSHAPEKERNELS_H */
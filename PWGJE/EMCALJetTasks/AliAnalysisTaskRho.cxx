@@ -13,6 +13,8 @@
 
 #include "AliAnalysisManager.h"
 #include "AliEmcalJet.h"
+#include "AliEmcalJetRhoEstimator.h"
+#include "AliJetContainer.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 
@@ -47,65 +49,18 @@ Bool_t AliAnalysisTaskRho::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets   = fJets->GetEntries();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    if (!AcceptJet(jet))
-      continue;
-
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
-  }
+  // the jet kinematics are read once per event for all the tasks using the same jets,
+  // the jet selection of this task is applied on top of them
+  AliJetContainer *jets = GetJetContainer(0);
+  AliEmcalJetRhoEstimator *rhoEstimator = AliEmcalJetRhoEstimator::Get(InputEvent(), jets);
+  if (!rhoEstimator || !rhoEstimator->Process(InputEvent(), jets) ||
+      !rhoEstimator->Select(jets, fNExclLeadJets, AliEmcalJetRhoEstimator::kRho))
+    return kFALSE;
 
+  Int_t NjetAcc = rhoEstimator->GetNUsedJets(AliEmcalJetRhoEstimator::kRho);
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = rhoEstimator->GetRho(AliEmcalJetRhoEstimator::kRho);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
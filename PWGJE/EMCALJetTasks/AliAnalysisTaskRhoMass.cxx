@@ -24,7 +24,8 @@ AliAnalysisTaskRhoMass::AliAnalysisTaskRhoMass() :
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fMdInput(0)
 {
   // Constructor.
 }
@@ -35,11 +36,26 @@ AliAnalysisTaskRhoMass::AliAnalysisTaskRhoMass(const char *name, Bool_t histo) :
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fMdInput(0)
 {
   // Constructor.
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRhoMass::~AliAnalysisTaskRhoMass()
+{
+  // Destructor.
+
+  delete fMdInput;
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisTaskRhoMassMd::GetJetMd(AliEmcalJet *jet)
+{
+  return fTask->GetMd(jet);
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskRhoMass::UserCreateOutputObjects()
 {
@@ -56,6 +72,16 @@ void AliAnalysisTaskRhoMass::UserCreateOutputObjects()
   fOutput->Add(fHistMdAreavsCent);
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskRhoMass::ExecOnce()
+{
+  // Init the analysis.
+
+  AliAnalysisTaskRhoMassBase::ExecOnce();
+
+  if (!fMdInput)
+    fMdInput = new AliAnalysisTaskRhoMassMd(this);
+}
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoMass::Run() 
@@ -69,80 +95,31 @@ Bool_t AliAnalysisTaskRhoMass::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets   = fJets->GetEntries();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
+  // the jet kinematics are read once per event for all the tasks using the same jets,
+  // the jet selection of this task is applied on top of them
+  AliJetContainer *jets = GetJetContainer(0);
+  AliEmcalJetRhoEstimator *rhoEstimator = AliEmcalJetRhoEstimator::Get(InputEvent(), jets);
+  if (!rhoEstimator || !rhoEstimator->Process(InputEvent(), jets) ||
+      !rhoEstimator->Select(jets, fNExclLeadJets, AliEmcalJetRhoEstimator::kRhoMass, fMdInput))
+    return kFALSE;
 
-      if (!AcceptJet(jet))
+  Int_t NjetAcc = rhoEstimator->GetNUsedJets(AliEmcalJetRhoEstimator::kRhoMass);
+  if (fHistMdAreavsCent) {
+    const Int_t Njets = rhoEstimator->GetNJets();
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      if (!rhoEstimator->IsUsed(AliEmcalJetRhoEstimator::kRhoMass, iJets))
         continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    if (!AcceptJet(jet))
-      continue;
-
-    // Double_t sumM = GetSumMConstituents(jet);
-    // Double_t sumPt = GetSumPtConstituents(jet);
-    if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
-      //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
-      // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      fHistMdAreavsCent->Fill(fCent, rhoEstimator->GetJetDensity(AliEmcalJetRhoEstimator::kRhoMass, iJets));
     }
   }
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = rhoEstimator->GetRho(AliEmcalJetRhoEstimator::kRhoMass);
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = rhoEstimator->GetMeanM(AliEmcalJetRhoEstimator::kRhoMass);
+    Double_t meanE = rhoEstimator->GetMeanE(AliEmcalJetRhoEstimator::kRhoMass);
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
@@ -4,13 +4,30 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoMassBase.h"
+#include "AliEmcalJetRhoEstimator.h"
+
+class AliAnalysisTaskRhoMass;
+
+// md of the jets as computed by the task, input of the shared rho estimator
+class AliAnalysisTaskRhoMassMd : public AliEmcalJetRhoInputProvider {
+
+ public:
+  AliAnalysisTaskRhoMassMd(AliAnalysisTaskRhoMass *task) : fTask(task) {}
+
+  Double_t         GetJetMd(AliEmcalJet *jet);
+
+ private:
+  AliAnalysisTaskRhoMass *fTask;                   // task computing md
+};
 
 class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
 
+  friend class AliAnalysisTaskRhoMassMd;
+
  public:
   AliAnalysisTaskRhoMass();
   AliAnalysisTaskRhoMass(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoMass() {}
+  virtual ~AliAnalysisTaskRhoMass();
 
   enum JetRhoMassType {
     kMd     = 0,            //rho_m from arXiv:1211.2811
@@ -25,6 +42,7 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
   void             SetPionMassForClusters(Bool_t b) { fPionMassClusters = b ; }
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   Double_t         GetSumMConstituents(AliEmcalJet *jet);
@@ -37,9 +55,11 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
 
   TH2F            *fHistMdAreavsCent;              //! Md/Area vs cent for all kt clusters
 
+  AliAnalysisTaskRhoMassMd *fMdInput;              //! md of the jets for the estimator
+
   AliAnalysisTaskRhoMass(const AliAnalysisTaskRhoMass&);             // not implemented
   AliAnalysisTaskRhoMass& operator=(const AliAnalysisTaskRhoMass&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMass, 2); // Rho_m task
+  ClassDef(AliAnalysisTaskRhoMass, 3); // Rho_m task
 };
 #endif
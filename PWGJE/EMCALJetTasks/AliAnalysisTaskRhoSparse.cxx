@@ -24,7 +24,8 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse() :
   AliAnalysisTaskRhoBase("AliAnalysisTaskRhoSparse"),
   fNExclLeadJets(0),
   fRhoCMS(0),
-  fHistOccCorrvsCent(0)
+  fHistOccCorrvsCent(0),
+  fSignalOverlap(0)
 {
   // Constructor.
 }
@@ -34,11 +35,31 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse(const char *name, Bool_t hist
   AliAnalysisTaskRhoBase(name, histo),
   fNExclLeadJets(0),
   fRhoCMS(0),
-  fHistOccCorrvsCent(0)
+  fHistOccCorrvsCent(0),
+  fSignalOverlap(0)
 {
   // Constructor.
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRhoSparse::~AliAnalysisTaskRhoSparse()
+{
+  // Destructor.
+
+  delete fSignalOverlap;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoSparse::ExecOnce()
+{
+  // Init the analysis.
+
+  AliAnalysisTaskRhoBase::ExecOnce();
+
+  if (!fSignalOverlap)
+    fSignalOverlap = new AliAnalysisTaskRhoSparseSignalOverlap(this);
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskRhoSparse::UserCreateOutputObjects()
 {
@@ -76,6 +97,28 @@ Bool_t AliAnalysisTaskRhoSparse::IsJetSignal(AliEmcalJet* jet)
   }
 }
 
+//________________________________________________________________________
+Bool_t AliAnalysisTaskRhoSparseSignalOverlap::IsJetOverlappingSignal(AliEmcalJet *jet)
+{
+  // Search for overlap with signal jets
+
+  AliJetContainer *sigjets = fTask->GetJetContainer(1);
+  if (!sigjets)
+    return kFALSE;
+
+  const Int_t NjetsSig = sigjets->GetNJets();
+  for (Int_t j = 0; j < NjetsSig; j++) {
+    AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+    if (!signalJet)
+      continue;
+    if (!fTask->IsJetSignal(signalJet))
+      continue;
+    if (fTask->IsJetOverlapping(signalJet, jet))
+      return kTRUE;
+  }
+  return kFALSE;
+}
+
 
 //________________________________________________________________________
 Bool_t AliAnalysisTaskRhoSparse::Run() 
@@ -89,107 +132,23 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   if (!fJets)
     return kFALSE;
 
-  const Int_t Njets = fJets->GetEntries();
-
-  AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
-
-  Int_t NjetsSig = 0;
-  if (sigjets) NjetsSig = sigjets->GetNJets();
-
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea=0;
-  Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    TotaljetArea+=jet->Area();
-    
-    if(jet->Pt()>0.1){
-      TotaljetAreaPhys+=jet->Area();
-    }
-
-    if (!AcceptJet(jet))
-      continue;
-
-   // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
-	    {
-	      isOverlapping = kTRUE;
-	      break;
-	    }
-	}
-    }
-
-    if(isOverlapping) 
-      continue;
-
-    if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
-      ++NjetAcc;
-    }
-  }
+  // the jet kinematics are read once per event for all the tasks using the same jets,
+  // the jet selection of this task is applied on top of them
+  AliJetContainer *jets = GetJetContainer(0);
+  AliEmcalJetRhoEstimator *rhoEstimator = AliEmcalJetRhoEstimator::Get(InputEvent(), jets);
+  if (!rhoEstimator || !rhoEstimator->Process(InputEvent(), jets) ||
+      !rhoEstimator->Select(jets, fNExclLeadJets, AliEmcalJetRhoEstimator::kRhoSparse, fSignalOverlap))
+    return kFALSE;
 
-  Double_t OccCorr=0.0;
-  if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+  Int_t NjetAcc = rhoEstimator->GetNUsedJets(AliEmcalJetRhoEstimator::kRhoSparse);
+  Double_t OccCorr = rhoEstimator->GetOccupancyCorrection();
  
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = rhoEstimator->GetRho(AliEmcalJetRhoEstimator::kRhoSparse);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
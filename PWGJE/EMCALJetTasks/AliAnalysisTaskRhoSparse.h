@@ -4,13 +4,28 @@
 // $Id$
 
 #include "AliAnalysisTaskRhoBase.h"
+#include "AliEmcalJetRhoEstimator.h"
+
+class AliAnalysisTaskRhoSparse;
+
+// Overlap of the jets with the signal jets of the task, input of the shared rho estimator
+class AliAnalysisTaskRhoSparseSignalOverlap : public AliEmcalJetRhoInputProvider {
+
+ public:
+  AliAnalysisTaskRhoSparseSignalOverlap(AliAnalysisTaskRhoSparse *task) : fTask(task) {}
+
+  Bool_t           IsJetOverlappingSignal(AliEmcalJet *jet);
+
+ private:
+  AliAnalysisTaskRhoSparse *fTask;                 // task providing the signal jets
+};
 
 class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
 
  public:
   AliAnalysisTaskRhoSparse();
   AliAnalysisTaskRhoSparse(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoSparse() {}
+  virtual ~AliAnalysisTaskRhoSparse();
 
   void             UserCreateOutputObjects();
   void             SetExcludeLeadJets(UInt_t n)    { fNExclLeadJets = n    ; }
@@ -19,6 +34,7 @@ class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
   Bool_t           IsJetSignal(AliEmcalJet* jet1);
 
  protected:
+  void             ExecOnce();
   Bool_t           Run();
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
@@ -26,9 +42,11 @@ class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
 
   TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
 
+  AliAnalysisTaskRhoSparseSignalOverlap *fSignalOverlap; //!overlap with signal jets for the estimator
+
   AliAnalysisTaskRhoSparse(const AliAnalysisTaskRhoSparse&);             // not implemented
   AliAnalysisTaskRhoSparse& operator=(const AliAnalysisTaskRhoSparse&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoSparse, 2); // Rho task
+  ClassDef(AliAnalysisTaskRhoSparse, 3); // Rho task
 };
 #endif
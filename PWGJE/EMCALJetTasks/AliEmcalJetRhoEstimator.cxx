@@ -0,0 +1,348 @@
+// $Id$
+//
+// Background density estimator shared by the rho tasks.
+// One estimator per jet collection is published in the
+// event (see Get()). The first task of an event reads the
+// kinematics of all the jets in a single loop (Process())
+// and the other tasks reuse them. Every task then applies
+// its own jet selection (Select()): acceptance from its
+// jet container, leading jets to be excluded, and per-jet
+// inputs depending on the task settings (md, overlap with
+// signal jets) from the AliEmcalJetRhoInputProvider given.
+// The median is found by linear-time selection
+// (std::nth_element) instead of a full sort. Buffers are
+// kept between events to avoid re-allocation.
+
+#include "AliEmcalJetRhoEstimator.h"
+
+#include <algorithm>
+
+#include <TClonesArray.h>
+
+#include "AliAnalysisManager.h"
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+
+ClassImp(AliEmcalJetRhoEstimator)
+
+//________________________________________________________________________
+AliEmcalJetRhoEstimator::AliEmcalJetRhoEstimator() :
+  TNamed("AliEmcalJetRhoEstimator", "AliEmcalJetRhoEstimator"),
+  fEvent(0),
+  fEntry(-1),
+  fProcessed(kFALSE),
+  fNExclLeadJets(0),
+  fSparseMinPt(0.1),
+  fOccupancy(0),
+  fPt(),
+  fArea(),
+  fE(),
+  fM(),
+  fMd(),
+  fFlags()
+{
+  // Default constructor.
+
+  Reset();
+}
+
+//________________________________________________________________________
+AliEmcalJetRhoEstimator::AliEmcalJetRhoEstimator(const char *name) :
+  TNamed(name, name),
+  fEvent(0),
+  fEntry(-1),
+  fProcessed(kFALSE),
+  fNExclLeadJets(0),
+  fSparseMinPt(0.1),
+  fOccupancy(0),
+  fPt(),
+  fArea(),
+  fE(),
+  fM(),
+  fMd(),
+  fFlags()
+{
+  // Constructor.
+
+  Reset();
+}
+
+//________________________________________________________________________
+TString AliEmcalJetRhoEstimator::GetEstimatorName(AliJetContainer *jets)
+{
+  // Name of the estimator in the event: only the jet collection, the
+  // jet selection is applied by every task itself.
+
+  return TString::Format("AliEmcalJetRhoEstimator_%s", jets->GetArrayName().Data());
+}
+
+//________________________________________________________________________
+AliEmcalJetRhoEstimator *AliEmcalJetRhoEstimator::Get(AliVEvent *ev, AliJetContainer *jets)
+{
+  // Estimator of the jet collection published in the event, created on
+  // the first request. To be called once per event, the event user list
+  // is not guaranteed to keep its objects between events.
+
+  if (!ev || !jets)
+    return 0;
+
+  TString name = GetEstimatorName(jets);
+  AliEmcalJetRhoEstimator *est = dynamic_cast<AliEmcalJetRhoEstimator*>(ev->FindListObject(name));
+  if (!est) {
+    est = new AliEmcalJetRhoEstimator(name);
+    ev->AddObject(est);
+  }
+  return est;
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalJetRhoEstimator::Process(AliVEvent *ev, AliJetContainer *jets)
+{
+  // Single pass over the jets of the collection reading their kinematics.
+  // Done by the first task calling it in an event, the other ones reuse
+  // the results. Returns kFALSE if the jets are not available.
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (ev == fEvent && entry == fEntry)
+    return fProcessed;
+
+  fEvent = ev;
+  fEntry = entry;
+  fProcessed = kFALSE;
+  Reset();
+
+  TClonesArray *array = jets ? jets->GetArray() : 0;
+  if (!array)
+    return kFALSE;
+
+  const Int_t njets = array->GetEntries();
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(array->At(ij));
+    if (!jet) {
+      AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+      AddJet(0, 0);
+      continue;
+    }
+    AddJet(jet->Pt(), jet->Area(), jet->E(), jet->M());
+  }
+
+  fProcessed = kTRUE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalJetRhoEstimator::Select(AliJetContainer *jets, UInt_t nExclLeadJets, ERhoFlavour_t f,
+                                       AliEmcalJetRhoInputProvider *provider)
+{
+  // Apply the jet selection of a task to the jets read by Process() and
+  // compute the flavour f. The results are valid until the next call.
+
+  TClonesArray *array = jets ? jets->GetArray() : 0;
+  if (!fProcessed || !array || array->GetEntries() != GetNJets())
+    return kFALSE;
+
+  fNExclLeadJets = nExclLeadJets;
+  ResetSelection();
+
+  const Int_t njets = GetNJets();
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(array->At(ij));
+    UInt_t rejectionReason = 0;
+    Bool_t accepted = jet && jets->AcceptJet(jet, rejectionReason);
+    // md and signal overlap need the constituents, only evaluated for jets which can enter the median
+    Bool_t overlap = (accepted && provider && f == kRhoSparse) ? provider->IsJetOverlappingSignal(jet) : kFALSE;
+    Double_t md = (accepted && provider && f == kRhoMass && fArea[ij] > 0.) ? provider->GetJetMd(jet) : 0.;
+    SelectJet(ij, accepted, overlap, md);
+  }
+  Compute(1 << f);
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliEmcalJetRhoEstimator::Reset()
+{
+  // Prepare for a new event, keeping the allocated buffers.
+
+  fPt.clear();
+  fArea.clear();
+  fE.clear();
+  fM.clear();
+  fMd.clear();
+  fFlags.clear();
+  ResetSelection();
+}
+
+//________________________________________________________________________
+void AliEmcalJetRhoEstimator::ResetSelection()
+{
+  // Prepare for a new jet selection of the same jets.
+
+  fMd.assign(fPt.size(), 0.);
+  fFlags.assign(fPt.size(), 0);
+  fLeadIds[0] = fLeadIds[1] = -1;
+  fLeadPts[0] = fLeadPts[1] = 0;
+  for (Int_t i = 0; i < kNFlavours; ++i) {
+    fRho[i] = 0;
+    fNUsed[i] = 0;
+  }
+  fOccupancy = 0;
+}
+
+//________________________________________________________________________
+void AliEmcalJetRhoEstimator::AddJet(Double_t pt, Double_t area, Double_t e, Double_t m)
+{
+  // Register the kinematics of the next jet of the collection. Jets
+  // must be added in collection order, also the ones not accepted.
+
+  fPt.push_back(pt);
+  fArea.push_back(area);
+  fE.push_back(e);
+  fM.push_back(m);
+  fMd.push_back(0.);
+  fFlags.push_back(0);
+}
+
+//________________________________________________________________________
+void AliEmcalJetRhoEstimator::SelectJet(Int_t ijet, Bool_t accepted, Bool_t signalOverlap, Double_t md)
+{
+  // Set the selection of a jet, determining the leading jets to be
+  // excluded on the fly. Jets must be selected in collection order.
+
+  fMd[ijet] = md;
+  fFlags[ijet] = (accepted ? kAccepted : 0) | (signalOverlap ? kSignalOverlap : 0);
+
+  if (!accepted || fNExclLeadJets == 0)
+    return;
+
+  const Double_t pt = fPt[ijet];
+  if (pt > fLeadPts[0]) {
+    fLeadPts[1] = fLeadPts[0];
+    fLeadIds[1] = fLeadIds[0];
+    fLeadPts[0] = pt;
+    fLeadIds[0] = ijet;
+  } else if (pt > fLeadPts[1]) {
+    fLeadPts[1] = pt;
+    fLeadIds[1] = ijet;
+  }
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalJetRhoEstimator::IsUsed(ERhoFlavour_t f, Int_t ijet) const
+{
+  // Whether the jet enters the median of the given flavour.
+
+  if (IsExcluded(ijet) || !(fFlags[ijet] & kAccepted))
+    return kFALSE;
+
+  switch (f) {
+  case kRho:
+    return kTRUE;
+  case kRhoSparse:
+    return !(fFlags[ijet] & kSignalOverlap) && fPt[ijet] > fSparseMinPt;
+  case kRhoMass:
+    return fArea[ijet] > 0.;
+  default:
+    return kFALSE;
+  }
+}
+
+//________________________________________________________________________
+void AliEmcalJetRhoEstimator::Compute(UInt_t flavours)
+{
+  // Compute all requested rho flavours (bit mask of ERhoFlavour_t)
+  // in one loop over the jet buffers.
+
+  if (fNExclLeadJets < 2)
+    fLeadIds[1] = -1;
+
+  const Int_t njets = fPt.size();
+  Int_t nused[kNFlavours] = {0};
+  for (Int_t f = 0; f < kNFlavours; ++f) {
+    if ((flavours & (1 << f)) && fWork[f].size() < fPt.size())
+      fWork[f].resize(fPt.size());
+  }
+
+  // occupancy correction: all jets but the excluded leading jets, independent of acceptance
+  const Bool_t doOccupancy = flavours & (1 << kRhoSparse);
+  Double_t totalArea = 0, totalAreaPhys = 0;
+
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    for (Int_t f = 0; f < kNFlavours; ++f) {
+      if (!(flavours & (1 << f)) || !IsUsed(static_cast<ERhoFlavour_t>(f), ij))
+        continue;
+      fWork[f][nused[f]++] = GetJetDensity(static_cast<ERhoFlavour_t>(f), ij);
+    }
+    if (doOccupancy && !IsExcluded(ij)) {
+      totalArea += fArea[ij];
+      if (fPt[ij] > fSparseMinPt)
+        totalAreaPhys += fArea[ij];
+    }
+  }
+
+  for (Int_t f = 0; f < kNFlavours; ++f) {
+    if (!(flavours & (1 << f)))
+      continue;
+    fNUsed[f] = nused[f];
+    fRho[f] = nused[f] > 0 ? Median(nused[f], &fWork[f][0]) : 0;
+  }
+
+  if (doOccupancy)
+    fOccupancy = totalArea > 0 ? totalAreaPhys / totalArea : 0;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalJetRhoEstimator::GetMeanOfUsed(ERhoFlavour_t f, const std::vector<Double_t> &values) const
+{
+  // Mean of a per-jet quantity over the jets used for the given flavour.
+
+  Double_t sum = 0;
+  Int_t n = 0;
+  const Int_t njets = values.size();
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    if (!IsUsed(f, ij))
+      continue;
+    sum += values[ij];
+    ++n;
+  }
+  return n > 0 ? sum / n : 0;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalJetRhoEstimator::GetMeanE(ERhoFlavour_t f) const
+{
+  // Mean energy of the jets used for the given flavour.
+
+  return GetMeanOfUsed(f, fE);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalJetRhoEstimator::GetMeanM(ERhoFlavour_t f) const
+{
+  // Mean mass of the jets used for the given flavour.
+
+  return GetMeanOfUsed(f, fM);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalJetRhoEstimator::Median(Int_t n, Double_t *values)
+{
+  // Median of the values in linear time. Same convention as
+  // TMath::Median: for even n the mean of the two central values.
+  // The order of the values is modified.
+
+  if (n <= 0)
+    return 0;
+
+  const Int_t k = n / 2;
+  std::nth_element(values, values + k, values + n);
+  Double_t median = values[k];
+  if (n % 2 == 0) {
+    // after nth_element all values below k are not larger than values[k]
+    median = 0.5 * (median + *std::max_element(values, values + k));
+  }
+  return median;
+}
@@ -0,0 +1,99 @@
+#ifndef ALIEMCALJETRHOESTIMATOR_H
+#define ALIEMCALJETRHOESTIMATOR_H
+
+// $Id$
+
+#include <vector>
+
+#include <TNamed.h>
+
+class AliEmcalJet;
+class AliJetContainer;
+class AliVEvent;
+
+// Per-jet inputs of a rho flavour which depend on the settings of the
+// task selecting the jets (e.g. md of the jet, overlap with signal jets).
+class AliEmcalJetRhoInputProvider {
+
+ public:
+  virtual ~AliEmcalJetRhoInputProvider() {}
+
+  virtual Double_t GetJetMd(AliEmcalJet */*jet*/)               { return 0.     ; }
+  virtual Bool_t   IsJetOverlappingSignal(AliEmcalJet */*jet*/) { return kFALSE ; }
+};
+
+class AliEmcalJetRhoEstimator : public TNamed {
+
+ public:
+  AliEmcalJetRhoEstimator();
+  AliEmcalJetRhoEstimator(const char *name);
+  virtual ~AliEmcalJetRhoEstimator() {}
+
+  enum ERhoFlavour_t {
+    kRho       = 0,            // median of pt/A of accepted jets
+    kRhoSparse = 1,            // median of pt/A of accepted jets with pt > min pt, no overlap with signal jets
+    kRhoMass   = 2,            // median of md/A of accepted jets with A > 0
+    kNFlavours = 3
+  };
+
+  static AliEmcalJetRhoEstimator *Get(AliVEvent *ev, AliJetContainer *jets);
+
+  Bool_t           Process(AliVEvent *ev, AliJetContainer *jets);
+  Bool_t           Select(AliJetContainer *jets, UInt_t nExclLeadJets, ERhoFlavour_t f,
+                          AliEmcalJetRhoInputProvider *provider = 0);
+
+  void             SetExcludeLeadJets(UInt_t n)                  { fNExclLeadJets = n    ; }
+  void             SetSparseMinJetPt(Double_t pt)                { fSparseMinPt   = pt   ; }
+
+  void             Reset();
+  void             AddJet(Double_t pt, Double_t area, Double_t e = 0., Double_t m = 0.);
+  void             SelectJet(Int_t ijet, Bool_t accepted, Bool_t signalOverlap = kFALSE, Double_t md = 0.);
+  void             ResetSelection();
+  void             Compute(UInt_t flavours = 1 << kRho);
+
+  Int_t            GetNJets() const                              { return fPt.size()      ; }
+  Bool_t           IsExcluded(Int_t ijet) const                  { return ijet == fLeadIds[0] || ijet == fLeadIds[1]; }
+  Bool_t           IsUsed(ERhoFlavour_t f, Int_t ijet) const;
+  Int_t            GetNUsedJets(ERhoFlavour_t f) const           { return fNUsed[f]       ; }
+  Double_t         GetJetDensity(ERhoFlavour_t f, Int_t ijet) const { return (f == kRhoMass ? fMd[ijet] : fPt[ijet]) / fArea[ijet]; }
+  Double_t         GetRho(ERhoFlavour_t f = kRho) const          { return fRho[f]         ; }
+  Double_t         GetOccupancyCorrection() const                { return fOccupancy      ; }
+  Double_t         GetMeanE(ERhoFlavour_t f) const;
+  Double_t         GetMeanM(ERhoFlavour_t f) const;
+
+  static TString   GetEstimatorName(AliJetContainer *jets);
+  static Double_t  Median(Int_t n, Double_t *values);
+
+ protected:
+  Double_t         GetMeanOfUsed(ERhoFlavour_t f, const std::vector<Double_t> &values) const;
+
+  AliVEvent            *fEvent;                    //!event the jet kinematics refer to
+  Long64_t              fEntry;                    //!entry of fEvent in the analysis manager
+  Bool_t                fProcessed;                //!whether the jets of fEvent were available
+  UInt_t                fNExclLeadJets;            //!number of leading jets excluded by the current selection
+  Double_t              fSparseMinPt;              //!minimum jet pt considered as physical jet in the sparse estimate
+  Int_t                 fLeadIds[2];               //!indices of the excluded leading jets of the current selection
+  Double_t              fLeadPts[2];               //!pt of the two leading accepted jets of the current selection
+  Double_t              fRho[kNFlavours];          //!result per flavour of the current selection
+  Int_t                 fNUsed[kNFlavours];        //!number of jets entering the median per flavour
+  Double_t              fOccupancy;                //!occupancy correction (physical over total jet area)
+  std::vector<Double_t> fPt;                       //!jet pt
+  std::vector<Double_t> fArea;                     //!jet area
+  std::vector<Double_t> fE;                        //!jet energy
+  std::vector<Double_t> fM;                        //!jet mass
+  std::vector<Double_t> fMd;                       //!jet md (rho_m) of the current selection
+  std::vector<UChar_t>  fFlags;                    //!jet flags of the current selection (accepted, overlap with signal jet)
+  std::vector<Double_t> fWork[kNFlavours];         //!buffers for the selection of the medians
+
+ private:
+  enum EJetFlag_t {
+    kAccepted      = 1 << 0,
+    kSignalOverlap = 1 << 1
+  };
+
+  AliEmcalJetRhoEstimator(const AliEmcalJetRhoEstimator&);            // not implemented
+  AliEmcalJetRhoEstimator& operator=(const AliEmcalJetRhoEstimator&); // not implemented
+
+  ClassDef(AliEmcalJetRhoEstimator, 1); // Rho estimator shared by the rho tasks of a jet collection
+};
+#endif
@@ -37,6 +37,7 @@
 #include "AliClusterContainer.h"
 #include "AliEmcalClusterJetConstituent.h"
 #include "AliEmcalParticleJetConstituent.h"
+#include "AliEmcalJetConstituentBlock.h"
 
 #include "AliEmcalJetTask.h"
 
@@ -73,6 +74,8 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fFillConstituentBlock(kFALSE),
+  fAdditionalRadii(),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -80,6 +83,7 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fJetsR(),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -109,6 +113,8 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fFillConstituentBlock(kFALSE),
+  fAdditionalRadii(),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -116,6 +122,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fJetsR(),
   fFastJetWrapper(name,name),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -210,11 +217,13 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (UInt_t ir = 0; ir < fJetsR.size(); ir++) fJetsR[ir]->Delete();
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  for (UInt_t ir = 0; ir < fJetsR.size(); ir++) FillAdditionalJetBranch(ir);
 
   return kTRUE;
 }
@@ -304,34 +313,10 @@ void AliEmcalJetTask::FillJetBranch()
     Int_t ij = indexes[ijet];
     AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
 
-    if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
-    if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
-        (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
-      continue;
-
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
-    		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
-    jet->SetLabel(ij);
-
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
-    jet->SetArea(area.perp());
-    jet->SetAreaEta(area.eta());
-    jet->SetAreaPhi(area.phi());
-    jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    if (!AcceptJet(jets_incl[ij], fFastJetWrapper.GetJetArea(ij))) continue;
 
-    // Fill constituent info
     std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
-    FillJetConstituents(jet, constituents, constituents);
-
-    if (fGeom) {
-      if ((jet->Phi() > fGeom->GetArm1PhiMin() * TMath::DegToRad()) &&
-          (jet->Phi() < fGeom->GetArm1PhiMax() * TMath::DegToRad()) &&
-          (jet->Eta() > fGeom->GetArm1EtaMin()) &&
-          (jet->Eta() < fGeom->GetArm1EtaMax()))
-        jet->SetAxisInEmcal(kTRUE);
-    }
+    AliEmcalJet *jet = AddJet(fJets, jetCount, ij, jets_incl[ij], fFastJetWrapper.GetJetAreaVector(ij), constituents, fRadius);
 
     ExecuteUtilities(jet, ij);
 
@@ -342,6 +327,83 @@ void AliEmcalJetTask::FillJetBranch()
   TerminateUtilities();
 }
 
+/**
+ * This method fills the jet output branch of an additional radius. The utilities
+ * are not executed for the additional radii.
+ * @param ir Index of the additional radius
+ */
+void AliEmcalJetTask::FillAdditionalJetBranch(UInt_t ir)
+{
+  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJetsR(ir);
+  static Int_t indexes[9999] = {-1};
+  GetSortedArray(indexes, jets_incl);
+
+  AliDebug(1,Form("%d jets found for R = %.2f", (Int_t)jets_incl.size(), fAdditionalRadii[ir]));
+  for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
+    Int_t ij = indexes[ijet];
+
+    if (!AcceptJet(jets_incl[ij], fFastJetWrapper.GetJetAreaR(ir, ij))) continue;
+
+    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituentsR(ir, ij));
+    AddJet(fJetsR[ir], jetCount, ij, jets_incl[ij], fFastJetWrapper.GetJetAreaVectorR(ir, ij), constituents, fAdditionalRadii[ir]);
+    jetCount++;
+  }
+}
+
+/**
+ * Applies the kinematic and area selection of the output jets.
+ * @param jet Jet returned by the FastJet wrapper
+ * @param area Area of the jet
+ * @return kTRUE if the jet is kept in the output branch
+ */
+Bool_t AliEmcalJetTask::AcceptJet(const fastjet::PseudoJet& jet, Double_t area) const
+{
+  if (jet.perp() < fMinJetPt) return kFALSE;
+  if (area < fMinJetArea) return kFALSE;
+  if ((jet.eta() < fJetEtaMin) || (jet.eta() > fJetEtaMax) ||
+      (jet.phi() < fJetPhiMin) || (jet.phi() > fJetPhiMax))
+    return kFALSE;
+  return kTRUE;
+}
+
+/**
+ * Creates an AliEmcalJet in the output branch and fills kinematics, area and constituents.
+ * @param jets Output jet branch
+ * @param jetCount Position of the new jet in the branch
+ * @param ij Index of the jet in the list of inclusive jets of the FastJet wrapper
+ * @param pj Jet returned by the FastJet wrapper
+ * @param area Area 4-vector of the jet
+ * @param constituents Constituents of the jet
+ * @param r Jet radius, used to determine the acceptance type
+ * @return Pointer to the new jet
+ */
+AliEmcalJet* AliEmcalJetTask::AddJet(TClonesArray* jets, Int_t jetCount, Int_t ij, const fastjet::PseudoJet& pj,
+    const fastjet::PseudoJet& area, std::vector<fastjet::PseudoJet>& constituents, Double_t r)
+{
+  AliEmcalJet *jet = new ((*jets)[jetCount])
+    		          AliEmcalJet(pj.perp(), pj.eta(), pj.phi(), pj.m());
+  jet->SetLabel(ij);
+
+  jet->SetArea(area.perp());
+  jet->SetAreaEta(area.eta());
+  jet->SetAreaPhi(area.phi());
+  jet->SetAreaE(area.E());
+  jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), r));
+
+  // Fill constituent info
+  FillJetConstituents(jet, constituents, constituents);
+
+  if (fGeom) {
+    if ((jet->Phi() > fGeom->GetArm1PhiMin() * TMath::DegToRad()) &&
+        (jet->Phi() < fGeom->GetArm1PhiMax() * TMath::DegToRad()) &&
+        (jet->Eta() > fGeom->GetArm1EtaMin()) &&
+        (jet->Eta() < fGeom->GetArm1EtaMax()))
+      jet->SetAxisInEmcal(kTRUE);
+  }
+
+  return jet;
+}
+
 /**
  * Sorts jets by pT (decreasing)
  * @param[out] indexes This array is used to return the indexes of the jets ordered by pT
@@ -391,6 +453,23 @@ void AliEmcalJetTask::ExecOnce()
     return;
   }
 
+  // add the jet branches of the additional radii
+  fFastJetWrapper.ClearAdditionalRadii();
+  fJetsR.clear();
+  for (UInt_t ir = 0; ir < fAdditionalRadii.size(); ir++) {
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, fJetAlgo, fRecombScheme, fAdditionalRadii[ir], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    if (InputEvent()->FindListObject(jetsName)) {
+      AliError(Form("%s: Object with name %s already in event! Returning", GetName(), jetsName.Data()));
+      return;
+    }
+    TClonesArray *jets = new TClonesArray("AliEmcalJet");
+    jets->SetName(jetsName);
+    ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+    InputEvent()->AddObject(jets);
+    fJetsR.push_back(jets);
+    fFastJetWrapper.AddAdditionalRadius(fAdditionalRadii[ir]);
+  }
+
   // setup fj wrapper
   fFastJetWrapper.SetAreaType(fastjet::active_area_explicit_ghosts);
   fFastJetWrapper.SetGhostArea(fGhostArea);
@@ -446,6 +525,12 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
   jet->SetNumberOfTracks(constituents.size());
   jet->SetNumberOfClusters(constituents.size());
 
+  PWG::JETFW::AliEmcalJetConstituentBlock *block = 0;
+  if (fFillConstituentBlock) {
+    block = jet->CreateConstituentBlock();
+    block->Reserve(constituents.size());
+  }
+
   for (UInt_t ic = 0; ic < constituents.size(); ++ic) {
 
     if (flag == 0) {
@@ -500,6 +585,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
       if(fFillConstituents){
         jet->AddParticleConstituent(t, partCont->GetIsEmbedding(), fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid));
       }
+      if (block) block->AddConstituent(constituents[ic].perp(), constituents[ic].eta(), constituents[ic].phi(), constituents[ic].m(), t->Charge(), t->GetLabel());
 
       Double_t cEta = t->Eta();
       Double_t cPhi = t->Phi();
@@ -562,6 +648,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
       Double_t cP   = nP.P();
       Double_t pvec[3] = {nP.Px(), nP.Py(), nP.Pz()};
       if(fFillConstituents) jet->AddClusterConstituent(c, (AliVCluster::VCluUserDefEnergy_t)clusCont->GetDefaultClusterEnergy(), pvec, clusCont->GetIsEmbedding(), fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, cid));
+      if (block) block->AddConstituent(constituents[ic].perp(), constituents[ic].eta(), constituents[ic].phi(), constituents[ic].m(), 0, c->GetLabel());
 
       neutralE += cP;
       if (cPt > maxNe) maxNe = cPt;
@@ -40,6 +40,10 @@ namespace fastjet {
  * defined as being charged, neutral or full. The jet finding is delegated to
  * the class AliFJWrapper which implements an interface to FastJet.
  *
+ * Additional radii can be added with AddAdditionalRadius(Double_t). They are clustered
+ * in the same pass from the same constituents and ghosts as the main radius, and the jets
+ * are written to a separate branch per radius. The utilities only run on the main radius.
+ *
  * The FastJet contrib utilities are available via the AliEmcalJetUtility base class
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
@@ -79,6 +83,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   AddAdditionalRadius(Double_t r)            { if (IsLocked()) return; fAdditionalRadii.push_back(r); }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -107,6 +112,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  UInt_t                 GetNAdditionalRadii() const      { return fAdditionalRadii.size(); }
+  TClonesArray*          GetAdditionalJets(UInt_t ir)     { return ir < fJetsR.size() ? fJetsR[ir] : 0; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -128,6 +135,17 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
    */
   void                   SetFillJetConsituents(Bool_t doFill) { fFillConstituents = doFill; }
 
+  /**
+   * @brief Switch for whether to fill the packed constituent block of the jet
+   *
+   * The block stores the constituent kinematics (pt, eta, phi, m), charge and
+   * MC label in contiguous arrays for the use with AliEmcalJetShapeKernels. It
+   * is not filled by default.
+   *
+   * @param doFill Switch for filling the constituent block
+   */
+  void                   SetFillConstituentBlock(Bool_t doFill) { fFillConstituentBlock = doFill; }
+
   static AliEmcalJetTask* AddTaskEmcalJet(
       const TString nTracks                      = "usedefault",
       const TString nClusters                    = "usedefault",
@@ -153,6 +171,10 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillAdditionalJetBranch(UInt_t ir);
+  Bool_t                 AcceptJet(const fastjet::PseudoJet& jet, Double_t area) const;
+  AliEmcalJet*           AddJet(TClonesArray* jets, Int_t jetCount, Int_t ij, const fastjet::PseudoJet& jet,
+                                const fastjet::PseudoJet& area, std::vector<fastjet::PseudoJet>& constituents, Double_t r);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -183,6 +205,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; ///<tituent Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 ///< true if lock is set
   Bool_t	          fFillConstituents;		 ///< If true jet consituents will be filled to the AliEmcalJet
+  Bool_t                 fFillConstituentBlock;   ///< If true the packed constituent block will be filled to the AliEmcalJet
+  std::vector<Double_t>  fAdditionalRadii;        ///< additional jet radii clustered together with fRadius, one jet branch each
 
   TString                fJetsName;               //!<!name of jet collection
   Bool_t                 fIsInit;                 //!<!=true if already initialized
@@ -192,6 +216,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
 
   TClonesArray          *fJets;                   //!<!jet collection
+  std::vector<TClonesArray*> fJetsR;              //!<!jet collections of the additional radii
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
@@ -207,7 +232,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 26);
+  ClassDef(AliEmcalJetTask, 28);
   /// \endcond
 };
 #endif
@@ -18,7 +18,8 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor() :
   fJetsSub(0x0),
   fParticlesSub(0x0),
   fRhoParam(0),
-  fRhomParam(0)
+  fRhomParam(0),
+  fNThreads(1)
 {
   // Dummy constructor.
 
@@ -39,7 +40,8 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const char*
   fRhoParam(0),
   fRhomParam(0),
   fAlpha(0),
-  fMaxDelR(-1)
+  fMaxDelR(-1),
+  fNThreads(1)
 {
   // Default constructor.
 }
@@ -59,7 +61,8 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const AliEm
   fRhoParam(other.fRhoParam),
   fRhomParam(other.fRhomParam),
   fAlpha(0),
-  fMaxDelR(-1)
+  fMaxDelR(-1),
+  fNThreads(other.fNThreads)
 {
   // Copy constructor.
 }
@@ -82,6 +85,7 @@ AliEmcalJetUtilityConstSubtractor& AliEmcalJetUtilityConstSubtractor::operator=(
   fParticlesSub = other.fParticlesSub;
   fRhoParam = other.fRhoParam;
   fRhomParam = other.fRhomParam;
+  fNThreads = other.fNThreads;
   return *this;
 }
 
@@ -168,6 +172,7 @@ void AliEmcalJetUtilityConstSubtractor::Prepare(AliFJWrapper& fjw)
   fjw.SetUseExternalBkg(fUseExternalBkg, fRho, fRhom);
   fjw.SetAlpha(fAlpha);
   fjw.SetMaxDelR(fMaxDelR);
+  fjw.SetNThreads(fNThreads);
   fjw.DoConstituentSubtraction();
 }
 
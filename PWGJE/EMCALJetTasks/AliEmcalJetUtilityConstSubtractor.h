@@ -30,6 +30,7 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   void                   SetParticlesSubName(const char *n)  { fParticlesSubName = n     ; }
   void                   SetAlpha(const Double_t a)            { fAlpha            = a     ; }
   void                   SetMaxDelR(const Double_t r)          { fMaxDelR          = r     ; }
+  void                   SetNThreads(Int_t n)                  { fNThreads         = n     ; }
 
   void Init();
   void InitEvent(AliFJWrapper& fjw);
@@ -48,12 +49,13 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   Double_t               fRhom;                               // mT background density
   Double_t               fAlpha;                              // pT weight exponent applied in const sub
   Double_t               fMaxDelR;                            // Max distance between ghost and constituent pair in subtraction
+  Int_t                  fNThreads;                           // number of threads used to subtract the jets of an event
 
   TClonesArray          *fJetsSub;                            //!subtracted jet collection
   TClonesArray          *fParticlesSub;                       //!subtracted particle collection
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
 
-  ClassDef(AliEmcalJetUtilityConstSubtractor, 2) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityConstSubtractor, 3) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
 };
 #endif
@@ -20,6 +20,7 @@ AliEmcalJetUtility(),
   fRMax(0.4),
   fDRStep(0.04),
   fPtMinGR(40.),
+  fNThreads(1),
   fRhoParam(0),
   fRhomParam(0)
 {
@@ -42,6 +43,7 @@ AliEmcalJetUtilityGenSubtractor::AliEmcalJetUtilityGenSubtractor(const char* nam
   fRMax(0.4),
   fDRStep(0.04),
   fPtMinGR(40.),
+  fNThreads(1),
   fRhoParam(0),
   fRhomParam(0)
 {
@@ -63,6 +65,7 @@ AliEmcalJetUtilityGenSubtractor::AliEmcalJetUtilityGenSubtractor(const AliEmcalJ
   fRMax(other.fRMax),
   fDRStep(other.fDRStep),
   fPtMinGR(other.fPtMinGR),
+  fNThreads(other.fNThreads),
   fRhoParam(other.fRhoParam),
   fRhomParam(other.fRhomParam)
 {
@@ -88,6 +91,7 @@ AliEmcalJetUtilityGenSubtractor& AliEmcalJetUtilityGenSubtractor::operator=(cons
   fRMax = other.fRMax;
   fDRStep = other.fDRStep;
   fPtMinGR = other.fPtMinGR;
+  fNThreads = other.fNThreads;
   fRhoParam = other.fRhoParam;
   fRhomParam = other.fRhomParam;
   return *this;
@@ -136,38 +140,25 @@ void AliEmcalJetUtilityGenSubtractor::Prepare(AliFJWrapper& fjw)
   if (fRhoParam) fRho = fRhoParam->GetVal();
   if (fRhomParam) fRhom = fRhomParam->GetVal();
 
-  //run generic subtractor
-  if (fDoGenericSubtractionJetMass) {
-    fjw.SetUseExternalBkg(fUseExternalBkg,fRho,fRhom);
-    fjw.DoGenericSubtractionJetMass();
+  fjw.SetNThreads(fNThreads);
+
+  //run generic subtractor for all requested shapes in a single pass over the jets
+  UInt_t shapes = 0;
+  if (fDoGenericSubtractionJetMass) shapes |= AliFJWrapper::kGenSubJetMass;
+  if (fDoGenericSubtractionExtraJetShapes) shapes |= AliFJWrapper::kGenSubExtraJetShapes;
+  if (fDoGenericSubtractionNsubjettiness) {
+    shapes |= AliFJWrapper::kGenSubJet1subjettiness_kt    | AliFJWrapper::kGenSubJet2subjettiness_kt |
+              AliFJWrapper::kGenSubJet3subjettiness_kt    | AliFJWrapper::kGenSubJetOpeningAngle_kt  |
+              AliFJWrapper::kGenSubJet1subjettiness_ca    | AliFJWrapper::kGenSubJet2subjettiness_ca |
+              AliFJWrapper::kGenSubJetOpeningAngle_ca     |
+              AliFJWrapper::kGenSubJet1subjettiness_akt02 | AliFJWrapper::kGenSubJet2subjettiness_akt02 |
+              AliFJWrapper::kGenSubJetOpeningAngle_akt02;
+    //casd shapes are not enabled
   }
- 
- if (fDoGenericSubtractionExtraJetShapes) {
-   fjw.SetUseExternalBkg(fUseExternalBkg,fRho,fRhom);
-   fjw.DoGenericSubtractionJetAngularity();
-   fjw.DoGenericSubtractionJetpTD();
-   fjw.DoGenericSubtractionJetCircularity();
-   fjw.DoGenericSubtractionJetSigma2();
-   fjw.DoGenericSubtractionJetConstituent();
-   fjw.DoGenericSubtractionJetLeSub();
- }
- 
- if  (fDoGenericSubtractionNsubjettiness) {
-   fjw.SetUseExternalBkg(fUseExternalBkg,fRho,fRhom);
-   fjw.DoGenericSubtractionJet1subjettiness_kt();
-   fjw.DoGenericSubtractionJet2subjettiness_kt();
-   fjw.DoGenericSubtractionJet3subjettiness_kt();
-   fjw.DoGenericSubtractionJetOpeningAngle_kt();
-   fjw.DoGenericSubtractionJet1subjettiness_ca();
-   fjw.DoGenericSubtractionJet2subjettiness_ca();
-   fjw.DoGenericSubtractionJetOpeningAngle_ca();
-   fjw.DoGenericSubtractionJet1subjettiness_akt02();
-   fjw.DoGenericSubtractionJet2subjettiness_akt02();
-   fjw.DoGenericSubtractionJetOpeningAngle_akt02();
-   //fjw.DoGenericSubtractionJet1subjettiness_casd();
-   //fjw.DoGenericSubtractionJet2subjettiness_casd();
-   //fjw.DoGenericSubtractionJetOpeningAngle_casd();
- }
+  if (!shapes) return;
+
+  fjw.SetUseExternalBkg(fUseExternalBkg,fRho,fRhom);
+  fjw.DoGenericSubtractionJetShapes(shapes);
 }
 
 //______________________________________________________________________________
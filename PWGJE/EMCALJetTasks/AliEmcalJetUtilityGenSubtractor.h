@@ -36,6 +36,7 @@ class AliEmcalJetUtilityGenSubtractor : public AliEmcalJetUtility
   void                   SetGenericSubtractionExtraJetShapes(Bool_t b)                    { fDoGenericSubtractionExtraJetShapes = b; }
   void                   SetGenericSubtractionNsubjettiness(Bool_t b)                     { fDoGenericSubtractionNsubjettiness = b; }
   void                   SetUseExternalBkg(Bool_t b)                                      { fUseExternalBkg                     = b; }
+  void                   SetNThreads(Int_t n)                                             { fNThreads                           = n; }
 
  protected:
 
@@ -51,10 +52,11 @@ class AliEmcalJetUtilityGenSubtractor : public AliEmcalJetUtility
   Double_t               fRMax;                               // R max for GR calculation
   Double_t               fDRStep;                             // step width for GR calculation
   Double_t               fPtMinGR;                            // min pT for GR calculation
+  Int_t                  fNThreads;                           // number of threads used to subtract the jets of an event
 
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
 
-  ClassDef(AliEmcalJetUtilityGenSubtractor, 1) // Emcal jet utility that implements generic subtractors form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityGenSubtractor, 2) // Emcal jet utility that implements generic subtractors form the fastjet contrib
 };
 #endif
@@ -4,6 +4,7 @@
 #if !defined(__CINT__)
 
 #include <vector>
+#include <functional>
 #include <TString.h>
 #include "AliLog.h"
 #include "FJ_includes.h"
@@ -13,6 +14,31 @@
 class AliFJWrapper
 {
  public:
+  // jet shapes that can be subtracted in a single pass with DoGenericSubtractionJetShapes()
+  enum EGenSubJetShape_t {
+    kGenSubJetMass                = 1<<0,
+    kGenSubJetAngularity          = 1<<1,
+    kGenSubJetpTD                 = 1<<2,
+    kGenSubJetCircularity         = 1<<3,
+    kGenSubJetSigma2              = 1<<4,
+    kGenSubJetConstituent         = 1<<5,
+    kGenSubJetLeSub               = 1<<6,
+    kGenSubJet1subjettiness_kt    = 1<<7,
+    kGenSubJet2subjettiness_kt    = 1<<8,
+    kGenSubJet3subjettiness_kt    = 1<<9,
+    kGenSubJetOpeningAngle_kt     = 1<<10,
+    kGenSubJet1subjettiness_ca    = 1<<11,
+    kGenSubJet2subjettiness_ca    = 1<<12,
+    kGenSubJetOpeningAngle_ca     = 1<<13,
+    kGenSubJet1subjettiness_akt02 = 1<<14,
+    kGenSubJet2subjettiness_akt02 = 1<<15,
+    kGenSubJetOpeningAngle_akt02  = 1<<16,
+    kGenSubJet1subjettiness_casd  = 1<<17,
+    kGenSubJet2subjettiness_casd  = 1<<18,
+    kGenSubJetOpeningAngle_casd   = 1<<19,
+    kGenSubExtraJetShapes         = kGenSubJetAngularity | kGenSubJetpTD | kGenSubJetCircularity | kGenSubJetSigma2 | kGenSubJetConstituent | kGenSubJetLeSub
+  };
+
   AliFJWrapper(const char *name, const char *title);
   virtual ~AliFJWrapper();
 
@@ -50,6 +76,15 @@ class AliFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Int_t                                   GetNThreads()        const { return fNThreads;                   }
+  // multi-radius mode: additional radii clustered in Run() over the same input vectors and ghosts
+  UInt_t                                  GetNAdditionalRadii() const { return fAdditionalRadii.size();    }
+  Double_t                                GetAdditionalRadius(UInt_t ir) const { return ir < fAdditionalRadii.size() ? fAdditionalRadii[ir] : -1; }
+  fastjet::ClusterSequenceArea*           GetClusterSequenceR(UInt_t ir) const { return ir < fClustSeqR.size() ? fClustSeqR[ir] : 0; }
+  const std::vector<fastjet::PseudoJet>&  GetInclusiveJetsR(UInt_t ir) const;
+  std::vector<fastjet::PseudoJet>         GetJetConstituentsR(UInt_t ir, UInt_t idx) const;
+  Double_t                                GetJetAreaR        (UInt_t ir, UInt_t idx) const;
+  fastjet::PseudoJet                      GetJetAreaVectorR  (UInt_t ir, UInt_t idx) const;
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
 #ifdef FASTJET_VERSION
@@ -90,6 +125,8 @@ class AliFJWrapper
   virtual Int_t Run();
   virtual Int_t Filter();
   virtual void  DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Double32_t>& jetshape, std::vector<fastjet::contrib::GenericSubtractorInfo>& output);
+  virtual void  DoGenericSubtraction(const std::vector<const fastjet::FunctionOfPseudoJet<Double32_t>*>& jetshapes, const std::vector<std::vector<fastjet::contrib::GenericSubtractorInfo>*>& outputs);
+  virtual Int_t DoGenericSubtractionJetShapes(UInt_t shapes);
   virtual Int_t DoGenericSubtractionJetMass();
   virtual Int_t DoGenericSubtractionGR(Int_t ijet);
   virtual Int_t DoGenericSubtractionJetAngularity();
@@ -143,6 +180,9 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  void SetNThreads(Int_t n);
+  void AddAdditionalRadius(Double_t r)  { fAdditionalRadii.push_back(r); }
+  void ClearAdditionalRadii()           { fAdditionalRadii.clear();      }
 
  protected:
   TString                                fName;               //!
@@ -194,6 +234,11 @@ class AliFJWrapper
   Bool_t                                 fEventSub;
   Double_t                               fMaxDelR;
   Double_t                               fAlpha;
+  Int_t                                  fNThreads;           //! number of threads used for the per-jet subtraction
+  std::vector<Double_t>                  fAdditionalRadii;    //! additional radii clustered in the same Run()
+  std::vector<fastjet::JetDefinition*>   fJetDefsR;           //! jet definitions of the additional radii
+  std::vector<fastjet::ClusterSequenceArea*> fClustSeqR;      //! cluster sequences of the additional radii
+  std::vector<std::vector<fastjet::PseudoJet> > fInclusiveJetsR; //! inclusive jets of the additional radii
 #ifdef FASTJET_VERSION
   fastjet::JetMedianBackgroundEstimator   *fBkrdEstimator;    //!
   //from contrib package
@@ -237,6 +282,9 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominatorSub; //!
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  void           ProcessTasks(UInt_t ntasks, const std::function<void(UInt_t)>& task) const;
+  void           PrepareBkgEstimator();
+  void           RunAdditionalRadii(const std::vector<int>& ghostStatus);
 
  private:
   AliFJWrapper();
@@ -253,6 +301,11 @@ class AliFJWrapper
 #pragma GCC system_header
 #endif
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace fj = fastjet;
 
 //_________________________________________________________________________________________________
@@ -299,6 +352,11 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fEventSub          (kFALSE)
   , fMaxDelR           (-1)
   , fAlpha             (0)
+  , fNThreads          (1)
+  , fAdditionalRadii   ( )
+  , fJetDefsR          ( )
+  , fClustSeqR         ( )
+  , fInclusiveJetsR    ( )
 #ifdef FASTJET_VERSION
   , fBkrdEstimator     (0)
   , fGenSubtractor     (0)
@@ -364,6 +422,11 @@ void AliFJWrapper::ClearMemory()
   if (fClustSeqES)          { delete fClustSeqES;        fClustSeqES        = NULL; }
   if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
   if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
+  for (UInt_t ir = 0; ir < fClustSeqR.size(); ir++) delete fClustSeqR[ir];
+  for (UInt_t ir = 0; ir < fJetDefsR.size(); ir++)  delete fJetDefsR[ir];
+  fClustSeqR.clear();
+  fJetDefsR.clear();
+  fInclusiveJetsR.clear();
   #ifdef FASTJET_VERSION
   if (fBkrdEstimator)          { delete fBkrdEstimator; fBkrdEstimator = NULL; }
   if (fGenSubtractor)          { delete fGenSubtractor; fGenSubtractor = NULL; }
@@ -398,6 +461,8 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fNThreads         = wrapper.fNThreads;
+  fAdditionalRadii  = wrapper.fAdditionalRadii;
 }
 
 //_________________________________________________________________________________________________
@@ -520,6 +585,59 @@ Double_t AliFJWrapper::GetJetArea(UInt_t idx) const
   return retval;
 }
 
+//_________________________________________________________________________________________________
+const std::vector<fastjet::PseudoJet>& AliFJWrapper::GetInclusiveJetsR(UInt_t ir) const
+{
+  // Get the inclusive jets of the additional radius ir.
+
+  static const std::vector<fastjet::PseudoJet> empty;
+  if ( ir < fInclusiveJetsR.size() ) return fInclusiveJetsR[ir];
+  AliError(Form("[e] ::GetInclusiveJetsR wrong radius index: %d",ir));
+  return empty;
+}
+
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::GetJetAreaR(UInt_t ir, UInt_t idx) const
+{
+  // Get the area of a jet of the additional radius ir.
+
+  Double_t retval = -1; // really wrong area..
+  if ( ir < fInclusiveJetsR.size() && idx < fInclusiveJetsR[ir].size() ) {
+    retval = fClustSeqR[ir]->area(fInclusiveJetsR[ir][idx]);
+  } else {
+    AliError(Form("[e] ::GetJetAreaR wrong index: %d, %d",ir,idx));
+  }
+  return retval;
+}
+
+//_________________________________________________________________________________________________
+fastjet::PseudoJet AliFJWrapper::GetJetAreaVectorR(UInt_t ir, UInt_t idx) const
+{
+  // Get the area as vector of a jet of the additional radius ir.
+
+  fastjet::PseudoJet retval;
+  if ( ir < fInclusiveJetsR.size() && idx < fInclusiveJetsR[ir].size() ) {
+    retval = fClustSeqR[ir]->area_4vector(fInclusiveJetsR[ir][idx]);
+  } else {
+    AliError(Form("[e] ::GetJetAreaVectorR wrong index: %d, %d",ir,idx));
+  }
+  return retval;
+}
+
+//_________________________________________________________________________________________________
+std::vector<fastjet::PseudoJet> AliFJWrapper::GetJetConstituentsR(UInt_t ir, UInt_t idx) const
+{
+  // Get the constituents of a jet of the additional radius ir.
+
+  std::vector<fastjet::PseudoJet> retval;
+  if ( ir < fInclusiveJetsR.size() && idx < fInclusiveJetsR[ir].size() ) {
+    retval = fClustSeqR[ir]->constituents(fInclusiveJetsR[ir][idx]);
+  } else {
+    AliError(Form("[e] ::GetJetConstituentsR wrong index: %d, %d",ir,idx));
+  }
+  return retval;
+}
+
 //_________________________________________________________________________________________________
 Double_t AliFJWrapper::GetEventSubJetArea(UInt_t idx) const
 {
@@ -745,12 +863,18 @@ Int_t AliFJWrapper::Run()
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
 
+  // in multi-radius mode remember the state of the ghost generator,
+  // such that all radii are clustered with the same ghosts
+  std::vector<int> ghostStatus;
+  if (!fAdditionalRadii.empty() && fGhostedAreaSpec) fGhostedAreaSpec->get_random_status(ghostStatus);
+
   try {
     fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
     if(fEventSub){
       DoEventConstituentSubtraction();
       fClustSeqES = new fj::ClusterSequenceArea(fEventSubCorrectedVectors, *fJetDef, *fAreaDef);
     }
+    if (!fAdditionalRadii.empty()) RunAdditionalRadii(ghostStatus);
   } catch (fj::Error) {
     AliError(" [w] FJ Exception caught.");
     return -1;
@@ -772,6 +896,33 @@ Int_t AliFJWrapper::Run()
   return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliFJWrapper::RunAdditionalRadii(const std::vector<int>& ghostStatus)
+{
+  // Cluster the input vectors with each of the additional radii.
+  // The ghost generator is rewound to the state used for the main radius before each
+  // clustering, hence all radii see the same ghosts and the jet areas are consistent.
+  // Afterwards the generator is left where the main clustering left it, so that the
+  // main radius gives the same result as without additional radii.
+
+  if (fAlgor == fj::plugin_algorithm) {
+    AliError("[e] Additional radii are not supported for plugin algorithms!");
+    return;
+  }
+
+  std::vector<int> ghostStatusAfter;
+  if (fGhostedAreaSpec) fGhostedAreaSpec->get_random_status(ghostStatusAfter);
+
+  for (UInt_t ir = 0; ir < fAdditionalRadii.size(); ir++) {
+    fJetDefsR.push_back(new fj::JetDefinition(fAlgor, fAdditionalRadii[ir], fScheme, fStrategy));
+    if (fGhostedAreaSpec) fGhostedAreaSpec->set_random_status(ghostStatus);
+    fClustSeqR.push_back(new fj::ClusterSequenceArea(fInputVectors, *fJetDefsR.back(), *fAreaDef));
+    fInclusiveJetsR.push_back(fClustSeqR.back()->inclusive_jets(0.0));
+  }
+
+  if (fGhostedAreaSpec) fGhostedAreaSpec->set_random_status(ghostStatusAfter);
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::Filter()
 {
@@ -887,47 +1038,121 @@ void AliFJWrapper::SubtractBackground(Double_t median_pt)
 
 //_________________________________________________________________________________________________
 void AliFJWrapper::DoGenericSubtraction(const fastjet::FunctionOfPseudoJet<Double32_t>& jetshape, std::vector<fastjet::contrib::GenericSubtractorInfo>& output) {
-  //Do generic subtraction for 1subjettiness
+  //Do generic subtraction for a single jet shape
 #ifdef FASTJET_VERSION
-  CreateGenSub();
-  
-  // clear the generic subtractor info vector
-  output.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo info_jetshape;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(jetshape, fInclusiveJets[i], info_jetshape);
-    output.push_back(info_jetshape);
-  }
+  std::vector<const fj::FunctionOfPseudoJet<Double32_t>*> jetshapes(1, &jetshape);
+  std::vector<std::vector<fj::contrib::GenericSubtractorInfo>*> outputs(1, &output);
+  DoGenericSubtraction(jetshapes, outputs);
 #endif
 }
 
 //_________________________________________________________________________________________________
-Int_t AliFJWrapper::DoGenericSubtractionJetMass() {
-  //Do generic subtraction for jet mass
+void AliFJWrapper::DoGenericSubtraction(const std::vector<const fastjet::FunctionOfPseudoJet<Double32_t>*>& jetshapes, const std::vector<std::vector<fastjet::contrib::GenericSubtractorInfo>*>& outputs) {
+  //Do generic subtraction for several jet shapes in one pass over the jets.
+  //All shapes share the same subtractor and background estimate; every (jet, shape)
+  //pair is an independent task and the tasks are distributed over fNThreads threads.
 #ifdef FASTJET_VERSION
+  if (jetshapes.size() != outputs.size()) {
+    AliError(Form("Number of jet shapes (%lu) and output vectors (%lu) differ", jetshapes.size(), outputs.size()));
+    return;
+  }
+
   CreateGenSub();
+  if (!fUseExternalBkg) PrepareBkgEstimator();
 
-  // Define jet shape
-  AliJetShapeMass shapeMass;
+  const UInt_t nshapes = jetshapes.size();
+  const UInt_t njets   = fInclusiveJets.size();
 
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetMass.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo info;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapeMass, fInclusiveJets[i], info);
-    fGenSubtractorInfoJetMass.push_back(info);
+  // clear the generic subtractor info vectors, one entry per inclusive jet
+  for (UInt_t is = 0; is < nshapes; is++) {
+    outputs[is]->assign(njets, fj::contrib::GenericSubtractorInfo());
+  }
+
+  ProcessTasks(njets * nshapes, [&](UInt_t itask) {
+      const UInt_t ij = itask / nshapes;
+      const UInt_t is = itask % nshapes;
+      if (fInclusiveJets[ij].perp() > 1.e-4)
+        (*fGenSubtractor)(*jetshapes[is], fInclusiveJets[ij], (*outputs[is])[ij]);
+    });
+#endif
+}
+
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::DoGenericSubtractionJetShapes(UInt_t shapes) {
+  //Do generic subtraction for all jet shapes selected in the bit mask (see EGenSubJetShape_t)
+#ifdef FASTJET_VERSION
+  AliJetShapeMass               shapeMass;
+  AliJetShapeAngularity         shapeAngularity;
+  AliJetShapepTD                shapepTD;
+  AliJetShapeCircularity        shapeCircularity;
+  AliJetShapeSigma2             shapeSigma2;
+  AliJetShapeConstituent        shapeConstituent;
+  AliJetShapeLeSub              shapeLeSub;
+  AliJetShape1subjettiness_kt   shape1subjettiness_kt;
+  AliJetShape2subjettiness_kt   shape2subjettiness_kt;
+  AliJetShape3subjettiness_kt   shape3subjettiness_kt;
+  AliJetShapeOpeningAngle_kt    shapeOpeningAngle_kt;
+  AliJetShape1subjettiness_ca   shape1subjettiness_ca;
+  AliJetShape2subjettiness_ca   shape2subjettiness_ca;
+  AliJetShapeOpeningAngle_ca    shapeOpeningAngle_ca;
+  AliJetShape1subjettiness_akt02 shape1subjettiness_akt02;
+  AliJetShape2subjettiness_akt02 shape2subjettiness_akt02;
+  AliJetShapeOpeningAngle_akt02 shapeOpeningAngle_akt02;
+  AliJetShape1subjettiness_casd shape1subjettiness_casd;
+  AliJetShape2subjettiness_casd shape2subjettiness_casd;
+  AliJetShapeOpeningAngle_casd  shapeOpeningAngle_casd;
+
+  const struct {
+    UInt_t                                                bit;
+    const fj::FunctionOfPseudoJet<Double32_t>            *shape;
+    std::vector<fj::contrib::GenericSubtractorInfo>      *output;
+  } allshapes[] = {
+    { kGenSubJetMass,                &shapeMass,                &fGenSubtractorInfoJetMass                },
+    { kGenSubJetAngularity,          &shapeAngularity,          &fGenSubtractorInfoJetAngularity          },
+    { kGenSubJetpTD,                 &shapepTD,                 &fGenSubtractorInfoJetpTD                 },
+    { kGenSubJetCircularity,         &shapeCircularity,         &fGenSubtractorInfoJetCircularity         },
+    { kGenSubJetSigma2,              &shapeSigma2,              &fGenSubtractorInfoJetSigma2              },
+    { kGenSubJetConstituent,         &shapeConstituent,         &fGenSubtractorInfoJetConstituent         },
+    { kGenSubJetLeSub,               &shapeLeSub,               &fGenSubtractorInfoJetLeSub               },
+    { kGenSubJet1subjettiness_kt,    &shape1subjettiness_kt,    &fGenSubtractorInfoJet1subjettiness_kt    },
+    { kGenSubJet2subjettiness_kt,    &shape2subjettiness_kt,    &fGenSubtractorInfoJet2subjettiness_kt    },
+    { kGenSubJet3subjettiness_kt,    &shape3subjettiness_kt,    &fGenSubtractorInfoJet3subjettiness_kt    },
+    { kGenSubJetOpeningAngle_kt,     &shapeOpeningAngle_kt,     &fGenSubtractorInfoJetOpeningAngle_kt     },
+    { kGenSubJet1subjettiness_ca,    &shape1subjettiness_ca,    &fGenSubtractorInfoJet1subjettiness_ca    },
+    { kGenSubJet2subjettiness_ca,    &shape2subjettiness_ca,    &fGenSubtractorInfoJet2subjettiness_ca    },
+    { kGenSubJetOpeningAngle_ca,     &shapeOpeningAngle_ca,     &fGenSubtractorInfoJetOpeningAngle_ca     },
+    { kGenSubJet1subjettiness_akt02, &shape1subjettiness_akt02, &fGenSubtractorInfoJet1subjettiness_akt02 },
+    { kGenSubJet2subjettiness_akt02, &shape2subjettiness_akt02, &fGenSubtractorInfoJet2subjettiness_akt02 },
+    { kGenSubJetOpeningAngle_akt02,  &shapeOpeningAngle_akt02,  &fGenSubtractorInfoJetOpeningAngle_akt02  },
+    { kGenSubJet1subjettiness_casd,  &shape1subjettiness_casd,  &fGenSubtractorInfoJet1subjettiness_casd  },
+    { kGenSubJet2subjettiness_casd,  &shape2subjettiness_casd,  &fGenSubtractorInfoJet2subjettiness_casd  },
+    { kGenSubJetOpeningAngle_casd,   &shapeOpeningAngle_casd,   &fGenSubtractorInfoJetOpeningAngle_casd   }
+  };
+
+  std::vector<const fj::FunctionOfPseudoJet<Double32_t>*> jetshapes;
+  std::vector<std::vector<fj::contrib::GenericSubtractorInfo>*> outputs;
+  for (const auto& entry : allshapes) {
+    if (!(shapes & entry.bit)) continue;
+    jetshapes.push_back(entry.shape);
+    outputs.push_back(entry.output);
   }
+  if (!jetshapes.empty()) DoGenericSubtraction(jetshapes, outputs);
 #endif
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::DoGenericSubtractionJetMass() {
+  //Do generic subtraction for jet mass
+  return DoGenericSubtractionJetShapes(kGenSubJetMass);
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionGR(Int_t ijet) {
   //Do generic subtraction for jet mass
 #ifdef FASTJET_VERSION
   CreateGenSub();
+  if (!fUseExternalBkg) PrepareBkgEstimator();
 
   if(ijet>fInclusiveJets.size()) return 0;
 
@@ -936,152 +1161,73 @@ Int_t AliFJWrapper::DoGenericSubtractionGR(Int_t ijet) {
   fGRNumeratorSub.clear();
   fGRDenominatorSub.clear();
 
-  // Define jet shape
+  // Define jet shapes, one numerator and denominator per radial bin
+  std::vector<AliJetShapeGRNum> shapesGRNum;
+  std::vector<AliJetShapeGRDen> shapesGRDen;
   for(Double_t r = 0.; r<fRMax; r+=fDRStep) {
-    AliJetShapeGRNum shapeGRNum(r,fDRStep);
-    AliJetShapeGRDen shapeGRDen(r,fDRStep);
-
-    // clear the generic subtractor info vector
-    fGenSubtractorInfoGRNum.clear();
-    fGenSubtractorInfoGRDen.clear();
-    fj::contrib::GenericSubtractorInfo infoNum;
-    fj::contrib::GenericSubtractorInfo infoDen;
-    if(fInclusiveJets[ijet].perp()>1.e-4) {
-      double sub_num = (*fGenSubtractor)(shapeGRNum, fInclusiveJets[ijet], infoNum);
-      double sub_den = (*fGenSubtractor)(shapeGRDen, fInclusiveJets[ijet], infoDen);
-    }
-    fGenSubtractorInfoGRNum.push_back(infoNum);
-    fGenSubtractorInfoGRDen.push_back(infoDen);
-    fGRNumerator.push_back(infoNum.unsubtracted());
-    fGRDenominator.push_back(infoDen.unsubtracted());
-    fGRNumeratorSub.push_back(infoNum.second_order_subtracted());
-    fGRDenominatorSub.push_back(infoDen.second_order_subtracted());
+    shapesGRNum.push_back(AliJetShapeGRNum(r,fDRStep));
+    shapesGRDen.push_back(AliJetShapeGRDen(r,fDRStep));
+  }
+  const UInt_t nbins = shapesGRNum.size();
+
+  // the radial bins are independent, subtract them in parallel
+  std::vector<fj::contrib::GenericSubtractorInfo> infoNum(nbins);
+  std::vector<fj::contrib::GenericSubtractorInfo> infoDen(nbins);
+  if(fInclusiveJets[ijet].perp()>1.e-4) {
+    ProcessTasks(2 * nbins, [&](UInt_t itask) {
+        const UInt_t ibin = itask / 2;
+        if (itask % 2 == 0) (*fGenSubtractor)(shapesGRNum[ibin], fInclusiveJets[ijet], infoNum[ibin]);
+        else                (*fGenSubtractor)(shapesGRDen[ibin], fInclusiveJets[ijet], infoDen[ibin]);
+      });
+  }
+
+  // keep the info of the last radial bin as before
+  fGenSubtractorInfoGRNum.clear();
+  fGenSubtractorInfoGRDen.clear();
+  if (nbins > 0) {
+    fGenSubtractorInfoGRNum.push_back(infoNum[nbins-1]);
+    fGenSubtractorInfoGRDen.push_back(infoDen[nbins-1]);
+  }
+  for (UInt_t ibin = 0; ibin < nbins; ibin++) {
+    fGRNumerator.push_back(infoNum[ibin].unsubtracted());
+    fGRDenominator.push_back(infoDen[ibin].unsubtracted());
+    fGRNumeratorSub.push_back(infoNum[ibin].second_order_subtracted());
+    fGRDenominatorSub.push_back(infoDen[ibin].second_order_subtracted());
   }
 #endif
   return 0;
 }
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetAngularity() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapeAngularity shapeAngularity;
-
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetAngularity.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infoAng;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapeAngularity, fInclusiveJets[i], infoAng);
-    fGenSubtractorInfoJetAngularity.push_back(infoAng);
-  }
-#endif
-  return 0;
+  //Do generic subtraction for jet angularity
+  return DoGenericSubtractionJetShapes(kGenSubJetAngularity);
 }
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetpTD() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapepTD shapepTD;
-
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetpTD.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infopTD;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapepTD, fInclusiveJets[i], infopTD);
-    fGenSubtractorInfoJetpTD.push_back(infopTD);
-  }
-#endif
-  return 0;
+  //Do generic subtraction for jet pTD
+  return DoGenericSubtractionJetShapes(kGenSubJetpTD);
 }
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetCircularity() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapeCircularity shapecircularity;
-
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetCircularity.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infoCirc;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapecircularity, fInclusiveJets[i], infoCirc);
-    fGenSubtractorInfoJetCircularity.push_back(infoCirc);
-  }
-#endif
- return 0;
+  //Do generic subtraction for jet circularity
+  return DoGenericSubtractionJetShapes(kGenSubJetCircularity);
 }
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetSigma2() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapeSigma2 shapesigma2;
-
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetSigma2.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infoSigma;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapesigma2, fInclusiveJets[i], infoSigma);
-    fGenSubtractorInfoJetSigma2.push_back(infoSigma);
-  }
-#endif
-  return 0;
+  //Do generic subtraction for jet sigma2
+  return DoGenericSubtractionJetShapes(kGenSubJetSigma2);
 }
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetConstituent() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapeConstituent shapeconst;
-
-  // clear the generic subtractor info vector
-   fGenSubtractorInfoJetConstituent.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infoConst;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapeconst, fInclusiveJets[i], infoConst);
-    fGenSubtractorInfoJetConstituent.push_back(infoConst);
-  }
-#endif
-  return 0;
+  //Do generic subtraction for the number of constituents
+  return DoGenericSubtractionJetShapes(kGenSubJetConstituent);
 }
 
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJetLeSub() {
-  //Do generic subtraction for jet mass
-#ifdef FASTJET_VERSION
-  CreateGenSub();
-
-  // Define jet shape
-  AliJetShapeLeSub shapeLeSub;
-
-  // clear the generic subtractor info vector
-  fGenSubtractorInfoJetLeSub.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::contrib::GenericSubtractorInfo infoLeSub;
-    if(fInclusiveJets[i].perp()>1.e-4)
-      double subtracted_shape = (*fGenSubtractor)(shapeLeSub, fInclusiveJets[i], infoLeSub);
-    fGenSubtractorInfoJetLeSub.push_back(infoLeSub);
-  }
-#endif
-  return 0;
+  //Do generic subtraction for LeSub
+  return DoGenericSubtractionJetShapes(kGenSubJetLeSub);
 }
-
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoGenericSubtractionJet1subjettiness_kt() {
   //Do generic subtraction for 1subjettiness
@@ -1234,14 +1380,14 @@ Int_t AliFJWrapper::DoConstituentSubtraction() {
   // fConstituentSubtractor->set_alpha(/* double alpha */);
   // fConstituentSubtractor->set_max_deltaR(/* double max_deltaR */);
 
+  if (!fUseExternalBkg) PrepareBkgEstimator();
+
   //clear constituent subtracted jets
-  fConstituentSubtrJets.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::PseudoJet subtracted_jet(0.,0.,0.,0.);
-    if(fInclusiveJets[i].perp()>0.)
-      subtracted_jet = (*fConstituentSubtractor)(fInclusiveJets[i]);
-    fConstituentSubtrJets.push_back(subtracted_jet);
-  }
+  fConstituentSubtrJets.assign(fInclusiveJets.size(), fj::PseudoJet(0.,0.,0.,0.));
+  ProcessTasks(fInclusiveJets.size(), [&](UInt_t i) {
+      if(fInclusiveJets[i].perp()>0.)
+        fConstituentSubtrJets[i] = (*fConstituentSubtractor)(fInclusiveJets[i]);
+    });
   if(fConstituentSubtractor) { delete fConstituentSubtractor; fConstituentSubtractor = NULL; }
 
 #endif
@@ -1351,6 +1497,73 @@ Int_t AliFJWrapper::CreateEventConstituentSub() {
   return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliFJWrapper::PrepareBkgEstimator() {
+  // The background estimator computes rho lazily on first access and caches the result.
+  // Trigger the computation once, before the subtractors query it from several threads.
+  #ifdef FASTJET_VERSION
+  if (!fBkrdEstimator) return;
+  fBkrdEstimator->rho();
+  #if FASTJET_VERSION_NUMBER >= 30100
+  fBkrdEstimator->rho_m();
+  #endif
+  #endif
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::SetNThreads(Int_t n)
+{
+  // Set the number of threads used to process the jets in the subtraction steps.
+  // Concurrent access to the cluster sequence requires a thread safe FastJet
+  // (configured with --enable-thread-safety), otherwise the jets are processed serially.
+
+  fNThreads = n > 1 ? n : 1;
+#ifndef FASTJET_HAVE_THREAD_SAFETY
+  if (fNThreads > 1) {
+    AliWarningGeneral("AliFJWrapper", Form("FastJet was built without thread safety, ignoring request for %d threads", fNThreads));
+    fNThreads = 1;
+  }
+#endif
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::ProcessTasks(UInt_t ntasks, const std::function<void(UInt_t)>& task) const
+{
+  // Execute task(i) for all i < ntasks, distributed over up to fNThreads threads.
+  // The calling thread takes part in the work. The first exception thrown by a task
+  // stops the remaining tasks and is rethrown once all threads have joined.
+
+  UInt_t nthreads = fNThreads > 1 ? fNThreads : 1;
+  if (nthreads > ntasks) nthreads = ntasks;
+  if (nthreads <= 1) {
+    for (UInt_t i = 0; i < ntasks; i++) task(i);
+    return;
+  }
+
+  std::atomic<UInt_t> next(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&]() {
+    for (UInt_t i = next++; i < ntasks; i = next++) {
+      try {
+        task(i);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) error = std::current_exception();
+        next = ntasks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (UInt_t it = 1; it < nthreads; it++) threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads) t.join();
+
+  if (error) std::rethrow_exception(error);
+}
+
 //_________________________________________________________________________________________________
 void AliFJWrapper::SetupAlgorithmfromOpt(const char *option)
 {
@@ -60,7 +60,10 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fCutTable(),
+    fNTable(),
+    fFitTable()
 {
   // 
   // Constructor 
@@ -98,7 +101,10 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fCutTable(),
+    fNTable(),
+    fFitTable()
 {
   // 
   // Constructor 
@@ -167,7 +173,10 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fCutTable(o.fCutTable),
+  fNTable(o.fNTable),
+  fFitTable(o.fFitTable)
 {
   // 
   // Copy constructor 
@@ -232,6 +241,9 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fCutTable           = o.fCutTable;
+  fNTable             = o.fNTable;
+  fFitTable           = o.fFitTable;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -401,6 +413,12 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   // We do not use TArrayD because we do not wont a bounds check 
   // TArrayD etaCache(20*512); // Same number of strips per ring
   // TArrayD phiCache(20*512); // whether it is inner our outer. 
+  Char_t   hitCache[512];    // Poisson observations of one sector 
+  Double_t wgtCache[512];    // and their weights 
+
+  // Tables made by CacheMaxWeights, indexed by ring and eta bin 
+  TAxis*   cutAxis  = fLowCuts->GetXaxis();
+  Int_t    nEtaBins = cutAxis->GetNbins();
   
   // --- Loop over detectors -----------------------------------------
   for (UShort_t d=1; d<=3; d++) { 
@@ -420,6 +438,11 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       rh->fPoisson.Reset(0);
       rh->fTotal->Reset();
       rh->fGood->Reset();
+
+      // Offset of this ring in the tables, and acceptance correction
+      // per strip (skipping the underflow bin) 
+      Int_t           tOff = (d == 1 ? 0 : 2*d-3+q) * (nEtaBins+2);
+      const Double_t* acc  = (q == 0 ? fAccI : fAccO)->GetArray() + 1;
       // rh->ResetPoissonHistos(h, fEtaLumping, fPhiLumping);
 
       // Reset our eta cache 
@@ -433,7 +456,8 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
-	  
+	  hitCache[t] = -1; // Not observed unless set below
+
 	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
 	  Double_t phi    = fmd.Phi(d,r,s,t) * TMath::DegToRad();
 	  Double_t eta    = fmd.Eta(d,r,s,t);
@@ -485,18 +509,29 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
 	  // --- Apply phi corner correction to eloss ----------------
 	  if (fUsePhiAcceptance == kPhiCorrectELoss) 
-	    mult *= AcceptanceCorrection(r,t);
+	    mult *= Float_t(acc[t]);
 
 	  // --- Get the low multiplicity cut ------------------------
+	  // Same bin as GetMultCut(d,r,eta).  The fit is looked up with
+	  // eta as a float, as NParticles does.
 	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+	  Int_t    bin  = 0;
+	  if (eta != AliESDFMD::kInvalidEta) {
+	    bin = cutAxis->FindBin(eta);
+	    cut = fCutTable[tOff+bin];
+	  }
 	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
 			   d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
 	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (cut > 0 && mult > cut) {
+	    Float_t feta = eta;
+	    Int_t   fbin = (feta == eta ? bin : cutAxis->FindBin(feta));
+	    if (fbin > nEtaBins) fbin = 0;
+	    n = NParticlesFromTable(mult,d,r,feta,tOff+fbin,lowFlux);
+	  }
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -507,7 +542,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  // Temporary stuff - remove Correction call 
 	  Double_t c = 1;
 	  if (fUsePhiAcceptance == kPhiCorrectNch) 
-	    c = AcceptanceCorrection(r,t);
+	    c = Float_t(acc[t]);
 	  // Double_t c = Correction(d,r,t,eta,lowFlux);
 	  ADD_TIMER(timer,corrTime);
 	  fCorrections->Fill(c);
@@ -528,12 +563,18 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	    }
 	    rh->fSignal->Fill(eta, mult);
 	  }
-	  rh->fPoisson.Fill(t,s,hit,1./c);
+	  hitCache[t] = hit;
+	  wgtCache[t] = 1./c;
 	  h->Fill(eta,phi,n);
 
 	  // --- If we use ELoss fits, apply now ---------------------
 	  if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
 	} // for t
+
+	// --- Accumulate Poisson statistics for the whole sector ------
+	START_TIMER(timer);
+	rh->fPoisson.FillRow(s, nt, hitCache, wgtCache);
+	ADD_TIMER(timer,poissonTime);
       } // for s 
 
       // --- Automatic acceptance - Calculate as an efficiency -------
@@ -771,6 +812,32 @@ AliFMDDensityCalculator::CacheMaxWeights(const TAxis& axis)
 
   // Cache cuts in histogram
   fCuts.FillHistogram(fLowCuts);
+
+  // Cache cuts, fits, and number of particles to sum per ring and eta
+  // bin (including under- and overflow) so that Calculate can look
+  // them up directly.  The indexing is the same as for
+  // GetMultCut(d,r,eta) and NParticles.
+  Int_t nBins = nEta + 2;
+  fCutTable.Set(5*nBins);
+  fNTable.Set(5*nBins);
+  fFitTable.Clear();
+  fFitTable.Expand(5*nBins);
+  for (Int_t j = 0; j < 5; j++) { 
+    UShort_t       d   = (j == 0 ? 1 : (j+3)/2);
+    Char_t         r   = (j == 0 || j == 1 || j == 3 ? 'I' : 'O');
+    const TArrayI* max = (j == 0 ? &fFMD1iMax : j == 1 ? &fFMD2iMax : 
+			  j == 2 ? &fFMD2oMax : j == 3 ? &fFMD3iMax : 
+			  &fFMD3oMax);
+    for (Int_t b = 0; b < nBins; b++) { 
+      Int_t idx = j*nBins+b;
+      fCutTable[idx] = fLowCuts->GetBinContent(b, j+1);
+      // Out of range eta gives no fit (see AliFMDCorrELossFit::FindEtaBin)
+      Int_t fb       = (b > nEta ? 0 : b);
+      fFitTable.AddAt(cor->FindFit(d, r, fb, UShort_t(-1)), idx);
+      Int_t m        = (fb >= 1 && fb-1 < max->fN ? max->At(fb-1) : -1);
+      fNTable[idx]   = (m < 1 ? -1 : TMath::Min(fMaxParticles, UShort_t(m)));
+    }
+  }
 }
 
 //_____________________________________________________________________
@@ -890,6 +957,59 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   return ret;
 }
 
+//_____________________________________________________________________
+Float_t 
+AliFMDDensityCalculator::NParticlesFromTable(Float_t  mult, 
+					     UShort_t d, 
+					     Char_t   r, 
+					     Float_t  eta,
+					     Int_t    idx,
+					     Bool_t   lowFlux) const
+{
+  // 
+  // Get the number of particles corresponding to the signal mult
+  // using the tables of fits and maximum weights 
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    d        Detector
+  //    r        Ring 
+  //    eta      Pseudo-rapidity 
+  //    idx      Index of ring and eta bin in tables 
+  //    lowFlux  Low-flux flag 
+  // 
+  // Return:
+  //    The number of particles 
+  //
+  DGUARD(fDebug, 3, "Calculate Nch in FMD density calculator");
+  if (lowFlux) return 1;
+  
+  const AliFMDCorrELossFit::ELossFit* fit = 
+    static_cast<const AliFMDCorrELossFit::ELossFit*>(fFitTable.UncheckedAt(idx));
+  if (!fit) { 
+    AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
+		    d, r, eta, fMinQuality));
+    return 0;
+  }
+  
+  Int_t n = fNTable[idx];
+  if (n < 0) { 
+    AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
+    return 0;
+  }
+  
+  Double_t ret = fit->EvaluateWeighted(mult, n);
+  
+  if (fDebug > 10) {
+    AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
+  }
+    
+  fWeightedSum->Fill(ret);
+  fSumOfWeights->Fill(ret);
+  
+  return ret;
+}
+
 //_____________________________________________________________________
 Float_t 
 AliFMDDensityCalculator::Correction(UShort_t d, 
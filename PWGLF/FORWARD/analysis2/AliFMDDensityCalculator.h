@@ -16,6 +16,8 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -336,6 +338,27 @@ protected:
 			     Char_t   r, 
 			     Float_t  eta, 
 			     Bool_t   lowFlux) const;
+  /** 
+   * Get the number of particles corresponding to the signal mult,
+   * using the per-ring and @f$\eta@f$ bin tables made by
+   * CacheMaxWeights instead of looking up the fit and the maximum
+   * weight for each strip.  Otherwise the same as NParticles.
+   * 
+   * @param mult     Signal
+   * @param d        Detector
+   * @param r        Ring 
+   * @param eta      Pseudo-rapidity 
+   * @param idx      Index of the ring and @f$\eta@f$ bin in the tables 
+   * @param lowFlux  Low-flux flag 
+   * 
+   * @return The number of particles 
+   */
+  Float_t NParticlesFromTable(Float_t  mult, 
+			      UShort_t d, 
+			      Char_t   r, 
+			      Float_t  eta, 
+			      Int_t    idx,
+			      Bool_t   lowFlux) const;
   /** 
    * Get the inverse correction factor.  This consist of
    * 
@@ -504,6 +527,9 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  TArrayD                fCutTable;    //! Low cuts per ring and eta bin
+  TArrayI                fNTable;      //! # of particles to sum per ring and eta bin
+  TObjArray              fFitTable;    //! Energy loss fits (not owned) per ring and eta bin
 
   ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
 };
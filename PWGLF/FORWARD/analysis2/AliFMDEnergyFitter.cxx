@@ -202,6 +202,8 @@ AliFMDEnergyFitter::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("regCut",        fRegularizationCut));
   d->Add(AliForwardUtil::MakeParameter("deltaShift", 
 				       AliLandauGaus::EnableSigmaShift()));
+  d->Add(AliForwardUtil::MakeParameter("tabulatedLG", 
+				       AliLandauGaus::EnableTable()));
 
   if (fRingHistos.GetEntries() <= 0) { 
     AliFatal("No ring histograms where defined - giving up!");
@@ -298,6 +300,12 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetEnableTabulatedLandauGaus(Bool_t use) 
+{
+  AliLandauGaus::EnableTable(use ? 1 : 0);
+}
 
 //____________________________________________________________________
 Bool_t
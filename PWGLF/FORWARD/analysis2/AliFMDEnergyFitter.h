@@ -299,6 +299,14 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to evaluate the Landau-Gauss convolution from a
+   * pre-computed table rather than by numerical integration (see
+   * AliLandauGaus::EnableTable)
+   *
+   * @param use If true, use tabulated evaluation 
+   */
+  void SetEnableTabulatedLandauGaus(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <TObject.h>
 #include <TF1.h>
 #include <TMath.h>
+#include <vector>
 
 /** 
  * This class contains static member functions to calculate the energy
@@ -94,6 +95,18 @@
  * Landau with a Gaussian (see LandauGaus), and @f$ a@f$ is a vector of
  * weights for each @f$ f_i@f$. Note that @f$ a_1 = 1@f$.
  *
+ * Since the Landau-Gauss convolution only depends on @f$ x@f$ through
+ * @f$ u=(x-\Delta_p)/\xi@f$ and on the widths through
+ * @f$ r=\sigma'/\xi@f$,
+ *
+ * @f[ 
+ *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi} f(u;0,1,r)
+ * @f] 
+ *
+ * the function can be evaluated from a 2D table of @f$ f(u;0,1,r)@f$
+ * instead of doing the numerical integration on every call (see
+ * EnableTable).
+ *
  * Everything is defined in this header file to make it easy to move
  * this code around. Nothing here's meant to be persistent, so we
  * can easily do that. 
@@ -211,6 +224,22 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Calculate the value of a Landau convolved with a Gaussian by
+   * numerical integration, irrespective of whether the table is
+   * enabled.  See F for the parameters.
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FIntegral(Double_t x, Double_t delta, Double_t xi, 
+			    Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -283,6 +312,27 @@ public:
   static Double_t Fn(Double_t x, Double_t delta, Double_t xi, 
 		     Double_t sigma, Double_t sigma_n, Int_t n, 
 		     const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_N@f$ (see above) for an array of @f$ x@f$ values.
+   * The parameters of each @f$ f_i@f$ are calculated once for all
+   * @f$ x@f$ values.
+   * 
+   * @param m        Number of @f$ x@f$ values 
+   * @param x        Array of @f$ m@f$ @f$ x@f$ values 
+   * @param ret      Array of @f$ m@f$ values, on return @f$ f_N(x)@f$
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param n        @f$ N@f$ in the sum above.
+   * @param a        Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                 @f$ i > 1@f$ 
+   */
+  static void Fn(Int_t m, const Double_t* x, Double_t* ret, 
+		 Double_t delta, Double_t xi, 
+		 Double_t sigma, Double_t sigma_n, Int_t n, 
+		 const Double_t* a);
   /** 
    * Get parameters for the @f$ i@f$ particle response.
    *
@@ -326,6 +376,85 @@ public:
   static Double_t SigmaShift(Int_t i, Double_t xi, Double_t sigma);
   /* @} */
 
+  //__________________________________________________________________
+  /** 
+   * @{ 
+   * @name Tabulated evaluation 
+   */
+  //------------------------------------------------------------------
+  /** 
+   * Table of @f$ g(u,r) = f(u;0,1,r)@f$ on an equidistant grid in
+   * @f$ u@f$ and @f$\log r@f$.  Values are interpolated with
+   * 4-point (cubic) Lagrange polynomials in both directions.
+   */
+  struct Table 
+  {
+    /** Least @f$ u@f$ */
+    static Double_t UMin() { return -40; }
+    /** Largest @f$ u@f$ */
+    static Double_t UMax() { return 110; }
+    /** Number of @f$ u@f$ nodes */
+    static Int_t    NU()   { return 3001; }
+    /** Least @f$ r=\sigma'/\xi@f$ */
+    static Double_t RMin() { return 0.02; }
+    /** Largest @f$ r=\sigma'/\xi@f$ */
+    static Double_t RMax() { return 10; }
+    /** Number of @f$ r@f$ nodes */
+    static Int_t    NR()   { return 96; }
+    /** 
+     * Build the table (by numerical integration) and estimate the
+     * interpolation error.
+     */
+    Table();
+    /** 
+     * Look up @f$ g(u,r)@f$ 
+     * 
+     * @param u    @f$ u=(x-\Delta_p)/\xi@f$ 
+     * @param r    @f$ r=\sigma'/\xi@f$
+     * @param ret  On return, the interpolated value 
+     * 
+     * @return false if @f$(u,r)@f$ is not inside the table 
+     */
+    Bool_t Eval(Double_t u, Double_t r, Double_t& ret) const;
+    Double_t              fDU;    // Spacing in u 
+    Double_t              fLRMin; // log(RMin())
+    Double_t              fDLR;   // Spacing in log(r) 
+    std::vector<Double_t> fG;     // g(u,r) at [iR*NU()+iU]
+    Double_t              fError; // Largest interpolation error found
+  };
+  //------------------------------------------------------------------
+  /** 
+   * Set and check if the tabulated evaluation is enabled.  When
+   * enabled, F (and hence Fi, Fn, and all the TF1 functions) look up
+   * the Landau-Gauss convolution in a table (see Table) instead of
+   * integrating numerically.  Outside the table F falls back to the
+   * numerical integration.  The table is built on first use, which
+   * takes several seconds.
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the tabulated evaluation is enabled or not 
+   */
+  static Bool_t EnableTable(Short_t val=-1);
+  //------------------------------------------------------------------
+  /** 
+   * Get the table (building it if needed)
+   * 
+   * @return Reference to the table 
+   */
+  static const Table& GetTable();
+  //------------------------------------------------------------------
+  /** 
+   * Error bound of the tabulated evaluation.  This is the largest
+   * absolute difference between the interpolated and integrated
+   * @f$ g(u,r)@f$ found at the cell centres of the table, relative to
+   * the maximum of @f$ g(u,r)@f$ at the same @f$ r@f$. 
+   * 
+   * @return Relative error bound 
+   */
+  static Double_t TableError() { return GetTable().fError; }
+  /* @} */
+
   
   //__________________________________________________________________
   /** 
@@ -528,6 +657,20 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 		 Double_t sigma, Double_t sigmaN)
 {
   if (xi <= 0) return 0;
+  if (EnableTable()) { 
+    const Double_t sigma1 = sigmaN == 0 ? sigma : 
+      TMath::Sqrt(sigmaN*sigmaN + sigma*sigma);
+    Double_t g = 0;
+    if (GetTable().Eval((x - delta) / xi, sigma1 / xi, g)) return g / xi;
+  }
+  return FIntegral(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FIntegral(Double_t x, Double_t delta, Double_t xi,
+			 Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
 
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
@@ -575,6 +718,106 @@ AliLandauGaus::Fn(Double_t x, Double_t delta, Double_t xi,
   return result;
 }
 
+//____________________________________________________________________
+inline void
+AliLandauGaus::Fn(Int_t m, const Double_t* x, Double_t* ret, 
+		  Double_t delta, Double_t xi, 
+		  Double_t sigma, Double_t sigmaN, Int_t n, 
+		  const Double_t* a)
+{
+  for (Int_t j = 0; j < m; j++) ret[j] = 0;
+  for (Int_t i = 1; i <= n; i++) { 
+    Double_t deltaI = delta;
+    Double_t xiI    = xi;
+    Double_t sigmaI = sigma;
+    IPars(i, deltaI, xiI, sigmaI);
+    Double_t ai     = (i == 1 ? 1 : a[i-2]);
+    if (sigmaI < 1e-10) { 
+      // Fall back to landau 
+      for (Int_t j = 0; j < m; j++) ret[j] += ai * Fl(x[j], deltaI, xiI);
+      continue;
+    }
+    for (Int_t j = 0; j < m; j++) 
+      ret[j] += ai * F(x[j], deltaI, xiI, sigmaI, sigmaN);
+  }
+}
+
+//____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTable(Short_t val)
+{
+  static Bool_t enabled = false;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
+inline const AliLandauGaus::Table&
+AliLandauGaus::GetTable()
+{
+  static Table table;
+  return table;
+}
+//____________________________________________________________________
+inline 
+AliLandauGaus::Table::Table()
+  : fDU((UMax() - UMin()) / (NU() - 1)),
+    fLRMin(TMath::Log(RMin())),
+    fDLR((TMath::Log(RMax()) - TMath::Log(RMin())) / (NR() - 1)),
+    fG(NU()*NR()),
+    fError(0)
+{
+  const Int_t nU = NU();
+  const Int_t nR = NR();
+  for (Int_t k = 0; k < nR; k++) { 
+    Double_t r = TMath::Exp(fLRMin + k * fDLR);
+    for (Int_t j = 0; j < nU; j++) 
+      fG[k*nU+j] = FIntegral(UMin() + j * fDU, 0, 1, r, 0);
+  }
+
+  // Estimate the interpolation error at the cell centres of every
+  // 4th row in r and every 16th column in u.
+  for (Int_t k = 1; k < nR-2; k += 4) { 
+    Double_t r    = TMath::Exp(fLRMin + (k + .5) * fDLR);
+    Double_t gMax = 0;
+    Double_t dMax = 0;
+    for (Int_t j = 1; j < nU-2; j += 16) { 
+      Double_t u = UMin() + (j + .5) * fDU;
+      Double_t g = FIntegral(u, 0, 1, r, 0);
+      Double_t t = 0;
+      if (!Eval(u, r, t)) continue;
+      gMax       = TMath::Max(gMax, g);
+      dMax       = TMath::Max(dMax, TMath::Abs(t - g));
+    }
+    if (gMax > 0) fError = TMath::Max(fError, dMax / gMax);
+  }
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGaus::Table::Eval(Double_t u, Double_t r, Double_t& ret) const
+{
+  if (r <= 0) return false;
+  const Int_t    nU = NU();
+  const Double_t pu = (u - UMin()) / fDU;
+  const Double_t pr = (TMath::Log(r) - fLRMin) / fDLR;
+  // Need one node below and two above for the cubic interpolation 
+  if (pu < 1 || pu >= nU - 2 || pr < 1 || pr >= NR() - 2) return false;
+  const Int_t    j  = Int_t(pu);
+  const Int_t    k  = Int_t(pr);
+  const Double_t tu = pu - j;
+  const Double_t tr = pr - k;
+  // Lagrange weights for nodes -1, 0, 1, 2
+  const Double_t wu[] = { -tu*(tu-1)*(tu-2)/6, (tu+1)*(tu-1)*(tu-2)/2, 
+			  -(tu+1)*tu*(tu-2)/2, (tu+1)*tu*(tu-1)/6 };
+  const Double_t wr[] = { -tr*(tr-1)*(tr-2)/6, (tr+1)*(tr-1)*(tr-2)/2, 
+			  -(tr+1)*tr*(tr-2)/2, (tr+1)*tr*(tr-1)/6 };
+  ret = 0;
+  for (Int_t l = 0; l < 4; l++) { 
+    const Double_t* g   = &(fG[(k+l-1)*nU+j-1]);
+    ret += wr[l] * (wu[0]*g[0] + wu[1]*g[1] + wu[2]*g[2] + wu[3]*g[3]);
+  }
+  return true;
+}
+
 //____________________________________________________________________
 inline Double_t 
 AliLandauGaus::DFidPar(Double_t x, 
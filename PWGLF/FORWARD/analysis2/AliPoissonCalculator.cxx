@@ -322,6 +322,85 @@ AliPoissonCalculator::Fill(UShort_t x, UShort_t y, Bool_t hit, Double_t weight)
   else     fEmpty->Fill(x, y);
 }
 
+//____________________________________________________________________
+void
+AliPoissonCalculator::FillRow(UShort_t y, UShort_t nX, 
+			      const Char_t* hits, const Double_t* weights)
+{
+  // 
+  // Fill in the observations of a full row 
+  // 
+  // Parameters:
+  //    y       Y value
+  //    nX      Number of X values 
+  //    hits    Per X value: 1 if hit, 0 if empty, <0 if not observed
+  //    weights Per X value weight of hits 
+  //
+  TAxis* bx = fBasic->GetXaxis();
+  TAxis* rx = fTotal->GetXaxis();
+  if (bx->GetXbins()->GetSize() > 0 || rx->GetXbins()->GetSize() > 0) { 
+    for (UShort_t x = 0; x < nX; x++) 
+      if (hits[x] >= 0) Fill(x, y, hits[x], weights[x]);
+    return;
+  }
+  
+  // Row offsets in the bin arrays (TH2D stores (ix,iy) at 
+  // iy*(nx+2)+ix) 
+  Int_t     bRow   = (fBasic->GetYaxis()->FindFixBin(y) * 
+		      (fBasic->GetNbinsX()+2));
+  Int_t     rRow   = (fTotal->GetYaxis()->FindFixBin(y) * 
+		      (fTotal->GetNbinsX()+2));
+  Double_t* basic  = fBasic->GetArray() + bRow;
+  Double_t* basic2 = (fBasic->GetSumw2N() > 0 ? 
+		      fBasic->GetSumw2()->GetArray() + bRow : 0);
+
+  // Count observations and empty strips per region of the row 
+  const Int_t kMaxRegions = 1024;
+  Double_t total[kMaxRegions];
+  Double_t empty[kMaxRegions];
+  Int_t    nR   = fTotal->GetNbinsX()+2;
+  if (nR > kMaxRegions) { 
+    for (UShort_t x = 0; x < nX; x++) 
+      if (hits[x] >= 0) Fill(x, y, hits[x], weights[x]);
+    return;
+  }
+  for (Int_t i = 0; i < nR; i++) total[i] = empty[i] = 0;
+
+  Int_t nObs = 0;
+  Int_t nHit = 0;
+  for (UShort_t x = 0; x < nX; x++) { 
+    if (hits[x] < 0) continue;
+    Int_t ir   = rx->FindFixBin(x);
+    total[ir] += 1;
+    nObs++;
+    if (!hits[x]) { 
+      empty[ir] += 1;
+      continue;
+    }
+    Int_t    ib = bx->FindFixBin(x);
+    Double_t w  = weights[x];
+    basic[ib]  += w;
+    if (basic2) basic2[ib] += w * w;
+    nHit++;
+  }
+
+  Double_t* tot   = fTotal->GetArray() + rRow;
+  Double_t* tot2  = (fTotal->GetSumw2N() > 0 ? 
+		     fTotal->GetSumw2()->GetArray() + rRow : 0);
+  Double_t* emp   = fEmpty->GetArray() + rRow;
+  Double_t* emp2  = (fEmpty->GetSumw2N() > 0 ? 
+		     fEmpty->GetSumw2()->GetArray() + rRow : 0);
+  for (Int_t i = 0; i < nR; i++) { 
+    tot[i]             += total[i];
+    emp[i]             += empty[i];
+    if (tot2) tot2[i]  += total[i];
+    if (emp2) emp2[i]  += empty[i];
+  }
+  fTotal->SetEntries(fTotal->GetEntries() + nObs);
+  fEmpty->SetEntries(fEmpty->GetEntries() + (nObs - nHit));
+  fBasic->SetEntries(fBasic->GetEntries() + nHit);
+}
+
 //____________________________________________________________________
 Double_t 
 AliPoissonCalculator::CalculateMean(Double_t empty, Double_t total) const
@@ -126,6 +126,24 @@ public:
    * @param weight  Weight if this 
    */
   void Fill(UShort_t strip, UShort_t sec, Bool_t hit, Double_t weight=1);
+  /** 
+   * Fill in the observations of all strips of a sector in one go.
+   * This is the same as calling 
+   * @code 
+   * for (UShort_t t = 0; t < nStrips; t++) 
+   *   if (hits[t] >= 0) Fill(t, sec, hits[t], weights[t]);
+   * @endcode 
+   * but the counts of the regions are accumulated directly in the
+   * bin arrays.  Note, the statistics (mean, RMS) of the internal
+   * histograms are not updated. 
+   * 
+   * @param sec     Y axis bin number 
+   * @param nStrips Number of strips (X axis values) 
+   * @param hits    Per strip: 1 if hit, 0 if empty, negative if not observed
+   * @param weights Per strip weight of hits
+   */
+  void FillRow(UShort_t sec, UShort_t nStrips, 
+	       const Char_t* hits, const Double_t* weights);
   /** 
    * Calculate result and store in @a output
    * 
@@ -17,6 +17,7 @@
    Class to process/filter reconstruction information from ESD, ESD friends, MC and provide them for later reprocessing
    Filtering schema - low pt part is downscaled - to have flat pt spectra of selected topologies (tracks and V0s)
    Downscaling schema is controlled by downscaling factors
+     or per output stream by AliFilteredTreeDownscaling policies (deterministic hash sampling, rate budgets), see SetDownscaling
    Usage: 
      1.) Filtering on Lego train
      2.) expert QA for tracking (resolution efficiency)
@@ -79,6 +80,7 @@
 #include "AliMCEventHandler.h"
 #include "AliFilteredTreeEventCuts.h"
 #include "AliFilteredTreeAcceptanceCuts.h"
+#include "AliFilteredTreeDownscaling.h"
 
 #include "AliAnalysisTaskFilteredTree.h"
 #include "AliKFParticle.h"
@@ -91,6 +93,11 @@ using namespace std;
 
 ClassImp(AliAnalysisTaskFilteredTree)
 
+// tree names of the output streams, in the order of EOutputStream
+static const char *kOutputStreamNames[AliAnalysisTaskFilteredTree::kNOutputStreams] = {
+  "V0s", "highPt", "dEdx", "Laser", "MCEffTree", "CosmicPairs", "eventInfoTracks", "eventInfoV0", "itsTPC"
+};
+
   //_____________________________________________________________________________
   AliAnalysisTaskFilteredTree::AliAnalysisTaskFilteredTree(const char *name) 
   : AliAnalysisTaskSE(name)
@@ -133,10 +140,22 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCc(0)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
+  , fCurrentChunkHash(0)
   , fDummyTrack(0)
 {
   // Constructor
 
+  for (Int_t i=0; i<kNOutputStreams; i++) {
+    fStreamBasketSize[i]=0;
+    fStreamCompression[i]=-1;
+    fStreamAutoFlush[i]=0;
+    fStreams[i]=0;
+    fStreamTuned[i]=kFALSE;
+    fFriendBranches[i][0]=0;
+    fFriendBranches[i][1]=0;
+    fDownscaling[i]=0;
+  }
+
   // Define input and output slots here
   DefineOutput(1, TTree::Class());
   DefineOutput(2, TTree::Class());
@@ -157,6 +176,7 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  for (Int_t i=0; i<kNOutputStreams; i++) delete fDownscaling[i];
 }
 
 //____________________________________________________________________________
@@ -183,6 +203,19 @@ Bool_t AliAnalysisTaskFilteredTree::Notify()
     Printf("Processing %d. file: %s", count, fns.Data());
     fCurrentFileName = fns.Data();
   }
+  //
+  // chunk key of the deterministic down-sampling in MC: the run and chunk
+  // directories only, independent of how the chunk was accessed
+  // (alien:// URL, local copy, OutputDir)
+  TObjArray *pathTokens = fCurrentFileName.String().Tokenize("/");
+  Int_t nPathTokens = pathTokens->GetEntriesFast();
+  TString chunkName;
+  for (Int_t i=TMath::Max(0,nPathTokens-3); i<nPathTokens-1; i++) {
+    chunkName += "/";
+    chunkName += pathTokens->At(i)->GetName();
+  }
+  delete pathTokens;
+  fCurrentChunkHash = chunkName.Hash();
 
   return kTRUE;
 }
@@ -200,12 +233,12 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
 
   //
   // Create trees
-  fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-  fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
-  fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
-  fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
-  fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
-  fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  fV0Tree = Stream(kV0sStream).GetTree();
+  fHighPtTree = Stream(kHighPtStream).GetTree();
+  fdEdxTree = Stream(kdEdxStream).GetTree();
+  fLaserTree = Stream(kLaserStream).GetTree();
+  fMCEffTree = Stream(kMCEffStream).GetTree();
+  fCosmicPairsTree = Stream(kCosmicPairsStream).GetTree();
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -359,6 +392,16 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     AliInfo(Form(" fFriendDownscaling=%f",fFriendDownscaling));
   }
   //
+  // keys of the deterministic down-sampling
+  //
+  // period/orbit/bunch crossing are unique in data, but constant in MC: only
+  // there the chunk and the event number in the chunk are added to the key
+  ULong64_t eventGID = (((ULong64_t)fESD->GetPeriodNumber() << 36) | ((ULong64_t)fESD->GetOrbitNumber() << 12) | (ULong64_t)fESD->GetBunchCrossNumber());
+  ULong64_t chunkEventId = fMC ? (((ULong64_t)fCurrentChunkHash << 32) | (ULong64_t)fESD->GetEventNumberInFile()) : 0;
+  for (Int_t i=0; i<kNOutputStreams; i++) {
+    if (fDownscaling[i]) fDownscaling[i]->NewEvent(fESD->GetRunNumber(), eventGID, chunkEventId);
+  }
+  //
   //
   //
   if(fProcessAll) { 
@@ -377,6 +420,7 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  TuneStreams();
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -492,24 +536,14 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"CosmicPairs").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	if (IsFriendSizeExceeded(kCosmicPairsStream,"friendTrack0")) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
-      (*fTreeSRedirector)<<"CosmicPairs"<<
+      Stream(kCosmicPairsStream)<<
         "gid="<<gid<<                         // global id of track
         "fileName.="<<&fCurrentFileName<<     // file name
         "runNumber="<<runNumber<<             // run number	    
@@ -688,11 +722,8 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       if(!accCuts->AcceptTrack(track)) continue;
 
       // downscale low-pT tracks
-      Double_t scalempt= TMath::Min(track->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if( downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
-      //printf("TMath::Exp(2*scalempt) %e, downscaleF %e \n",TMath::Exp(2*scalempt), downscaleF);
+      Bool_t isDownscaled = IsTrackDownscaled(kHighPtStream, track->Pt(), iTrack);
+      if( downscaleCounter>0 && isDownscaled) continue;
 
       AliExternalTrackParam * tpcInner = (AliExternalTrackParam *)(track->GetTPCInnerParam());
       if (!tpcInner) continue;
@@ -710,7 +741,7 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
       downscaleCounter++;
-      (*fTreeSRedirector)<<"highPt"<<
+      Stream(kHighPtStream)<<
         "gid="<<gid<<
         "fileName.="<<&fCurrentFileName<<            
         "runNumber="<<runNumber<<
@@ -764,10 +795,12 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
       AliESDfriendTrack* friendTrack=NULL;
       // suppress beam background and CE random reacks
       if (track->GetInnerParam()->Pt()<kMinPt) continue;
-      Bool_t skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
+      Bool_t skipTrack=kFALSE;
+      if (fDownscaling[kLaserStream]) skipTrack=!fDownscaling[kLaserStream]->Accept(track->GetInnerParam()->Pt(), iTrack);
+      else skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
       if (skipTrack) continue;
       if (esdFriend) {if (!esdFriend->TestSkipBit()) friendTrack = esdFriend->GetTrack(iTrack);} //this guy can be NULL      
-      (*fTreeSRedirector)<<"Laser"<<
+      Stream(kLaserStream)<<
         "gid="<<gid<<                          // global identifier of event
         "fileName.="<<&fCurrentFileName<<              //
         "runNumber="<<runNumber<<
@@ -933,7 +966,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
   Int_t evtTimeStamp = esdEvent->GetTimeStamp();
   Int_t evtNumberInFile = esdEvent->GetEventNumberInFile();
   Int_t mult = vtxESD->GetNContributors();
-  (*fTreeSRedirector)<<"eventInfoTracks"<<
+  Stream(kEventInfoTracksStream)<<
     "gid="<<gid<<
     "fileName.="<<&fCurrentFileName<<                // name of the chunk file (hopefully full)
     "runNumber="<<runNumber<<                             // runNumber
@@ -985,11 +1018,8 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
       if(!accCuts->AcceptTrack(track)) continue;
 
       // downscale low-pT tracks
-      Double_t scalempt= TMath::Min(track->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if( downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
-      //printf("TMath::Exp(2*scalempt) %e, downscaleF %e \n",TMath::Exp(2*scalempt), downscaleF);
+      Bool_t isDownscaled = IsTrackDownscaled(kHighPtStream, track->Pt(), iTrack);
+      if( downscaleCounter>0 && isDownscaled) continue;
 
       // Dump to the tree 
       // vertex
@@ -1377,17 +1407,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
 	if (fFriendDownscaling<=0){
-	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
-	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
-	    if (tree){
-	      Double_t sizeAll=tree->GetZipBytes();
-	      TBranch * br= tree->GetBranch("friendTrack.fPoints");
-	      Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	      br= tree->GetBranch("friendTrack.fCalibContainer");
-	      if (br) sizeFriend+=br->GetZipBytes();
-	      if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) friendTrackStore=0;
-	    }
-	  }
+	  if (IsFriendSizeExceeded(kHighPtStream,"friendTrack")) friendTrackStore=0;
 	}
 
 
@@ -1433,7 +1453,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	}
         if(fTreeSRedirector && dumpToTree && fFillTree) {
 	  downscaleCounter++;
-          (*fTreeSRedirector)<<"highPt"<<
+          Stream(kHighPtStream)<<
 	    "downscaleCounter="<<downscaleCounter<<   
             "gid="<<gid<<
             "fileName.="<<&fCurrentFileName<<                // name of the chunk file (hopefully full)
@@ -1476,7 +1496,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
             "centralityF="<<centralityF;
 	  // info for 2 track resolution studies and matching efficency studies 
 	  //
-	  (*fTreeSRedirector)<<"highPt"<<
+	  Stream(kHighPtStream)<<
 	    "paramITS.="<<&paramITS<<                // nearest ITS track  -   chi2 distance at vertex
 	    "paramITSC.="<<&paramITSC<<              // nearest ITS track  -  to constrained track   chi2 distance at vertex
 	    "paramComb.="<<&paramComb<<              // nearest comb. tack -   chi2 distance at inner wall
@@ -1492,7 +1512,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
             if (!refEMCAL) refEMCAL = &refDummy;
             if (!refPHOS) refPHOS = &refDummy;
 	    downscaleCounter++;
-            (*fTreeSRedirector)<<"highPt"<<	
+            Stream(kHighPtStream)<<	
               "multMCTrueTracks="<<multMCTrueTracks<<   // mC track multiplicities
               "nrefITS="<<nrefITS<<              // number of track references in the ITS
               "nrefTPC="<<nrefTPC<<              // number of track references in the TPC
@@ -1531,7 +1551,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
           }
           //finish writing the entry
           AliInfo("writing tree highPt");
-          (*fTreeSRedirector)<<"highPt"<<"\n";
+          Stream(kHighPtStream)<<"\n";
         }
         AliSysInfo::AddStamp("filteringTask",iTrack,numberOfTracks,numberOfFriendTracks,(friendTrackStore)?0:1);
         delete tpcInnerC;
@@ -1713,10 +1733,8 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       if(!prim) continue;
 
       // downscale low-pT particles
-      Double_t scalempt= TMath::Min(particle->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if (downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
+      Bool_t isDownscaled = IsTrackDownscaled(kMCEffStream, particle->Pt(), iMc);
+      if (downscaleCounter>0 && isDownscaled) continue;
       // is particle in acceptance
       if(!accCuts->AcceptTrack(particle)) continue;
 
@@ -1782,7 +1800,7 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       //
       if(fTreeSRedirector && fFillTree) {
 	downscaleCounter++;
-        (*fTreeSRedirector)<<"MCEffTree"<<
+        Stream(kMCEffStream)<<
           "fileName.="<<&fCurrentFileName<<
           "triggerClass.="<<&triggerClass<<
           "runNumber="<<runNumber<<
@@ -1926,7 +1944,7 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
   Int_t evtNumberInFile = esdEvent->GetEventNumberInFile();
   Int_t nV0s = esdEvent->GetNumberOfV0s();
   Int_t mult = vtxESD->GetNContributors();
-  (*fTreeSRedirector)<<"eventInfoV0"<<
+  Stream(kEventInfoV0Stream)<<
     "gid="<<gid<<
     "fileName.="<<&fCurrentFileName<<                // name of the chunk file (hopefully full)
     "run="<<run<<                             // runNumber
@@ -1989,24 +2007,14 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"V0s").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	if (IsFriendSizeExceeded(kV0sStream,"friendTrack0")) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
 
       //
-      Bool_t isDownscaled = IsV0Downscaled(v0);
+      Bool_t isDownscaled = IsV0Downscaled(v0, iv0);
       if (downscaleCounter>0 && isDownscaled) continue;
       AliKFParticle kfparticle; //
       Int_t type=GetKFParticle(v0,esdEvent,kfparticle);
@@ -2046,7 +2054,7 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
       }
 
       downscaleCounter++;
-      (*fTreeSRedirector)<<"V0s"<<
+      Stream(kV0sStream)<<
         "gid="<<gid<<                         //  global id of event
         "isDownscaled="<<isDownscaled<<       //  
         "triggerClass="<<&triggerClass<<      //  trigger
@@ -2178,6 +2186,7 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       if(!accCuts->AcceptTrack(track)) continue;
 
       if(!IsHighDeDxParticle(track)) continue;
+      if (fDownscaling[kdEdxStream] && !fDownscaling[kdEdxStream]->Accept(track->GetInnerParam()->GetP(), iTrack)) continue;
       TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
 
       if(!fFillTree) return;
@@ -2197,7 +2206,7 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       }
 	
       downscaleCounter++;
-      (*fTreeSRedirector)<<"dEdx"<<           // high dEdx tree
+      Stream(kdEdxStream)<<           // high dEdx tree
         "gid="<<gid<<                         // global id
         "fileName.="<<&fCurrentFileName<<     // file name
         "runNumber="<<runNumber<<
@@ -2340,13 +2349,19 @@ Int_t   AliAnalysisTaskFilteredTree::GetKFParticle(AliESDv0 *const v0, AliESDEve
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisTaskFilteredTree::IsV0Downscaled(AliESDv0 *const v0)
+Bool_t AliAnalysisTaskFilteredTree::IsV0Downscaled(AliESDv0 *const v0, Int_t v0Index)
 {
   //
   // Downscale randomly low pt V0
+  // With a down-sampling policy for the V0s stream, v0Index is the key of the V0 in the event
   //
   //return kFALSE;
   Double_t maxPt= TMath::Max(v0->GetParamP()->Pt(), v0->GetParamN()->Pt());
+  if (fDownscaling[kV0sStream]) {
+    // 10 times smaller downscaling for the gamma conversion candidates, as below
+    Double_t factorScale = (TMath::Abs(v0->GetEffMass(0,0))<0.2) ? 0.1 : 1.;
+    return !fDownscaling[kV0sStream]->Accept(maxPt, v0Index, factorScale);
+  }
   Double_t scalempt= TMath::Min(maxPt,10.);
   Double_t downscaleF = gRandom->Rndm();
   downscaleF *= fLowPtV0DownscaligF;
@@ -2565,6 +2580,104 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
+  for (Int_t i=0; i<kNOutputStreams; i++) {
+    fStreams[i]=0;
+    fFriendBranches[i][0]=0;
+    fFriendBranches[i][1]=0;
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::SetStreamTuning(EOutputStream stream, Int_t basketSize, Int_t compressionLevel, Long64_t autoFlush)
+{
+  //
+  // Set the basket size, the compression level and the auto flush of the tree
+  // of an output stream. Large baskets and auto flush in bytes (autoFlush<0)
+  // write the calibration skims in large blocks
+  //
+  fStreamBasketSize[stream]=basketSize;
+  fStreamCompression[stream]=compressionLevel;
+  fStreamAutoFlush[stream]=autoFlush;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::SetDownscaling(EOutputStream stream, AliFilteredTreeDownscaling *policy)
+{
+  //
+  // Set the down-sampling policy of an output stream, the task takes the ownership.
+  // Without a policy the stream keeps the default downscaling (fLowPtTrackDownscaligF,
+  // fLowPtV0DownscaligF) based on gRandom
+  //
+  if (fDownscaling[stream]!=policy) delete fDownscaling[stream];
+  fDownscaling[stream]=policy;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisTaskFilteredTree::IsTrackDownscaled(EOutputStream stream, Double_t pt, Int_t index)
+{
+  //
+  // Downscale low pt tracks (particles) of stream, index is the key of the track in the event
+  //
+  if (fDownscaling[stream]) return !fDownscaling[stream]->Accept(pt, index);
+  Double_t scalempt= TMath::Min(pt,10.);
+  Double_t downscaleF = gRandom->Rndm();
+  downscaleF *= fLowPtTrackDownscaligF;
+  return TMath::Exp(2*scalempt)<downscaleF;
+}
+
+//_____________________________________________________________________________
+TTreeStream& AliAnalysisTaskFilteredTree::Stream(EOutputStream stream)
+{
+  //
+  // Output stream, looked up by name in the redirector only on first use
+  //
+  if (!fStreams[stream]) {
+    fStreams[stream]=&((*fTreeSRedirector)<<kOutputStreamNames[stream]);
+    TTree *tree=fStreams[stream]->GetTree();
+    if (tree && fStreamAutoFlush[stream]!=0) tree->SetAutoFlush(fStreamAutoFlush[stream]);
+  }
+  return *fStreams[stream];
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::TuneStreams()
+{
+  //
+  // Apply the basket size and compression settings to the branches of the
+  // output trees. The branches are created by the first entry of each stream
+  //
+  for (Int_t i=0; i<kNOutputStreams; i++) {
+    if (!fStreams[i] || fStreamTuned[i]) continue;
+    TTree *tree=fStreams[i]->GetTree();
+    if (!tree || tree->GetNbranches()==0) continue;
+    if (fStreamBasketSize[i]>0) tree->SetBasketSize("*",fStreamBasketSize[i]);
+    if (fStreamCompression[i]>=0) {
+      TIter next(tree->GetListOfBranches());
+      TBranch *br=0;
+      while ((br=(TBranch*)next())) br->SetCompressionLevel(fStreamCompression[i]);
+    }
+    fStreamTuned[i]=kTRUE;
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisTaskFilteredTree::IsFriendSizeExceeded(EOutputStream stream, const char *friendName)
+{
+  //
+  // Check if the friend track branches (friendName.fPoints and friendName.fCalibContainer)
+  // take more than 1/|fFriendDownscaling| of the compressed size of the stream tree.
+  // The branches exist only after the first entry, they are looked up until found
+  //
+  TTree *tree=Stream(stream).GetTree();
+  if (!tree) return kFALSE;
+  TBranch **br=fFriendBranches[stream];
+  if (!br[0]) br[0]=tree->GetBranch(Form("%s.fPoints",friendName));
+  if (!br[1]) br[1]=tree->GetBranch(Form("%s.fCalibContainer",friendName));
+  Double_t sizeAll=tree->GetZipBytes();
+  Double_t sizeFriend=0;
+  if (br[0]) sizeFriend+=br[0]->GetZipBytes();
+  if (br[1]) sizeFriend+=br[1]->GetZipBytes();
+  return sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll;
 }
 
 //_____________________________________________________________________________
@@ -2838,7 +2951,7 @@ void AliAnalysisTaskFilteredTree::ProcessITSTPCmatchOut(AliESDEvent *const esdEv
     AliESDtrack * trackAll= (indexAll>=0)? esdEvent->GetTrack(indexAll):&esdTrackDummy;
     AliESDtrack * trackTPC= (indexTPC>=0)? esdEvent->GetTrack(indexTPC):&esdTrackDummy;
     AliESDtrack * trackTPCITS= (indexTPCITS>=0)? esdEvent->GetTrack(indexTPCITS):&esdTrackDummy;
-    (*fTreeSRedirector)<<"itsTPC"<<
+    Stream(kITSTPCStream)<<
       "indexAll="<<indexAll<<          // index of closest track (chi2)
       "indexTPC="<<indexTPC<<          // index of closest TPCalone tracks
       "indexTPCITS="<<indexTPCITS<<    // index of closest cobined tracks
@@ -13,6 +13,7 @@ class AliESDEvent;
 class AliMCEvent;
 class AliFilteredTreeEventCuts;
 class AliFilteredTreeAcceptanceCuts;
+class AliFilteredTreeDownscaling;
 class AliESDtrackCuts;
 class AliMagFMaps;
 class AliESDEvent; 
@@ -28,6 +29,8 @@ class TList;
 class TObjArray;
 class TTree;
 class TTreeSRedirector;
+class TTreeStream;
+class TBranch;
 class TParticle;
 class TH3D;
 #include <string>
@@ -42,6 +45,18 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
                       kTPCITSAnalysisMode=0,
                       kTPCAnalysisMode=1 };
 
+  // output streams (trees) of the task
+  enum EOutputStream { kV0sStream=0,
+                       kHighPtStream,
+                       kdEdxStream,
+                       kLaserStream,
+                       kMCEffStream,
+                       kCosmicPairsStream,
+                       kEventInfoTracksStream,
+                       kEventInfoV0Stream,
+                       kITSTPCStream,
+                       kNOutputStreams };
+
   AliAnalysisTaskFilteredTree(const char *name = "AliAnalysisTaskFilteredTree");
   virtual ~AliAnalysisTaskFilteredTree();
   
@@ -95,12 +110,15 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   // v0s selection
   Int_t  GetKFParticle(AliESDv0 *const v0, AliESDEvent * const event, AliKFParticle & kfparticle);
-  Bool_t IsV0Downscaled(AliESDv0 *const v0);
+  Bool_t IsV0Downscaled(AliESDv0 *const v0, Int_t v0Index=-1);
   Bool_t IsHighDeDxParticle(AliESDtrack * const track);
 
   void SetLowPtTrackDownscaligF(Double_t fact) { fLowPtTrackDownscaligF = fact; }
   void SetLowPtV0DownscaligF(Double_t fact)    { fLowPtV0DownscaligF = fact; }
   void SetFriendDownscaling(Double_t fact)    { fFriendDownscaling = fact; }
+  // down-sampling policy of an output stream (owned), replaces the default downscaling of the stream
+  void SetDownscaling(EOutputStream stream, AliFilteredTreeDownscaling *policy);
+  AliFilteredTreeDownscaling* GetDownscaling(EOutputStream stream) const { return fDownscaling[stream]; }
   
   void   SetProcessCosmics(Bool_t flag) { fProcessCosmics = flag; }
   Bool_t GetProcessCosmics() { return fProcessCosmics; }
@@ -113,6 +131,9 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   static Int_t GetMCTrueTrackMult(AliMCEvent *const mcEvent, AliFilteredTreeEventCuts *const evtCuts, AliFilteredTreeAcceptanceCuts *const accCuts);
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
+  // per stream tuning of the output tree: basket size [bytes], compression level and
+  // auto flush (<0: bytes, >0: entries), values <=0 (-1 for the compression) keep the defaults
+  void SetStreamTuning(EOutputStream stream, Int_t basketSize, Int_t compressionLevel=-1, Long64_t autoFlush=0);
   Bool_t GetFillTrees() { return fFillTree ;}
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
@@ -173,11 +194,25 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCc;   //! sigma(pt)/pt vs Cent vs Pt for prim. TPC contrained to vertex tracks
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
+  UInt_t   fCurrentChunkHash; //! hash of the run and chunk directories, MC key of the deterministic down-sampling
   AliESDtrack* fDummyTrack; //! dummy track for tree init
 
+  Int_t    fStreamBasketSize[kNOutputStreams];  // basket size per stream (0: default)
+  Int_t    fStreamCompression[kNOutputStreams]; // compression level per stream (-1: default)
+  Long64_t fStreamAutoFlush[kNOutputStreams];   // auto flush per stream (0: default)
+  TTreeStream* fStreams[kNOutputStreams];       //! output streams, bound on first use
+  Bool_t   fStreamTuned[kNOutputStreams];       //! basket and compression settings applied
+  TBranch* fFriendBranches[kNOutputStreams][2]; //! friend track branches used for the friend downscaling
+  AliFilteredTreeDownscaling* fDownscaling[kNOutputStreams]; // down-sampling policies per stream (0: default downscaling)
+
+  TTreeStream& Stream(EOutputStream stream);
+  void TuneStreams();
+  Bool_t IsFriendSizeExceeded(EOutputStream stream, const char *friendName);
+  Bool_t IsTrackDownscaled(EOutputStream stream, Double_t pt, Int_t index);
+
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 3); // example of analysis
 };
 
 #endif
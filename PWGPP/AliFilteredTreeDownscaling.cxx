@@ -0,0 +1,179 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <TF1.h>
+#include <TMath.h>
+#include <TRandom.h>
+
+#include "AliFilteredTreeDownscaling.h"
+
+ClassImp(AliFilteredTreeDownscaling)
+
+//_____________________________________________________________________________
+AliFilteredTreeDownscaling::AliFilteredTreeDownscaling(const Char_t* name,const Char_t *title) :
+TNamed(name, title)
+, fSampling(kHash)
+, fSalt(0)
+, fFactor(0)
+, fSlope(2.)
+, fXMax(10.)
+, fKeepFunction(0)
+, fMaxPerEvent(0)
+, fRun(0)
+, fEventId(0)
+, fChunkEventId(0)
+, fNAcceptedEvent(0)
+, fNTried(0)
+, fNAccepted(0)
+, fNOverBudget(0)
+{
+  // default constructor
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeDownscaling::AliFilteredTreeDownscaling(const AliFilteredTreeDownscaling &other) :
+TNamed(other)
+, fSampling(other.fSampling)
+, fSalt(other.fSalt)
+, fFactor(other.fFactor)
+, fSlope(other.fSlope)
+, fXMax(other.fXMax)
+, fKeepFunction(other.fKeepFunction ? (TF1*)other.fKeepFunction->Clone() : 0)
+, fMaxPerEvent(other.fMaxPerEvent)
+, fRun(0)
+, fEventId(0)
+, fChunkEventId(0)
+, fNAcceptedEvent(0)
+, fNTried(0)
+, fNAccepted(0)
+, fNOverBudget(0)
+{
+  // copy constructor, the counters are not copied
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeDownscaling& AliFilteredTreeDownscaling::operator=(const AliFilteredTreeDownscaling &other)
+{
+  // assignment operator, the counters are not copied
+  if (this == &other) return *this;
+  TNamed::operator=(other);
+  fSampling=other.fSampling;
+  fSalt=other.fSalt;
+  fFactor=other.fFactor;
+  fSlope=other.fSlope;
+  fXMax=other.fXMax;
+  SetKeepFunction(other.fKeepFunction);
+  fMaxPerEvent=other.fMaxPerEvent;
+  return *this;
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeDownscaling::~AliFilteredTreeDownscaling()
+{
+  // destructor
+  delete fKeepFunction;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeDownscaling::SetKeepFunction(const TF1 *f)
+{
+  // keep probability as a function of the flattening variable (a copy is kept),
+  // 0 restores the exponential flattening
+  delete fKeepFunction;
+  fKeepFunction = f ? (TF1*)f->Clone() : 0;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeDownscaling::NewEvent(Int_t run, ULong64_t eventId, ULong64_t chunkEventId)
+{
+  // set the keys of the current event and reset the per event budget
+  fRun=run;
+  fEventId=eventId;
+  fChunkEventId=chunkEventId;
+  fNAcceptedEvent=0;
+}
+
+//_____________________________________________________________________________
+Double_t AliFilteredTreeDownscaling::HashUniform(Int_t run, ULong64_t eventId, ULong64_t chunkEventId, Int_t entryId, UInt_t salt)
+{
+  //
+  // uniform number in [0,1) from the run, event, chunk event and entry keys
+  // (splitmix64 finalizer applied to each key in turn)
+  //
+  ULong64_t h = (ULong64_t(salt)<<32) | UInt_t(run);
+  ULong64_t keys[3] = { eventId, chunkEventId, ULong64_t(UInt_t(entryId)) };
+  for (Int_t i=0; i<4; i++) {
+    ULong64_t z = h + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    h = z ^ (z >> 31);
+    if (i<3) h ^= keys[i];
+  }
+  return (h >> 11) * (1.0/9007199254740992.0);
+}
+
+//_____________________________________________________________________________
+Double_t AliFilteredTreeDownscaling::GetUniform(Int_t entryId) const
+{
+  // uniform number used for the entry entryId of the current event
+  if (fSampling==kHash) return HashUniform(fRun, fEventId, fChunkEventId, entryId, fSalt);
+  return gRandom->Rndm();
+}
+
+//_____________________________________________________________________________
+Double_t AliFilteredTreeDownscaling::GetKeepProbability(Double_t x, Double_t factorScale) const
+{
+  // probability to keep an entry with flattening variable x,
+  // factorScale multiplies the downscaling factor
+  Double_t xs = TMath::Min(x, fXMax);
+  Double_t p = 1.;
+  if (fKeepFunction) p = fKeepFunction->Eval(xs)/factorScale;
+  else if (fFactor*factorScale>0) p = TMath::Exp(fSlope*xs)/(fFactor*factorScale);
+  return TMath::Max(0., TMath::Min(1., p));
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeDownscaling::Accept(Double_t x, Int_t entryId, Double_t factorScale)
+{
+  //
+  // decide if the entry entryId of the current event with flattening
+  // variable x is kept, factorScale multiplies the downscaling factor
+  //
+  fNTried++;
+  Double_t u = GetUniform(entryId);
+  Double_t xs = TMath::Min(x, fXMax);
+  Bool_t keep;
+  if (fKeepFunction) keep = u*factorScale <= fKeepFunction->Eval(xs);
+  else keep = !(TMath::Exp(fSlope*xs) < u*fFactor*factorScale);   // same comparison as the task default
+  if (!keep) return kFALSE;
+  if (fMaxPerEvent>0 && fNAcceptedEvent>=fMaxPerEvent) {
+    fNOverBudget++;
+    return kFALSE;
+  }
+  fNAcceptedEvent++;
+  fNAccepted++;
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeDownscaling::Print(Option_t *) const
+{
+  // print the settings and the counters
+  Printf("%s: %s sampling (salt %u), %s, max per event %d",
+         GetName(), fSampling==kHash ? "hash" : "random", fSalt,
+         fKeepFunction ? Form("keep function %s",fKeepFunction->GetName()) : Form("factor %g slope %g xMax %g",fFactor,fSlope,fXMax),
+         fMaxPerEvent);
+  Printf("  tried %lld, kept %lld, over budget %lld", fNTried, fNAccepted, fNOverBudget);
+}
@@ -0,0 +1,87 @@
+#ifndef ALIFILTEREDTREEDOWNSCALING_H
+#define ALIFILTEREDTREEDOWNSCALING_H
+
+//------------------------------------------------------------------------------
+// Down-sampling policy for an output stream of AliAnalysisTaskFilteredTree.
+//
+// An entry with flattening variable x (typically pT) is kept with probability
+//   P(x) = exp(slope*min(x,xMax)) / factor
+// or P(x) = f(min(x,xMax)) if a keep function f is set. Exponentially falling
+// spectra in x become flat up to xMax.
+// With kHash sampling the uniform number compared to P(x) is a hash of
+// (run, event id, chunk event id, entry id, salt) instead of gRandom, so
+// that reprocessing the same input keeps exactly the same entries. In MC,
+// where the event id from the trigger is constant, the chunk event id (hash
+// of the run and chunk directories and event number in the chunk) keeps the
+// key unique; in data it is 0.
+// An optional budget limits the number of entries kept per event. The
+// entries are tested in the order of the stream loop, so the budget keeps
+// the accepted entries with the lowest indices first (biased towards low
+// indices, not a random subset).
+//------------------------------------------------------------------------------
+
+#include "TNamed.h"
+
+class TF1;
+
+class AliFilteredTreeDownscaling : public TNamed
+{
+public:
+  enum ESampling { kRandom=0,   // gRandom, as the default downscaling of the task
+                   kHash=1 };   // deterministic hash of run, event and entry
+
+  AliFilteredTreeDownscaling(const Char_t* name ="AliFilteredTreeDownscaling", const Char_t *title ="");
+  AliFilteredTreeDownscaling(const AliFilteredTreeDownscaling &other);
+  AliFilteredTreeDownscaling& operator=(const AliFilteredTreeDownscaling &other);
+  virtual ~AliFilteredTreeDownscaling();
+
+  // setters
+  void SetSampling(ESampling sampling) { fSampling=sampling; }
+  void SetSalt(UInt_t salt)            { fSalt=salt; }
+  void SetFlattening(Double_t factor, Double_t slope=2., Double_t xMax=10.) { fFactor=factor; fSlope=slope; fXMax=xMax; }
+  void SetKeepFunction(const TF1 *f);
+  void SetMaxPerEvent(Int_t max)       { fMaxPerEvent=max; } // keeps the first (lowest index) accepted entries
+
+  // getters
+  ESampling GetSampling() const     { return fSampling; }
+  UInt_t    GetSalt() const         { return fSalt; }
+  Double_t  GetFactor() const       { return fFactor; }
+  Double_t  GetSlope() const        { return fSlope; }
+  Double_t  GetXMax() const         { return fXMax; }
+  const TF1* GetKeepFunction() const { return fKeepFunction; }
+  Int_t     GetMaxPerEvent() const  { return fMaxPerEvent; }
+
+  Long64_t GetNTried() const        { return fNTried; }
+  Long64_t GetNAccepted() const     { return fNAccepted; }
+  Long64_t GetNOverBudget() const   { return fNOverBudget; }
+
+  // sampling
+  void     NewEvent(Int_t run, ULong64_t eventId, ULong64_t chunkEventId=0);
+  Double_t GetKeepProbability(Double_t x, Double_t factorScale=1.) const;
+  Bool_t   Accept(Double_t x, Int_t entryId, Double_t factorScale=1.);
+  Double_t GetUniform(Int_t entryId) const;
+  static Double_t HashUniform(Int_t run, ULong64_t eventId, ULong64_t chunkEventId, Int_t entryId, UInt_t salt);
+
+  virtual void Print(Option_t *option="") const;
+
+private:
+  ESampling fSampling;    // source of the uniform numbers
+  UInt_t    fSalt;        // salt of the hash, to decorrelate streams sampling the same entries
+  Double_t  fFactor;      // downscaling factor (<=0: no downscaling)
+  Double_t  fSlope;       // slope of the exponential flattening
+  Double_t  fXMax;        // flattening variable saturates at xMax
+  TF1      *fKeepFunction;// keep probability as a function of x, replaces the exponential (owned)
+  Int_t     fMaxPerEvent; // max number of entries kept per event (<=0: no limit)
+
+  Int_t     fRun;              //! run of the current event
+  ULong64_t fEventId;          //! id of the current event
+  ULong64_t fChunkEventId;     //! chunk and event number in chunk of the current event
+  Int_t     fNAcceptedEvent;   //! entries kept in the current event
+  Long64_t  fNTried;           //! entries tested
+  Long64_t  fNAccepted;        //! entries kept
+  Long64_t  fNOverBudget;      //! entries rejected by the per event budget
+
+  ClassDef(AliFilteredTreeDownscaling, 1);
+};
+
+#endif
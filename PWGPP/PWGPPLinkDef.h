@@ -90,6 +90,7 @@
 #pragma link C++ class AliAnalysisTaskFilteredTree+;
 #pragma link C++ class AliFilteredTreeEventCuts+;
 #pragma link C++ class AliFilteredTreeAcceptanceCuts+;
+#pragma link C++ class AliFilteredTreeDownscaling+;
 
 #pragma link C++ class AliTaskConfigOCDB+;
 
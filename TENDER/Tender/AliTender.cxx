@@ -17,6 +17,15 @@
 
 #include <TChain.h>
 #include <TFile.h>
+#include <TROOT.h>
+#include <RVersion.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
  
 #include "AliTender.h"
 #include "AliTenderSupply.h"
@@ -29,6 +38,103 @@
 
 ClassImp(AliTender)
 
+//==============================================================================
+//   AliTenderScheduler - Pool of threads running the units of work of one
+//      event (single supplies or fused track loops) along their dependency
+//      graph: a unit starts as soon as all the units it depends on are done.
+//==============================================================================
+class AliTenderScheduler {
+public:
+  AliTenderScheduler(Int_t nthreads);
+  ~AliTenderScheduler();
+  void Run(const std::vector<std::vector<Int_t> > &dependents, const std::vector<Int_t> &ndeps,
+           const std::function<void(Int_t)> &exec);
+
+private:
+  AliTenderScheduler(const AliTenderScheduler &other);
+  AliTenderScheduler& operator=(const AliTenderScheduler &other);
+  void Work();
+
+  std::vector<std::thread>              fThreads;    // Worker threads
+  std::mutex                            fMutex;      // Protects all below
+  std::condition_variable               fWake;       // Signals ready units or stop to the workers
+  std::condition_variable               fDone;       // Signals the end of the event
+  std::deque<Int_t>                     fReady;      // Units ready to run
+  const std::vector<std::vector<Int_t> > *fDependents; // Units depending on each unit
+  std::vector<Int_t>                    fNDeps;      // Number of unfinished dependencies per unit
+  const std::function<void(Int_t)>     *fExec;       // Runs one unit
+  Int_t                                 fNLeft;      // Units not finished yet
+  Bool_t                                fStop;       // Terminate the workers
+};
+
+//______________________________________________________________________________
+AliTenderScheduler::AliTenderScheduler(Int_t nthreads)
+                   :fThreads(),
+                    fMutex(),
+                    fWake(),
+                    fDone(),
+                    fReady(),
+                    fDependents(NULL),
+                    fNDeps(),
+                    fExec(NULL),
+                    fNLeft(0),
+                    fStop(kFALSE)
+{
+// Start the worker threads
+  for (Int_t i=0; i<nthreads; i++) fThreads.push_back(std::thread(&AliTenderScheduler::Work, this));
+}
+
+//______________________________________________________________________________
+AliTenderScheduler::~AliTenderScheduler()
+{
+// Stop and join the worker threads
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = kTRUE;
+  }
+  fWake.notify_all();
+  for (UInt_t i=0; i<fThreads.size(); i++) fThreads[i].join();
+}
+
+//______________________________________________________________________________
+void AliTenderScheduler::Run(const std::vector<std::vector<Int_t> > &dependents, const std::vector<Int_t> &ndeps,
+                             const std::function<void(Int_t)> &exec)
+{
+// Run all the units and return when they are done
+  std::unique_lock<std::mutex> lock(fMutex);
+  fDependents = &dependents;
+  fNDeps = ndeps;
+  fExec = &exec;
+  fNLeft = ndeps.size();
+  for (UInt_t u=0; u<ndeps.size(); u++) if (!ndeps[u]) fReady.push_back(u);
+  fWake.notify_all();
+  fDone.wait(lock, [this]() {return fNLeft == 0;});
+}
+
+//______________________________________________________________________________
+void AliTenderScheduler::Work()
+{
+// Loop of the worker threads
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (kTRUE) {
+    fWake.wait(lock, [this]() {return fStop || !fReady.empty();});
+    if (fStop) return;
+    Int_t u = fReady.front();
+    fReady.pop_front();
+    lock.unlock();
+    (*fExec)(u);
+    lock.lock();
+    const std::vector<Int_t> &dependents = (*fDependents)[u];
+    for (UInt_t i=0; i<dependents.size(); i++) {
+      if (--fNDeps[dependents[i]] == 0) {
+        fReady.push_back(dependents[i]);
+        fWake.notify_one();
+      }
+    }
+    if (--fNLeft == 0) fDone.notify_all();
+  }
+}
+
 //______________________________________________________________________________
 AliTender::AliTender():
            AliAnalysisTaskSE(),
@@ -41,7 +147,9 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fNThreads(1),
+           fScheduler(NULL)
 {
 // Dummy constructor
 }
@@ -58,7 +166,9 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fNThreads(1),
+           fScheduler(NULL)
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -68,6 +178,7 @@ AliTender::AliTender(const char* name):
 AliTender::~AliTender()
 {
 // Destructor
+  delete fScheduler;
   if (fSupplies) {
     fSupplies->Delete();
     delete fSupplies;
@@ -170,9 +281,67 @@ void AliTender::UserExec(Option_t* option)
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  // The supplies are split in units of work. Supplies having a track kernel are run
+  // in groups, with a single loop over the tracks per group. A group ends at the next
+  // supply without kernel, or at the next supply needing the tracks already processed
+  // for its per-event setup. Any other supply is a unit by itself.
+  Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+  std::vector<Int_t> unitFirst, unitLast;
+  Int_t first = 0;
+  for (Int_t i=0; i<nsupplies; i++) {
+    AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(i);
+    if (supply->HasTrackKernel() && !(i>first && supply->BeginEventUsesTracks())) continue;
+    if (i>first) {
+      unitFirst.push_back(first);
+      unitLast.push_back(i);
+    }
+    if (supply->HasTrackKernel()) {
+      first = i;
+    } else {
+      unitFirst.push_back(i);
+      unitLast.push_back(i+1);
+      first = i+1;
+    }
+  }
+  if (nsupplies>first) {
+    unitFirst.push_back(first);
+    unitLast.push_back(nsupplies);
+  }
+  Int_t nunits = unitFirst.size();
+
+  // Run change events (OCDB/OADB access, supply initialisation) are always serial
+  if (fNThreads < 2 || fRunChanged || nunits < 2) {
+    for (Int_t u=0; u<nunits; u++) ProcessUnit(unitFirst[u], unitLast[u]);
+  } else {
+    // Unit j depends on an earlier unit i if one of them writes a product the other
+    // reads or writes. Units without such conflicts run concurrently.
+    std::vector<UInt_t> reads(nunits, 0), writes(nunits, 0);
+    for (Int_t u=0; u<nunits; u++) {
+      for (Int_t i=unitFirst[u]; i<unitLast[u]; i++) {
+        AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(i);
+        reads[u]  |= supply->GetReadProducts();
+        writes[u] |= supply->GetWriteProducts();
+      }
+    }
+    std::vector<std::vector<Int_t> > dependents(nunits);
+    std::vector<Int_t> ndeps(nunits, 0);
+    for (Int_t j=1; j<nunits; j++) {
+      for (Int_t i=0; i<j; i++) {
+        if ((writes[i] & (reads[j] | writes[j])) || (reads[i] & writes[j])) {
+          dependents[i].push_back(j);
+          ndeps[j]++;
+        }
+      }
+    }
+    if (!fScheduler) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+      ROOT::EnableThreadSafety();
+#endif
+      fScheduler = new AliTenderScheduler(fNThreads);
+    }
+    std::function<void(Int_t)> exec = [this, &unitFirst, &unitLast](Int_t u) {ProcessUnit(unitFirst[u], unitLast[u]);};
+    fScheduler->Run(dependents, ndeps, exec);
+  }
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
@@ -181,6 +350,38 @@ void AliTender::UserExec(Option_t* option)
   if (!opt.Contains("NoPost")) PostData(1, fESD);
 }
 
+//______________________________________________________________________________
+void AliTender::ProcessUnit(Int_t first, Int_t last)
+{
+// Run one unit of work: either a single supply without track kernel, or the
+// track kernels of the supplies [first, last).
+  AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(first);
+  if (!supply->HasTrackKernel()) supply->ProcessEvent();
+  else ProcessTrackKernels(first, last);
+}
+
+//______________________________________________________________________________
+void AliTender::ProcessTrackKernels(Int_t first, Int_t last)
+{
+// Run the track kernels of the supplies [first, last) in a single loop over the
+// tracks, in the order the supplies were added.
+  if (first >= last) return;
+  std::vector<AliTenderSupply*> kernels;
+  kernels.reserve(last-first);
+  for (Int_t i=first; i<last; i++) {
+    AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(i);
+    if (supply->BeginEvent()) kernels.push_back(supply);
+  }
+  Int_t nkernels = kernels.size();
+  if (!nkernels) return;
+  Int_t ntracks = fESD->GetNumberOfTracks();
+  for (Int_t itrack=0; itrack<ntracks; itrack++) {
+    AliESDtrack *track = fESD->GetTrack(itrack);
+    for (Int_t k=0; k<nkernels; k++) kernels[k]->ProcessTrack(track);
+  }
+  for (Int_t k=0; k<nkernels; k++) kernels[k]->EndEvent();
+}
+
 //______________________________________________________________________________
 void AliTender::SetDefaultCDBStorage(const char *dbString)
 {
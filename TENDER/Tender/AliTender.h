@@ -24,6 +24,7 @@ class AliCDBManager;
 class AliESDEvent;
 class AliESDInputHandler;
 class AliTenderSupply;
+class AliTenderScheduler;
 
 class AliTender : public AliAnalysisTaskSE {
 
@@ -43,9 +44,13 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  Int_t                     fNThreads;       // Number of threads running the supplies
+  AliTenderScheduler       *fScheduler;      //! Thread pool running the supplies
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
+  void                      ProcessTrackKernels(Int_t first, Int_t last);
+  void                      ProcessUnit(Int_t first, Int_t last);
 
 public:  
   AliTender();
@@ -68,6 +73,13 @@ public:
    */
   void 			    SetHandleOCDB(Bool_t doHandle) { fHandleCDB = doHandle; }
   void SetESDhandler(AliESDInputHandler*esdH) {fESDhandler = esdH;}
+  /**
+   * Run the supplies not conflicting on the event products they read and
+   * write concurrently, with n threads (default: 1, serial)
+   * @param[in] n Number of threads
+   */
+  void                      SetNThreads(Int_t n) { fNThreads = n; }
+  Int_t                     GetNThreads() const { return fNThreads; }
 
   // Run control
   virtual void              ConnectInputData(Option_t *option = "");
@@ -75,6 +87,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
 };
 #endif
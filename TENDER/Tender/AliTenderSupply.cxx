@@ -17,6 +17,7 @@
  
 #include "AliTender.h"
 #include "AliTenderSupply.h"
+#include "AliESDEvent.h"
 
 ClassImp(AliTenderSupply)
 
@@ -60,3 +61,16 @@ AliTenderSupply& AliTenderSupply::operator=(const AliTenderSupply &other)
    fTender = other.fTender;
    return *this;
 }
+
+//______________________________________________________________________________
+void AliTenderSupply::ProcessTracks()
+{
+// Run the per-event hooks and the track kernel of this supply alone, on all the
+// tracks of the current event. Supplies having a track kernel can implement
+// ProcessEvent() with this.
+   if (!BeginEvent()) return;
+   AliESDEvent *event = fTender->GetEvent();
+   Int_t ntracks = event->GetNumberOfTracks();
+   for (Int_t itrack=0; itrack<ntracks; itrack++) ProcessTrack(event->GetTrack(itrack));
+   EndEvent();
+}
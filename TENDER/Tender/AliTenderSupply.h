@@ -8,6 +8,18 @@
 
 //==============================================================================
 //   AliTenderSupply - Base class for user-defined ESD additions and corrections.
+//      Supplies that only need a per-track correction can opt in to the fused
+//      track loop of AliTender by returning true from HasTrackKernel() and
+//      implementing BeginEvent(), ProcessTrack() and EndEvent(). AliTender then
+//      runs the kernels of consecutive such supplies in a single loop over the
+//      tracks, instead of calling ProcessEvent(). BeginEvent() does the
+//      per-event setup and may return false to skip the kernel for the event;
+//      if it reads the tracks, BeginEventUsesTracks() must return true so that
+//      the preceding supplies are done with them first.
+//      Supplies declaring the event products they read and write (see
+//      ETenderProduct) can be run concurrently by AliTender with the supplies
+//      they do not conflict with. By default a supply reads and writes
+//      everything, so it always runs alone.
 //==============================================================================
 
 #ifndef ROOT_TNamed
@@ -15,9 +27,29 @@
 #endif
 
 class AliTender;
+class AliESDtrack;
 
 class AliTenderSupply : public TNamed {
 
+public:
+enum ETenderProduct {
+   kVertex       = BIT(0),  // Primary vertices
+   kTrackParams  = BIT(1),  // Track parameters
+   kTrackStatus  = BIT(2),  // Track status bits and calorimeter matching
+   kTPCsignal    = BIT(3),  // TPC dE/dx
+   kTRDsignal    = BIT(4),  // TRD signal
+   kTOFsignal    = BIT(5),  // TOF signal and expected times
+   kHMPIDsignal  = BIT(6),  // HMPID signal
+   kPID          = BIT(7),  // PID probabilities, PID response objects
+   kT0           = BIT(8),  // T0 and TOF start times
+   kVZERO        = BIT(9),  // VZERO data
+   kEMCALCells   = BIT(10), // EMCAL cells
+   kPHOSCells    = BIT(11), // PHOS cells
+   kCaloClusters = BIT(12), // Calorimeter clusters (EMCAL and PHOS)
+   kRandom       = BIT(13), // gRandom
+   kAllProducts  = 0xffffffff
+};
+
 protected:
   const AliTender          *fTender;         // Tender car
   
@@ -31,6 +63,16 @@ public:
   // Run control
   virtual void              Init() = 0;
   virtual void              ProcessEvent() = 0;
+  // Fused track loop
+  virtual Bool_t            HasTrackKernel() const {return kFALSE;}
+  virtual Bool_t            BeginEventUsesTracks() const {return kFALSE;}
+  virtual Bool_t            BeginEvent() {return kTRUE;}
+  virtual void              ProcessTrack(AliESDtrack * /*track*/) {}
+  virtual void              EndEvent() {}
+  void                      ProcessTracks();
+  // Event products read and written in ProcessEvent()/the track kernel
+  virtual UInt_t            GetReadProducts() const {return kAllProducts;}
+  virtual UInt_t            GetWriteProducts() const {return kAllProducts;}
   
   void                      SetTender(const AliTender *tender) {fTender = tender;}
     
@@ -489,6 +489,28 @@ AliMCEvent* AliEMCALTenderSupply::GetMCEvent()
   return 0;
 }
 
+//_____________________________________________________
+UInt_t AliEMCALTenderSupply::GetReadProducts() const
+{
+  // Event products read by ProcessEvent.
+
+  UInt_t prod = kEMCALCells | kCaloClusters | kVertex;
+  if (fDoTrackMatch)
+    prod |= kTrackParams | kTrackStatus;
+  return prod;
+}
+
+//_____________________________________________________
+UInt_t AliEMCALTenderSupply::GetWriteProducts() const
+{
+  // Event products modified by ProcessEvent (the matching sets the track EMCAL status).
+
+  UInt_t prod = kEMCALCells | kCaloClusters;
+  if (fDoTrackMatch)
+    prod |= kTrackStatus;
+  return prod;
+}
+
 //_____________________________________________________
 void AliEMCALTenderSupply::ProcessEvent()
 {
@@ -52,6 +52,9 @@ public:
 
   virtual void Init();
   virtual void ProcessEvent();
+  // Event products, the tracks only take part with the track matching
+  virtual UInt_t GetReadProducts() const;
+  virtual UInt_t GetWriteProducts() const;
 
   void     SetTask(AliAnalysisTaskSE *task)               { fTask = task                     ;}
   void     SetDefaults();
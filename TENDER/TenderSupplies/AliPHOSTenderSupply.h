@@ -32,6 +32,9 @@ public:
 
   virtual void   Init(){}
   virtual void   ProcessEvent();
+  // Event products (the tracks are read for the track matching, gRandom in MC)
+  virtual UInt_t GetReadProducts() const {return kPHOSCells|kCaloClusters|kVertex|kTrackParams|kTrackStatus|kRandom;}
+  virtual UInt_t GetWriteProducts() const {return kPHOSCells|kCaloClusters|kRandom;}
   
   void SetTask(AliAnalysisTaskSE * task){fTask=task;} //if work with AOD and special task
   
@@ -24,10 +24,19 @@ public:
   
   virtual void              Init(){;}
   virtual void              ProcessEvent();
+  // Fused track loop, caching the PID needs all the tracks
+  virtual Bool_t            HasTrackKernel() const {return kTRUE;}
+  virtual Bool_t            BeginEventUsesTracks() const {return fCachePID;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+  // Event products
+  virtual UInt_t            GetReadProducts() const {return kTrackParams|kTrackStatus|kTPCsignal|kTRDsignal|kTOFsignal|kHMPIDsignal|kT0|kPID;}
+  virtual UInt_t            GetWriteProducts() const {return kTrackStatus|kPID;}
 
   void SetCachePID(Bool_t cachePID) { fCachePID=cachePID; }
 private:
   Bool_t fCachePID;                    // Cache PID values in transient object
+  AliESDpid *fESDpid;                  //! PID object of the current event
   
   AliPIDTenderSupply(const AliPIDTenderSupply&c);
   AliPIDTenderSupply& operator= (const AliPIDTenderSupply&c);
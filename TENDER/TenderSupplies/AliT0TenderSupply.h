@@ -22,6 +22,9 @@ class AliT0TenderSupply: public AliTenderSupply {
 
   virtual void          Init();
   virtual void          ProcessEvent();
+  // Event products
+  virtual UInt_t        GetReadProducts() const {return kT0|kVertex;}
+  virtual UInt_t        GetWriteProducts() const {return kT0;}
   void SetCorrectMeanTime (Bool_t flag=kFALSE){fCorrectMeanTime=flag;};
   void SetAmplutudeCorrection (Bool_t flag=kFALSE){fCorrectStartTimeOnAmplSatur=flag;};
   void SetPass4LHC11aCorrection (Bool_t flag=kFALSE){fPass4LHC11aCorrection=flag;};
@@ -303,12 +303,21 @@ void AliTOFTenderSupply::ProcessEvent()
 {
   //
   // Use updated calibrations for TOF and T0, reapply PID information
+  //
+  ProcessTracks();
+}
+
+//_____________________________________________________
+Bool_t AliTOFTenderSupply::BeginEvent()
+{
+  //
+  // Use updated calibrations for TOF and T0, compute the event start time
   // For MC: timeZero sampling and additional smearing for T0
 
   if (fDebugLevel > 1) AliInfo("process event");
 
   AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
+  if (!event) return kFALSE;
   if (fDebugLevel > 1) AliInfo("event read");
 
 
@@ -317,7 +326,7 @@ void AliTOFTenderSupply::ProcessEvent()
 
     Init();
 
-    if (fTenderNoAction) return;            
+    if (fTenderNoAction) return kFALSE;            
     Int_t versionNumber = GetOCDBVersion(fTender->GetRun());
     fTOFCalib->SetRunParamsSpecificVersion(versionNumber);
     fTOFCalib->Init(fTender->GetRun());
@@ -346,7 +355,7 @@ void AliTOFTenderSupply::ProcessEvent()
     }
   }
 
-  if (fTenderNoAction) return;
+  if (fTenderNoAction) return kFALSE;
 
   fTOFCalib->CalibrateESD(event);   //recalculate TOF signal (no harm for MC, see settings inside init)
 
@@ -434,19 +443,17 @@ void AliTOFTenderSupply::ProcessEvent()
   //  set preferred startTime: this is now done via AliPIDResponseTask
   fESDpid->SetTOFResponse(event, (AliESDpid::EStartTimeType_t)fTOFPIDParams->GetStartTimeMethod());
 
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliTOFTenderSupply::ProcessTrack(AliESDtrack *track)
+{
+  //
   // recalculate PID probabilities
   // this is for safety, especially if the user doesn't attach a PID tender after TOF tender  
-  Int_t ntracks=event->GetNumberOfTracks();
-  //  AliESDtrack *track = NULL;
-  //  Float_t tzeroTrack = 0;
-  for(Int_t itrack = 0; itrack < ntracks; itrack++){
-    //    track = event->GetTrack(itrack);
-    //    tzeroTrack = fESDpid->GetTOFResponse().GetStartTime(track->P());
-    //    Printf("================> Track # %d mom: %f tzeroTrack %f",itrack,track->P(),tzeroTrack);
-    fESDpid->MakeTOFPID(event->GetTrack(itrack),0);   
-  }
-  
-  
+  //
+  fESDpid->MakeTOFPID(track,0);   
 }
 
 
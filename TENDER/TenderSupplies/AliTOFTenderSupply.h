@@ -29,6 +29,14 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+  // Fused track loop, the calibration and the start time need all the tracks
+  virtual Bool_t            HasTrackKernel() const {return kTRUE;}
+  virtual Bool_t            BeginEventUsesTracks() const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+  // Event products
+  virtual UInt_t            GetReadProducts() const {return kTrackParams|kTrackStatus|kTOFsignal|kTRDsignal|kT0|kVertex|kPID|kRandom;}
+  virtual UInt_t            GetWriteProducts() const {return kTOFsignal|kTRDsignal|kT0|kTrackStatus|kPID|kRandom;}
 
   // TOF tender methods
   void SetIsMC(Bool_t flag=kFALSE){fIsMC=flag;}
@@ -28,6 +28,7 @@
 #include <TString.h>
 #include <TPRegexp.h>
 #include <TGraphErrors.h>
+#include <TMath.h>
 
 #include <AliDCSSensor.h>
 #include <AliGRPObject.h>
@@ -51,6 +52,39 @@
 
 ClassImp(AliTPCTenderSupply)
 
+namespace {
+  // Uniform lookup tables, x0 is the position of the first node and dx the step
+
+  Double_t InterpolateLinear(const std::vector<Double_t> &tab, Double_t x0, Double_t dx, Double_t x)
+  {
+    const Int_t n=tab.size();
+    const Double_t u=(x-x0)/dx;
+    Int_t i=Int_t(u);
+    if (i<0) i=0;
+    if (i>n-2) i=n-2;
+    const Double_t t=u-i;
+    return tab[i]+t*(tab[i+1]-tab[i]);
+  }
+
+  Double_t InterpolateCubic(const std::vector<Double_t> &tab, Double_t x0, Double_t dx, Double_t x)
+  {
+    // 4-point Lagrange interpolation on the nodes i-1..i+2
+    const Int_t n=tab.size();
+    const Double_t u=(x-x0)/dx;
+    Int_t i=Int_t(u);
+    if (i<1) i=1;
+    if (i>n-3) i=n-3;
+    const Double_t t=u-i;
+    const Double_t *p=&tab[i-1];
+    return -t*(t-1)*(t-2)/6.*p[0] + (t+1)*(t-1)*(t-2)/2.*p[1]
+           -(t+1)*t*(t-2)/2.*p[2] + (t+1)*t*(t-1)/6.*p[3];
+  }
+
+  // multiplicity bin range, see GetTPCMultiplicityBin
+  const Double_t kMultTableMax  = 20.;
+  const Int_t    kMultTableSize = 401;
+}
+
 AliTPCTenderSupply::AliTPCTenderSupply() :
 AliTenderSupply(),
 fESDpid(0x0),
@@ -68,11 +102,22 @@ fMultiCorrSigma(0x0),
 fSpecificStorages(0x0),
 fDebugLevel(0),
 fMip(50),
+fUseTables(kFALSE),
+fTableTolerance(1.e-4),
 fGRP(0x0),
 fBeamType("PP"),
 fLHCperiod(),
 fMCperiod(),
-fRecoPass(0)
+fRecoPass(0),
+fCorrFactor(1.),
+fCorrAttachSlope(0.),
+fCorrGainMultiplicityPbPb(1.),
+fGainTable(),
+fAttachTable(),
+fMultTable(),
+fTableTimeStart(0),
+fTableTimeEnd(0),
+fTableTimeStep(0.)
 {
   //
   // default ctor
@@ -97,11 +142,22 @@ fMultiCorrSigma(0x0),
 fSpecificStorages(0x0),
 fDebugLevel(0),
 fMip(50),
+fUseTables(kFALSE),
+fTableTolerance(1.e-4),
 fGRP(0x0),
 fBeamType("PP"),
 fLHCperiod(),
 fMCperiod(),
-fRecoPass(0)
+fRecoPass(0),
+fCorrFactor(1.),
+fCorrAttachSlope(0.),
+fCorrGainMultiplicityPbPb(1.),
+fGainTable(),
+fAttachTable(),
+fMultTable(),
+fTableTimeStart(0),
+fTableTimeEnd(0),
+fTableTimeStep(0.)
 {
   //
   // named ctor
@@ -154,9 +210,18 @@ void AliTPCTenderSupply::ProcessEvent()
   //
   // Reapply pid information
   //
+  ProcessTracks();
+}
+
+//_____________________________________________________
+Bool_t AliTPCTenderSupply::BeginEvent()
+{
+  //
+  // Per event setup of the gain correction
+  //
   
   AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
+  if (!event) return kFALSE;
   
   //load gain correction if run has changed
   if (fTender->RunChanged()){
@@ -167,43 +232,55 @@ void AliTPCTenderSupply::ProcessEvent()
     if (fDebugLevel>0) AliInfo(Form("Run Changed (%d)",fTender->GetRun()));
     SetParametrisation();
     if (fGainCorrection) SetSplines();
+    SetLookupTables();
   }
   
   //
-  // get gain correction factor
+  // get gain correction factor, from the tables within their time range
   //
-  Double_t corrFactor = GetGainCorrection();
-  Double_t corrAttachSlope = 0;
-  Double_t corrGainMultiplicityPbPb=1;
-  if (fAttachmentCorrection && fGainAttachment) corrAttachSlope = fGainAttachment->Eval(event->GetTimeStamp());
-  if (fMultiCorrection&&fMultiCorrMean) corrGainMultiplicityPbPb = fMultiCorrMean->Eval(GetTPCMultiplicityBin());
-  
+  const UInt_t time=event->GetTimeStamp();
+  const Bool_t inTimeTables=time>=fTableTimeStart && time<=fTableTimeEnd;
+  const Double_t tableTime=Double_t(time-fTableTimeStart);
+  if (inTimeTables && !fGainTable.empty()) fCorrFactor = InterpolateLinear(fGainTable,0.,fTableTimeStep,tableTime);
+  else fCorrFactor = GetGainCorrection(time);
+  fCorrAttachSlope = 0;
+  fCorrGainMultiplicityPbPb=1;
+  if (fAttachmentCorrection && fGainAttachment) {
+    if (inTimeTables && !fAttachTable.empty()) fCorrAttachSlope = InterpolateLinear(fAttachTable,0.,fTableTimeStep,tableTime);
+    else fCorrAttachSlope = fGainAttachment->Eval(time);
+  }
+  if (fMultiCorrection&&fMultiCorrMean) {
+    if (!fMultTable.empty()) fCorrGainMultiplicityPbPb = InterpolateCubic(fMultTable,0.,kMultTableMax/(kMultTableSize-1),GetTPCMultiplicityBin());
+    else fCorrGainMultiplicityPbPb = fMultiCorrMean->Eval(GetTPCMultiplicityBin());
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliTPCTenderSupply::ProcessTrack(AliESDtrack *track)
+{
   //
   // - correct TPC signals
   // - recalculate PID probabilities for TPC
   // - correct TPC signal multiplicity dependence
+  //
+  const AliExternalTrackParam *inner=track->GetInnerParam();
+  
+  // skip tracks without TPC information
+  if (!inner) return;
 
-  Int_t ntracks=event->GetNumberOfTracks();
-  for(Int_t itrack = 0; itrack < ntracks; itrack++){
-    AliESDtrack *track=event->GetTrack(itrack);
-    const AliExternalTrackParam *inner=track->GetInnerParam();
-    
-    // skip tracks without TPC information
-    if (!inner) continue;
-
-    //calculate total gain correction factor given by
-    // o gain calibration factor
-    // o attachment correction
-    // o multiplicity correction in PbPb
-    Float_t meanDrift= 250. - 0.5*TMath::Abs(2*inner->GetZ() + (247-83)*inner->GetTgl());
-    Double_t corrGainTotal=corrFactor*(1 + corrAttachSlope*180.)/(1 + corrAttachSlope*meanDrift)/corrGainMultiplicityPbPb;
+  //calculate total gain correction factor given by
+  // o gain calibration factor
+  // o attachment correction
+  // o multiplicity correction in PbPb
+  Float_t meanDrift= 250. - 0.5*TMath::Abs(2*inner->GetZ() + (247-83)*inner->GetTgl());
+  Double_t corrGainTotal=fCorrFactor*(1 + fCorrAttachSlope*180.)/(1 + fCorrAttachSlope*meanDrift)/fCorrGainMultiplicityPbPb;
 
-    // apply gain correction
-    track->SetTPCsignal(track->GetTPCsignal()*corrGainTotal ,track->GetTPCsignalSigma(), track->GetTPCsignalN());
+  // apply gain correction
+  track->SetTPCsignal(track->GetTPCsignal()*corrGainTotal ,track->GetTPCsignalSigma(), track->GetTPCsignalN());
 
-    // recalculate pid probabilities
-    fESDpid->MakeTPCPID(track);
-  }
+  // recalculate pid probabilities
+  fESDpid->MakeTPCPID(track);
 }
 
 //_____________________________________________________
@@ -390,11 +467,17 @@ void AliTPCTenderSupply::SetSplines()
 Double_t AliTPCTenderSupply::GetGainCorrection()
 {
   //
-  // Calculate gain correction factor
+  // Calculate gain correction factor for the current event
+  //
+  return GetGainCorrection(fTender->GetEvent()->GetTimeStamp());
+}
+
+//_____________________________________________________
+Double_t AliTPCTenderSupply::GetGainCorrection(UInt_t time)
+{
+  //
+  // Calculate gain correction factor at time
   //
-  AliESDEvent *event=fTender->GetEvent();
-  UInt_t time=event->GetTimeStamp();
-  
   Double_t gain=1;
   
   
@@ -433,6 +516,90 @@ Double_t AliTPCTenderSupply::GetGainCorrection()
   return gain;
 }
 
+//_____________________________________________________
+void AliTPCTenderSupply::SetLookupTables()
+{
+  //
+  // Resample the gain, attachment and multiplicity corrections of the run
+  // into uniform tables. The time tables cover the run duration from the GRP;
+  // their step is refined until the deviation from the exact evaluation at
+  // the middle of the cells is below fTableTolerance, otherwise the exact
+  // evaluation is kept for the run
+  //
+  fGainTable.clear();
+  fAttachTable.clear();
+  fMultTable.clear();
+  fTableTimeStart=1;
+  fTableTimeEnd=0;
+  fTableTimeStep=0.;
+  if (!fUseTables) return;
+
+  // multiplicity correction
+  if (fMultiCorrection && fMultiCorrMean) {
+    const Double_t dx=kMultTableMax/(kMultTableSize-1);
+    fMultTable.resize(kMultTableSize);
+    for (Int_t i=0; i<kMultTableSize; ++i) fMultTable[i]=fMultiCorrMean->Eval(i*dx);
+    Double_t maxDev=0.;
+    for (Int_t i=0; i<kMultTableSize-1; ++i) {
+      const Double_t x=(i+0.5)*dx;
+      const Double_t exact=fMultiCorrMean->Eval(x);
+      if (exact!=0.) maxDev=TMath::Max(maxDev,TMath::Abs(InterpolateCubic(fMultTable,0.,dx,x)/exact-1.));
+    }
+    if (maxDev>fTableTolerance) {
+      AliWarning(Form("Multiplicity correction table deviates by %g, using the exact evaluation",maxDev));
+      fMultTable.clear();
+    }
+  }
+
+  // gain and attachment correction vs time
+  if (!fGRP) return;
+  const UInt_t tStart=fGRP->GetTimeStart();
+  const UInt_t tEnd=fGRP->GetTimeEnd();
+  if (tEnd<=tStart || tEnd-tStart>2*86400) {
+    AliWarning(Form("Invalid run duration (%u - %u), using the exact gain evaluation",tStart,tEnd));
+    return;
+  }
+  const Bool_t tabAttach=fAttachmentCorrection && fGainAttachment;
+  std::vector<Double_t> &gain=fGainTable;
+  std::vector<Double_t> &attach=fAttachTable;
+  // the time stamps are whole seconds, so are the steps; the finest step is
+  // 2 s so that the middle of every cell is still a time stamp to check
+  const UInt_t steps[]={60,30,16,8,4,2};
+  for (UInt_t istep=0; istep<sizeof(steps)/sizeof(steps[0]); ++istep) {
+    const UInt_t step=steps[istep];
+    const Int_t n=TMath::Max(2,Int_t((tEnd-tStart+step-1)/step)+1);
+    gain.resize(n);
+    attach.resize(tabAttach ? n : 0);
+    for (Int_t i=0; i<n; ++i) {
+      const UInt_t t=tStart+i*step;
+      gain[i]=GetGainCorrection(t);
+      if (tabAttach) attach[i]=fGainAttachment->Eval(t);
+    }
+    // check in the middle of the cells
+    Double_t maxDev=0.;
+    for (Int_t i=0; i<n-1; ++i) {
+      const UInt_t t=tStart+i*step+step/2;
+      const Double_t exact=GetGainCorrection(t);
+      if (exact!=0.) maxDev=TMath::Max(maxDev,TMath::Abs(InterpolateLinear(gain,0.,step,t-tStart)/exact-1.));
+      if (tabAttach) {
+        // the slope enters as 1+slope*drift, compare on the scale of the full drift length
+        const Double_t exactSlope=fGainAttachment->Eval(t);
+        maxDev=TMath::Max(maxDev,TMath::Abs(InterpolateLinear(attach,0.,step,t-tStart)-exactSlope)*250.);
+      }
+    }
+    if (maxDev<=fTableTolerance) {
+      fTableTimeStart=tStart;
+      fTableTimeEnd=tEnd;
+      fTableTimeStep=step;
+      if (fDebugLevel>0) AliInfo(Form("Gain tables: %d nodes, step %u s, max deviation %g",n,step,maxDev));
+      return;
+    }
+  }
+  AliWarning("Gain tables do not reach the requested tolerance, using the exact evaluation");
+  fGainTable.clear();
+  fAttachTable.clear();
+}
+
 //_____________________________________________________
 void AliTPCTenderSupply::SetBeamType()
 {
@@ -11,6 +11,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <TString.h>
+#include <vector>
 
 #include <AliTenderSupply.h>
 
@@ -35,6 +36,8 @@ public:
   void SetDebugLevel(Int_t level)         {fDebugLevel=level;}
   void SetMip(Double_t mip)               {fMip=mip;}
   void SetResponseFunctions(TObjArray *arr) {fArrPidResponseMaster=arr;}
+  void SetUseLookupTables(Bool_t use=kTRUE) {fUseTables=use;}
+  void SetTableTolerance(Double_t tol)      {fTableTolerance=tol;}
   Double_t GetMultiplicityCorrectionMean(Double_t tpcMulti);
   Double_t GetMultiplicityCorrectionSigma(Double_t tpcMulti);
 
@@ -42,6 +45,13 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+  // Fused track loop
+  virtual Bool_t            HasTrackKernel() const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+  // Event products
+  virtual UInt_t            GetReadProducts() const {return kTrackParams|kTPCsignal|kVertex|kPID;}
+  virtual UInt_t            GetWriteProducts() const {return kTPCsignal|kTrackStatus|kPID;}
   
 private:
   AliESDpid          *fESDpid;         //! ESD pid object
@@ -61,6 +71,8 @@ private:
   
   Int_t fDebugLevel;                 //debug level
   Double_t fMip;                     //mip position
+  Bool_t   fUseTables;               //use per-run lookup tables of the gain, attachment and multiplicity corrections
+  Double_t fTableTolerance;          //max relative deviation of the tables from the exact evaluation
   
   AliGRPObject *fGRP;                //!GRP for pressure temperature correction
 
@@ -69,8 +81,21 @@ private:
   TString fMCperiod;                 //! corresponding MC period to use for the splines
   Int_t   fRecoPass;                 //! reconstruction pass
 
+  Double_t fCorrFactor;              //! gain correction factor of the current event
+  Double_t fCorrAttachSlope;         //! attachment correction slope of the current event
+  Double_t fCorrGainMultiplicityPbPb;//! multiplicity correction of the current event
+
+  std::vector<Double_t> fGainTable;  //! gain correction vs time for the current run
+  std::vector<Double_t> fAttachTable;//! attachment slope vs time for the current run
+  std::vector<Double_t> fMultTable;  //! multiplicity correction vs TPC multiplicity bin
+  UInt_t   fTableTimeStart;          //! time of the first node of the time tables
+  UInt_t   fTableTimeEnd;            //! end of the time range of the time tables
+  Double_t fTableTimeStep;           //! time step of the time tables [s]
+
   void SetSplines();
   Double_t GetGainCorrection();
+  Double_t GetGainCorrection(UInt_t time);
+  void SetLookupTables();
 
   Double_t GetTPCMultiplicityBin();
 
@@ -82,7 +107,7 @@ private:
   AliTPCTenderSupply(const AliTPCTenderSupply&c);
   AliTPCTenderSupply& operator= (const AliTPCTenderSupply&c);
   
-  ClassDef(AliTPCTenderSupply, 2);  // TPC tender task
+  ClassDef(AliTPCTenderSupply, 3);  // TPC tender task
 };
 
 
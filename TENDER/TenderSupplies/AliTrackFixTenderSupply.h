@@ -32,6 +32,13 @@ public:
   virtual ~AliTrackFixTenderSupply();
   virtual  void ProcessEvent();
   virtual  void Init() {}
+  // Fused track loop
+  virtual  Bool_t HasTrackKernel() const {return kTRUE;}
+  virtual  Bool_t BeginEvent();
+  virtual  void   ProcessTrack(AliESDtrack* trc);
+  // Event products
+  virtual  UInt_t GetReadProducts() const {return kTrackParams|kTrackStatus|kVertex;}
+  virtual  UInt_t GetWriteProducts() const {return kTrackParams;}
   //
   Double_t GetSideAFraction(const AliESDtrack* track) const;
   void     CorrectTrackPtInv(AliExternalTrackParam* trc, int mode, double sideAfraction, double phi) const;
@@ -57,6 +64,8 @@ private:
   TString           fOADBObjPath;            // path of file with parameters to use, starting from OADB dir
   TString           fOADBObjName;            // name of the corrections object in the OADB container
   AliOADBContainer* fOADBCont;               // OADB container with parameters collection
+  const AliESDVertex* fVtx;                  //! vertex for RelateToVertex in the current event
+  const AliESDVertex* fVtxTPC;               //! vertex for RelateToVertexTPC in the current event
   //
   ClassDef(AliTrackFixTenderSupply, 1);  // track fixing tender task 
 };
@@ -29,6 +29,9 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+  // Event products
+  virtual UInt_t            GetReadProducts() const {return kVZERO;}
+  virtual UInt_t            GetWriteProducts() const {return kVZERO;}
   
   void GetPhaseCorrection();
 
@@ -24,6 +24,9 @@ public:
   
   virtual void              Init(){;}
   virtual void              ProcessEvent();
+  // Event products
+  virtual UInt_t            GetReadProducts() const {return kTrackParams|kTrackStatus|kVertex;}
+  virtual UInt_t            GetWriteProducts() const {return kVertex;}
   //
   Int_t   GetRefitAlgo()              const {return fRefitAlgo;}
   void    SetRefitAlgo(Int_t alg=-1)        {fRefitAlgo = alg;}